@@ -0,0 +1,77 @@
+/**
+ * @file AllocationTracker.cpp
+ * @brief Implementation of heap allocation tracking for Flappy Bird 2-player game
+ *
+ * With FLAPPY_TRACK_ALLOCATIONS defined this file replaces the global
+ * operator new and delete; the array and nothrow forms forward to them.
+ */
+
+#include "AllocationTracker.h"
+#include <cstdlib>
+#include <new>
+
+#ifdef FLAPPY_TRACK_ALLOCATIONS
+
+static thread_local std::uint64_t thread_allocations = 0;   ///< Allocations made by this thread
+static thread_local std::uint64_t thread_bytes = 0;         ///< Bytes requested by this thread
+
+void* operator new(std::size_t size)
+{
+    thread_allocations++;
+    thread_bytes += size;
+    if (void* memory = std::malloc(size ? size : 1))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+/**
+ * @brief Checks whether this build counts allocations
+ * @return True (this build counts)
+ */
+bool AllocationTracker::isEnabled()
+{
+    return true;
+}
+
+/**
+ * @brief Gets the calling thread's running totals
+ * @return Totals since the thread started
+ */
+AllocationTracker::Counts AllocationTracker::getCounts()
+{
+    Counts counts = { thread_allocations, thread_bytes };
+    return counts;
+}
+
+#else
+
+/**
+ * @brief Checks whether this build counts allocations
+ * @return False (built without FLAPPY_TRACK_ALLOCATIONS)
+ */
+bool AllocationTracker::isEnabled()
+{
+    return false;
+}
+
+/**
+ * @brief Gets the calling thread's running totals
+ * @return Zero totals (nothing is counted)
+ */
+AllocationTracker::Counts AllocationTracker::getCounts()
+{
+    Counts counts = { 0, 0 };
+    return counts;
+}
+
+#endif
@@ -0,0 +1,46 @@
+/**
+ * @file AllocationTracker.h
+ * @brief Header file for heap allocation tracking in Flappy Bird 2-player game
+ *
+ * This file defines AllocationTracker, which reports how many heap
+ * allocations (and how many bytes) the calling thread has made. Counting
+ * only happens in builds compiled with FLAPPY_TRACK_ALLOCATIONS, which
+ * replaces the global operator new; other builds report zero and pay
+ * nothing.
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @class AllocationTracker
+ * @brief Per-thread heap allocation counters
+ *
+ * Counters are per thread, so allocations made by other threads (audio,
+ * workers) do not show up in the frame being checked.
+ */
+class AllocationTracker
+{
+public:
+    /**
+     * @struct Counts
+     * @brief Running totals of one thread
+     */
+    struct Counts
+    {
+        std::uint64_t allocations;   ///< Calls to operator new
+        std::uint64_t bytes;         ///< Bytes requested
+    };
+
+    /**
+     * @brief Checks whether this build counts allocations
+     * @return True if compiled with FLAPPY_TRACK_ALLOCATIONS
+     */
+    static bool isEnabled();
+
+    /**
+     * @brief Gets the calling thread's running totals
+     * @return Totals since the thread started (zero when disabled)
+     */
+    static Counts getCounts();
+};
@@ -0,0 +1,79 @@
+/**
+ * @file AudioEngine.cpp
+ * @brief Implementation of the AudioEngine class for Flappy Bird 2-player game
+ */
+
+#include "AudioEngine.h"
+#include "ResourceCache.h"
+
+static const char* const effect_paths[AudioEngine::effect_count] =
+{
+    "assets/sfx/flap.wav", "assets/sfx/score.wav", "assets/sfx/dead.wav"
+};
+
+/**
+ * @brief Constructor - decodes every sound effect
+ */
+AudioEngine::AudioEngine() :
+plays(0),
+muted(false)
+{
+    for (int i = 0; i < effect_count; i++)
+        buffers[i] = Resources::sound(effect_paths[i]);
+}
+
+/**
+ * @brief Starts a sound effect, stealing a voice if needed
+ * @param effect Effect to play
+ *
+ * Prefers an idle voice. Otherwise the victim is the busy voice with the
+ * lowest priority, oldest first; if even that one outranks the new
+ * effect, the new effect is dropped.
+ */
+void AudioEngine::play(SoundEffect effect)
+{
+    if (muted)
+        return;
+
+    int priority = static_cast<int>(effect);
+    Voice* target = nullptr;
+    for (Voice& voice : voices)
+    {
+        if (voice.sound.getStatus() != SoundSource::Playing)
+        {
+            target = &voice;
+            break;
+        }
+        if (!target || voice.priority < target->priority ||
+            (voice.priority == target->priority && voice.started < target->started))
+            target = &voice;
+    }
+    if (target->sound.getStatus() == SoundSource::Playing && target->priority > priority)
+        return;
+
+    target->sound.stop();
+    target->sound.setBuffer(*buffers[priority]);
+    target->sound.play();
+    target->priority = priority;
+    target->started = plays++;
+}
+
+/**
+ * @brief Stops every voice
+ */
+void AudioEngine::stopAll()
+{
+    for (Voice& voice : voices)
+        voice.sound.stop();
+}
+
+/**
+ * @brief Turns all sound off or back on
+ * @param mute True to stop every voice and ignore play requests
+ */
+void AudioEngine::setMuted(bool mute)
+{
+    muted = mute;
+    if (muted)
+        stopAll();
+}
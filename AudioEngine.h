@@ -0,0 +1,87 @@
+/**
+ * @file AudioEngine.h
+ * @brief Header file for the AudioEngine class in Flappy Bird 2-player game
+ *
+ * This file defines the AudioEngine class which plays the game's sound
+ * effects from a fixed pool of voices. Every sample is decoded once at
+ * startup, so triggering a sound during play never touches the disk or
+ * the heap.
+ */
+
+#pragma once
+#include <SFML/Audio.hpp>
+#include <cstdint>
+#include <memory>
+
+using namespace sf;
+
+/**
+ * @enum SoundEffect
+ * @brief Sound effects, in increasing priority
+ */
+enum class SoundEffect
+{
+    Flap,       ///< A bird flapped (assets/sfx/flap.wav)
+    Score,      ///< A bird passed a pipe (assets/sfx/score.wav)
+    Death,      ///< A bird hit a pipe or the ground (assets/sfx/dead.wav)
+    Count       ///< Number of effects (not an effect)
+};
+
+/**
+ * @class AudioEngine
+ * @brief Plays sound effects on a fixed pool of preloaded voices
+ *
+ * When every voice is busy, a new sound takes over the voice playing the
+ * lowest-priority sound, the oldest one among equals, as long as that
+ * sound is not more important than the new one. So two players flapping
+ * at once cut off older flaps, but never a death sound.
+ */
+class AudioEngine
+{
+public:
+    static constexpr int effect_count = static_cast<int>(SoundEffect::Count);   ///< Number of effects
+    static constexpr int voice_count = 6;                                      ///< Sounds that can play at once
+
+private:
+    /**
+     * @struct Voice
+     * @brief One sound that can play at a time
+     */
+    struct Voice
+    {
+        Sound sound;             ///< SFML sound playing from one of the buffers
+        int priority = -1;       ///< Priority of the last effect played (-1 = never used)
+        std::uint64_t started = 0;   ///< Sequence number of the last play, for finding the oldest
+    };
+
+    std::shared_ptr<SoundBuffer> buffers[effect_count];   ///< Decoded samples by effect
+    Voice voices[voice_count];                            ///< Voice pool
+    std::uint64_t plays;                                  ///< Sounds started so far
+    bool muted;                                           ///< True to ignore play requests
+
+public:
+    /**
+     * @brief Constructor - decodes every sound effect
+     */
+    AudioEngine();
+
+    AudioEngine(const AudioEngine&) = delete;
+    AudioEngine& operator=(const AudioEngine&) = delete;
+
+    /**
+     * @brief Starts a sound effect, stealing a voice if needed
+     * @param effect Effect to play
+     */
+    void play(SoundEffect effect);
+
+    /**
+     * @brief Stops every voice
+     */
+    void stopAll();
+
+    /**
+     * @brief Turns all sound off or back on
+     * @param mute True to stop every voice and ignore play requests
+     */
+    void setMuted(bool mute);
+};
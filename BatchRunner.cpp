@@ -0,0 +1,364 @@
+/**
+ * @file BatchRunner.cpp
+ * @brief Command-line batch match runner for balance sweeps
+ *
+ * Plays large numbers of bot-driven matches with the headless Simulation
+ * across all CPU cores, for every combination of the given gameplay
+ * parameters, and reports score and survival distributions per set.
+ *
+ * Command line options (lists are comma separated):
+ *   --matches <n>         Matches per parameter set (default 10000)
+ *   --threads <n>         Worker threads (default: one per hardware thread)
+ *   --max-seconds <s>     Per-match time cap in simulated seconds (default 300)
+ *   --aim-error <px>      Bot aim jitter in pixels (default 20, rule bots only)
+ *   --bot <type>          Bot flying both birds: rule or lookahead (default rule)
+ *   --seed <n>            First pipe course seed (default 1)
+ *   --gravity <list>      Bird gravity values (pixels per second squared)
+ *   --flap <list>         Flap speed values (pixels per second)
+ *   --pipe-gap <list>     Pipe gap values (pixels)
+ *   --pipe-speed <list>   Pipe speed values (pixels per second)
+ *   --ground-speed <list> Ground speed values (pixels per second)
+ *
+ * Every parameter set flies the same pipe courses (seed, seed + 1, ...),
+ * so differences between sets come from the parameters, not the courses.
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "Bot.h"
+#include "LookaheadBot.h"
+#include "Simulation.h"
+#include "WorkStealingPool.h"
+
+/**
+ * @struct Stats
+ * @brief Score and survival histograms for one parameter set
+ */
+struct Stats
+{
+    std::vector<std::uint64_t> scores;      ///< Count of birds per final score
+    std::vector<std::uint64_t> survival;    ///< Count of birds per whole seconds survived
+    std::uint64_t birds = 0;                ///< Number of birds recorded
+    std::uint64_t timeouts = 0;             ///< Birds still flying at the time cap
+    double score_sum = 0;                   ///< Sum of scores (for the mean)
+    double survival_sum = 0;                ///< Sum of seconds survived (for the mean)
+
+    /**
+     * @brief Records one bird's result
+     * @param score Pipes passed
+     * @param seconds Simulated seconds survived
+     * @param timed_out True if the bird was still flying at the cap
+     */
+    void add(int score, float seconds, bool timed_out)
+    {
+        std::size_t bucket = static_cast<std::size_t>(seconds);
+        if (scores.size() <= static_cast<std::size_t>(score))
+            scores.resize(score + 1);
+        if (survival.size() <= bucket)
+            survival.resize(bucket + 1);
+        scores[score]++;
+        survival[bucket]++;
+        birds++;
+        timeouts += timed_out;
+        score_sum += score;
+        survival_sum += seconds;
+    }
+
+    /**
+     * @brief Adds another worker's results into this one
+     * @param other Results to merge
+     */
+    void merge(const Stats& other)
+    {
+        if (scores.size() < other.scores.size())
+            scores.resize(other.scores.size());
+        if (survival.size() < other.survival.size())
+            survival.resize(other.survival.size());
+        for (std::size_t i = 0; i < other.scores.size(); i++)
+            scores[i] += other.scores[i];
+        for (std::size_t i = 0; i < other.survival.size(); i++)
+            survival[i] += other.survival[i];
+        birds += other.birds;
+        timeouts += other.timeouts;
+        score_sum += other.score_sum;
+        survival_sum += other.survival_sum;
+    }
+};
+
+/**
+ * @brief Finds a percentile in a histogram
+ * @param histogram Counts per value
+ * @param total Sum of all counts
+ * @param q Quantile in [0, 1]
+ * @return Smallest value with at least q of the counts at or below it
+ */
+static std::size_t percentile(const std::vector<std::uint64_t>& histogram, std::uint64_t total, double q)
+{
+    std::uint64_t needed = static_cast<std::uint64_t>(q * total);
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < histogram.size(); i++)
+    {
+        seen += histogram[i];
+        if (seen > needed || (seen == total && seen > 0))
+            return i;
+    }
+    return 0;
+}
+
+static const long max_parameter = 100000;   ///< Largest gameplay parameter a list may hold
+
+/**
+ * @brief Parses a whole argument as an integer in a range
+ * @param text Argument
+ * @param min Smallest value accepted
+ * @param max Largest value accepted
+ * @param value Receives the value
+ * @return True if text is a number between min and max
+ */
+static bool parseInteger(const std::string& text, long min, long max, long& value)
+{
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtol(text.c_str(), &end, 10);
+    return end != text.c_str() && *end == '\0' && errno == 0 && value >= min && value <= max;
+}
+
+/**
+ * @brief Parses a whole argument as a finite number in a range
+ * @param text Argument
+ * @param min Smallest value accepted
+ * @param max Largest value accepted
+ * @param value Receives the value
+ * @return True if text is a number between min and max
+ */
+static bool parseNumber(const std::string& text, float min, float max, float& value)
+{
+    char* end = nullptr;
+    value = std::strtof(text.c_str(), &end);
+    return end != text.c_str() && *end == '\0' && std::isfinite(value) && value >= min && value <= max;
+}
+
+/**
+ * @brief Parses a comma-separated list of integers in a range
+ * @param text List to parse
+ * @param min Smallest value accepted
+ * @param values Receives the parsed values
+ * @return True if every item is a number between min and max_parameter
+ */
+static bool parseList(const std::string& text, long min, std::vector<int>& values)
+{
+    values.clear();
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        long value = 0;
+        if (!parseInteger(item, min, max_parameter, value))
+            return false;
+        values.push_back(static_cast<int>(value));
+    }
+    return !values.empty() && text.back() != ',';
+}
+
+/**
+ * @brief Plays one bot-vs-bot match and records both birds' results
+ * @param config Gameplay parameters
+ * @param seed Pipe course seed
+ * @param max_ticks Per-match time cap in ticks
+ * @param aim_error Bot aim jitter in pixels (rule bots only)
+ * @param lookahead True for lookahead bots, false for rule bots
+ * @param stats Results to add to
+ */
+static void playMatch(const SimConfig& config, std::uint64_t seed, std::uint64_t max_ticks,
+                      float aim_error, bool lookahead, Stats& stats)
+{
+    Simulation sim(seed, config);
+    Bot bots[2] = { Bot(0, seed * 2 + 1, aim_error), Bot(1, seed * 2 + 2, aim_error) };
+    LookaheadBot lookahead_bots[2] = { LookaheadBot(0, seed * 2 + 1), LookaheadBot(1, seed * 2 + 2) };
+    std::uint64_t out_tick[2] = { max_ticks, max_ticks };
+
+    while (!sim.isOver() && sim.getTick() < max_ticks)
+    {
+        SimInput input;
+        for (int player = 0; player < 2; player++)
+        {
+            if (lookahead)
+                lookahead_bots[player].play(sim, input);
+            else
+                bots[player].play(sim, input);
+        }
+        sim.step(input);
+
+        for (int player = 0; player < 2; player++)
+        {
+            if (!sim.getBird(player).active && out_tick[player] == max_ticks)
+                out_tick[player] = sim.getTick();
+        }
+    }
+
+    for (int player = 0; player < 2; player++)
+    {
+        stats.add(sim.getScore(player),
+                  static_cast<float>(out_tick[player]) / Simulation::tick_rate,
+                  out_tick[player] == max_ticks);
+    }
+}
+
+/**
+ * @brief Main function - batch runner entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
+ * @return 0 on success, 1 on bad arguments
+ */
+int main(int argc, char* argv[])
+{
+    std::uint64_t matches = 10000;
+    unsigned threads = 0;
+    float max_seconds = 300.f;
+    float aim_error = 20.f;
+    std::uint64_t base_seed = 1;
+    bool lookahead = false;
+
+    SimConfig defaults;
+    std::vector<int> gravity = { defaults.gravity };
+    std::vector<int> flap = { defaults.birdflapspeed };
+    std::vector<int> pipe_gap = { defaults.pipe_distance };
+    std::vector<int> pipe_speed = { defaults.pipe_move_speed };
+    std::vector<int> ground_speed = { defaults.ground_move_speed };
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        long number = 0;
+        bool valid = true;
+        const char* expected = "";   // What the option takes, for the error message
+        if (arg == "--matches")
+        {
+            valid = parseInteger(value, 1, 1000000000, number);
+            matches = static_cast<std::uint64_t>(number);
+            expected = "a count between 1 and 1000000000";
+        }
+        else if (arg == "--threads")
+        {
+            valid = parseInteger(value, 0, 256, number);
+            threads = static_cast<unsigned>(number);
+            expected = "a count between 0 and 256";
+        }
+        else if (arg == "--max-seconds")
+        {
+            valid = parseNumber(value, 1.f / Simulation::tick_rate, 86400.f, max_seconds);
+            expected = "a number of seconds above 0, at most 86400";
+        }
+        else if (arg == "--aim-error")
+        {
+            valid = parseNumber(value, 0.f, 1000.f, aim_error);
+            expected = "a number of pixels between 0 and 1000";
+        }
+        else if (arg == "--bot")
+        {
+            valid = value == "rule" || value == "lookahead";
+            lookahead = value == "lookahead";
+            expected = "rule or lookahead";
+        }
+        else if (arg == "--seed")
+        {
+            char* end = nullptr;
+            errno = 0;
+            base_seed = std::strtoull(value.c_str(), &end, 10);
+            valid = value[0] != '-' && end != value.c_str() && *end == '\0' && errno == 0;
+            expected = "a whole number, 0 or more";
+        }
+        else if (arg == "--gravity" || arg == "--flap" || arg == "--pipe-speed" || arg == "--ground-speed")
+        {
+            std::vector<int>& list = arg == "--gravity" ? gravity : arg == "--flap" ? flap
+                                   : arg == "--pipe-speed" ? pipe_speed : ground_speed;
+            valid = parseList(value, 0, list);
+            expected = "a comma-separated list of whole numbers between 0 and 100000";
+        }
+        else if (arg == "--pipe-gap")
+        {
+            valid = parseList(value, 1, pipe_gap);
+            expected = "a comma-separated list of whole numbers between 1 and 100000";
+        }
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+
+        if (!valid)
+        {
+            std::cerr << arg << " takes " << expected << std::endl;
+            return 1;
+        }
+    }
+
+    // Every combination of the given values is one parameter set
+    std::vector<SimConfig> sets;
+    for (int g : gravity)
+        for (int f : flap)
+            for (int d : pipe_gap)
+                for (int p : pipe_speed)
+                    for (int s : ground_speed)
+                        sets.push_back(SimConfig{ g, f, d, p, s });
+
+    WorkStealingPool pool(threads);
+    std::uint64_t max_ticks = static_cast<std::uint64_t>(max_seconds * Simulation::tick_rate);
+    std::vector<std::vector<Stats>> results(pool.getThreadCount(), std::vector<Stats>(sets.size()));
+
+    auto started = std::chrono::steady_clock::now();
+    pool.parallelFor(sets.size() * matches, 64,
+        [&](std::size_t begin, std::size_t end, unsigned worker)
+        {
+            for (std::size_t i = begin; i < end; i++)
+            {
+                std::size_t set = i / matches;
+                playMatch(sets[set], base_seed + i % matches, max_ticks, aim_error, lookahead, results[worker][set]);
+            }
+        });
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::cout << sets.size() * matches << " matches on " << pool.getThreadCount() << " threads in "
+              << std::fixed << std::setprecision(2) << elapsed << " s ("
+              << std::setprecision(0) << sets.size() * matches / elapsed << " matches/s)\n\n";
+
+    std::cout << "gravity  flap  gap  pipe  ground | score mean  p10  p50  p90  p99   max"
+              << " | alive s mean  p50  p90  capped\n";
+    for (std::size_t set = 0; set < sets.size(); set++)
+    {
+        Stats total;
+        for (const std::vector<Stats>& worker : results)
+            total.merge(worker[set]);
+
+        const SimConfig& c = sets[set];
+        std::cout << std::setw(7) << c.gravity << std::setw(6) << c.birdflapspeed
+                  << std::setw(5) << c.pipe_distance << std::setw(6) << c.pipe_move_speed
+                  << std::setw(8) << c.ground_move_speed << " |"
+                  << std::setw(11) << std::setprecision(2) << total.score_sum / total.birds
+                  << std::setw(5) << percentile(total.scores, total.birds, 0.10)
+                  << std::setw(5) << percentile(total.scores, total.birds, 0.50)
+                  << std::setw(5) << percentile(total.scores, total.birds, 0.90)
+                  << std::setw(5) << percentile(total.scores, total.birds, 0.99)
+                  << std::setw(6) << (total.scores.empty() ? 0 : total.scores.size() - 1) << " |"
+                  << std::setw(13) << std::setprecision(1) << total.survival_sum / total.birds
+                  << std::setw(5) << percentile(total.survival, total.birds, 0.50)
+                  << std::setw(5) << percentile(total.survival, total.birds, 0.90)
+                  << std::setw(8) << total.timeouts << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,759 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Micro- and macro-benchmarks of the game tick
+ *
+ * Measures the per-tick cost of the pieces of a simulation tick on
+ * synthetic pipe and bird counts, and of whole ticks replayed from a
+ * recorded match. Every result reports nanoseconds and heap allocations
+ * per tick, can be written as JSON and compared against a stored baseline.
+ *
+ * Command line options:
+ *   --json <file>       Write results as JSON
+ *   --baseline <file>   Compare against a JSON file written by --json
+ *   --tolerance <pct>   Slowdown that counts as a regression (default 10)
+ *   --min-time <s>      Minimum time per measurement (default 0.2)
+ *   --filter <text>     Only run benchmarks whose name contains <text>
+ *   --replay <file>     Replay scenario to use (default: a recorded bot match)
+ *
+ * Exits with 2 if any benchmark regressed against the baseline.
+ *
+ * Allocation counts need a build with -DFLAPPY_TRACK_ALLOCATIONS (see
+ * AllocationTracker.h); without it they read zero.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "AllocationTracker.h"
+#include "Bot.h"
+#include "BrainPool.h"
+#include "CollisionWorld.h"
+#include "Globals.h"
+#include "LookaheadBot.h"
+#include "PipeStream.h"
+#include "PixelMask.h"
+#include "Profiler.h"
+#include "Replay.h"
+#include "Simulation.h"
+#include "VectorEnv.h"
+
+/**
+ * @struct Result
+ * @brief Cost of one benchmark
+ */
+struct Result
+{
+    std::string name;           ///< Benchmark name (group/case/count)
+    double ns_per_tick;         ///< Best observed nanoseconds per tick
+    double allocs_per_tick;     ///< Heap allocations per tick
+};
+
+/**
+ * @struct Scenario
+ * @brief Recorded match replayed by the end-to-end benchmarks
+ */
+struct Scenario
+{
+    std::uint64_t seed = 0;             ///< Pipe course seed
+    std::vector<SimInput> inputs;       ///< Input of every tick
+};
+
+static volatile std::int64_t sink;   ///< Keeps results of otherwise unused work alive
+
+/**
+ * @brief Times a tick loop
+ * @param name Benchmark name
+ * @param min_time Minimum seconds per measurement
+ * @param body Callable running the given number of ticks
+ * @return Best of five measurements, in ns and allocations per tick
+ *
+ * The tick count is doubled until one run takes min_time, then five runs
+ * of that length are timed and the fastest is kept (the others are
+ * noise: interrupts, frequency changes, other processes).
+ */
+template <typename Body>
+static Result measure(const std::string& name, double min_time, Body body)
+{
+    typedef std::chrono::steady_clock clock;
+
+    std::uint64_t ticks = 64;
+    for (;;)
+    {
+        clock::time_point start = clock::now();
+        body(ticks);
+        if (std::chrono::duration<double>(clock::now() - start).count() >= min_time || ticks >= (1ull << 40))
+            break;
+        ticks *= 2;
+    }
+
+    Result result = { name, 1e300, 0 };
+    for (int run = 0; run < 5; run++)
+    {
+        std::uint64_t allocs_before = AllocationTracker::getCounts().allocations;
+        clock::time_point start = clock::now();
+        body(ticks);
+        double ns = std::chrono::duration<double, std::nano>(clock::now() - start).count();
+        std::uint64_t allocs = AllocationTracker::getCounts().allocations - allocs_before;
+
+        result.ns_per_tick = std::min(result.ns_per_tick, ns / ticks);
+        result.allocs_per_tick = static_cast<double>(allocs) / ticks;
+    }
+    return result;
+}
+
+/**
+ * @brief Records a bot-vs-bot match as a scenario
+ * @return Inputs of a deterministic match (seed 1, capped at five minutes)
+ */
+static Scenario recordBotMatch()
+{
+    Scenario scenario;
+    scenario.seed = 1;
+
+    Simulation sim(scenario.seed);
+    Bot bots[2] = { Bot(0, 3, 20.f), Bot(1, 4, 20.f) };
+    while (!sim.isOver() && sim.getTick() < 300u * Simulation::tick_rate)
+    {
+        SimInput input;
+        bots[0].play(sim, input);
+        bots[1].play(sim, input);
+        scenario.inputs.push_back(input);
+        sim.step(input);
+    }
+    return scenario;
+}
+
+/**
+ * @brief Loads a replay file as a scenario
+ * @param path Replay file
+ * @param scenario Scenario to fill
+ * @return True if the replay could be read
+ */
+static bool loadScenario(const std::string& path, Scenario& scenario)
+{
+    ReplayReader replay;
+    if (!replay.open(path))
+        return false;
+
+    scenario.seed = replay.getSeed();
+    for (std::uint64_t tick = 0; !replay.isFinished(tick); tick++)
+        scenario.inputs.push_back(replay.read(tick));
+    return true;
+}
+
+/**
+ * @brief Fills a pipe pool with evenly spaced pipes
+ * @param pipes Pool to fill
+ * @param count Number of pipes
+ * @param stream Height source
+ * @param index Next pipe index, advanced per pipe
+ */
+static void fillPipes(PipePool& pipes, int count, const PipeStream& stream, std::uint64_t& index)
+{
+    pipes.clear();
+    float spacing = (window_width + pipe_width) / count;
+    for (int i = 0; i < count; i++)
+    {
+        float x = -pipe_width + spacing * (i + 1);
+        pipes.emplace_back(x, x, static_cast<float>(stream.getHeight(index++)), 170.f);
+    }
+}
+
+/**
+ * @brief Fills a bird pool with flying birds spread over the screen
+ * @param birds Pool to fill
+ * @param count Number of birds
+ */
+static void fillBirds(BirdPool& birds, std::size_t count)
+{
+    birds.resize(count);
+    for (std::size_t i = 0; i < count; i++)
+        birds.place(i, 100.f, 100.f + (i * 37) % 400);
+    birds.setFlying(true);
+}
+
+/**
+ * @brief Prints one result as a table row
+ * @param result Result to print
+ */
+static void print(const Result& result)
+{
+    std::cout << std::left << std::setw(28) << result.name << std::right
+              << std::fixed << std::setprecision(2) << std::setw(12) << result.ns_per_tick << " ns/tick"
+              << std::setprecision(3) << std::setw(10) << result.allocs_per_tick << " allocs/tick" << std::endl;
+}
+
+/**
+ * @brief Runs every benchmark whose name matches the filter
+ * @param scenario Recorded match for the end-to-end benchmarks
+ * @param min_time Minimum seconds per measurement
+ * @param filter Substring names must contain (empty = all)
+ * @return Results in run order
+ */
+static std::vector<Result> runAll(const Scenario& scenario, double min_time, const std::string& filter)
+{
+    std::vector<Result> results;
+    auto run = [&](const std::string& name, auto body)
+    {
+        if (name.find(filter) == std::string::npos)
+            return;
+        results.push_back(measure(name, min_time, body));
+        print(results.back());
+    };
+
+    // Pipe update and erase loop of Simulation::doProcessing; popped pipes
+    // are respawned so the count stays fixed
+    PipeStream stream(1);
+    std::uint64_t index = 0;
+    PipePool pipes;
+    for (int count : { 1, 4, 16 })
+    {
+        fillPipes(pipes, count, stream, index);
+        run("pipes/update/" + std::to_string(count), [&](std::uint64_t ticks)
+        {
+            for (std::uint64_t t = 0; t < ticks; t++)
+            {
+                for (PipeState& pipe : pipes)
+                    pipe.x -= 400 * Simulation::tick_dt;
+                while (!pipes.empty() && pipes.front().x + pipe_width < 0)
+                {
+                    pipes.pop_front();
+                    pipes.emplace_back(static_cast<float>(window_width), static_cast<float>(window_width),
+                                       static_cast<float>(stream.getHeight(index++)), 170.f);
+                }
+            }
+            sink = static_cast<std::int64_t>(index);
+        });
+    }
+
+    // Bird passes used by Simulation (counts past 2 are what a crowd of
+    // bots or training agents would need)
+    BirdPool birds;
+    std::vector<std::uint8_t> flaps;
+    std::vector<std::int32_t> hits;
+    std::vector<float> impacts;
+    for (std::size_t count : { 2, 64, 1024, 16384 })
+    {
+        std::string suffix = "/" + std::to_string(count);
+        fillBirds(birds, count);
+        flaps.assign(count, 0);
+        for (std::size_t i = 0; i < count; i += 3)
+            flaps[i] = 1;
+        hits.assign(count, 0);
+        impacts.assign(count, 0.f);
+
+        run("birds/integrate" + suffix, [&](std::uint64_t ticks)
+        {
+            for (std::uint64_t t = 0; t < ticks; t++)
+            {
+                birds.savePositions();
+                birds.integrate(840.f, Simulation::tick_dt, Simulation::floor_y);
+            }
+            sink = static_cast<std::int64_t>(birds.y[0]);
+        });
+
+        run("birds/flap" + suffix, [&](std::uint64_t ticks)
+        {
+            for (std::uint64_t t = 0; t < ticks; t++)
+                birds.flap(flaps.data(), 300.f);
+            sink = static_cast<std::int64_t>(birds.velocity[0]);
+        });
+
+        // The swept test CollisionWorld runs for each pipe segment near the
+        // birds, on both segments of one moving pipe, plus the ground
+        run("birds/sweep" + suffix, [&](std::uint64_t ticks)
+        {
+            std::int64_t total = 0;
+            float dx = -400 * Simulation::tick_dt;
+            for (std::uint64_t t = 0; t < ticks; t++)
+            {
+                std::fill(hits.begin(), hits.end(), 0);
+                float x = static_cast<float>(t % 600);
+                birds.sweep(x, 400.f - 170.f - pipe_height, pipe_width, pipe_height, dx, hits.data(), impacts.data());
+                birds.sweep(x, 400.f, pipe_width, pipe_height, dx, hits.data(), impacts.data());
+                birds.hitGround(Simulation::ground_line, hits.data());
+                total += hits.back();
+            }
+            sink = total;
+        });
+    }
+
+    // The collision subsystem of Simulation::checkCollisions: boxes for
+    // every moving pipe segment, the broadphase and the swept per-bird tests
+    CollisionWorld colliders(2 * PipePool::capacity());
+    for (int pipe_count : { 4, 16 })
+    {
+        fillPipes(pipes, pipe_count, stream, index);
+        for (std::size_t count : { 2, 1024 })
+        {
+            fillBirds(birds, count);
+            hits.assign(count, 0);
+            run("collision/world/" + std::to_string(pipe_count) + "/" + std::to_string(count), [&](std::uint64_t ticks)
+            {
+                std::int64_t total = 0;
+                for (std::uint64_t t = 0; t < ticks; t++)
+                {
+                    float shift = static_cast<float>(t % 64);
+                    colliders.clear();
+                    for (const PipeState& pipe : pipes)
+                    {
+                        float dx = -400 * Simulation::tick_dt;
+                        colliders.add({ pipe.x - shift, pipe.y_pos - pipe.gap - pipe_height, pipe_width, pipe_height }, nullptr, dx);
+                        colliders.add({ pipe.x - shift, pipe.y_pos, pipe_width, pipe_height }, nullptr, dx);
+                    }
+                    colliders.build();
+                    std::fill(hits.begin(), hits.end(), 0);
+                    colliders.collide(birds, hits.data());
+                    total += hits.back();
+                }
+                sink = total;
+            });
+        }
+    }
+
+    // Pixel-exact test of one bird against one pipe segment, on stand-ins
+    // for the art: an elliptical bird and a pipe with a wider cap
+    std::vector<std::uint8_t> bird_pixels(34 * 24 * 4, 0), pipe_pixels(52 * 320 * 4, 0);
+    for (int y = 0; y < 24; y++)
+        for (int x = 0; x < 34; x++)
+            bird_pixels[(y * 34 + x) * 4 + 3] = std::hypot((x - 16.5f) / 17.f, (y - 11.5f) / 12.f) <= 1.f ? 255 : 0;
+    for (int y = 0; y < 320; y++)
+        for (int x = 0; x < 52; x++)
+            pipe_pixels[(y * 52 + x) * 4 + 3] = (y < 24 || (x >= 2 && x < 50)) ? 255 : 0;
+    PixelMask bird_mask, pipe_mask;
+    bird_mask.build(bird_pixels.data(), 34, 34, 24, static_cast<int>(bird_width), static_cast<int>(bird_height));
+    pipe_mask.build(pipe_pixels.data(), 52, 52, 320, static_cast<int>(pipe_width), static_cast<int>(pipe_height));
+    run("collision/mask/pair", [&](std::uint64_t ticks)
+    {
+        std::int64_t total = 0;
+        for (std::uint64_t t = 0; t < ticks; t++)
+        {
+            int offset = static_cast<int>(t % 64);
+            total += PixelMask::overlaps(bird_mask, 100, 100, pipe_mask, 100 + offset - 40, 136 - offset);
+        }
+        sink = total;
+    });
+
+    // Lookahead bot: one step of a rollout, and one whole decision (a
+    // rollout per choice and plan, horizon 256), from a match in progress
+    Simulation lookahead_sim(scenario.seed);
+    for (std::size_t t = 0; t < scenario.inputs.size() && t < 600; t++)
+        lookahead_sim.step(scenario.inputs[t]);
+    RolloutModel model(lookahead_sim, 0);
+    RolloutState root;
+    model.capture(lookahead_sim, 0, root);
+    run("bot/rollout/step", [&](std::uint64_t ticks)
+    {
+        RolloutState future = root;
+        for (std::uint64_t t = 0; t < ticks; t++)
+        {
+            if (!future.alive || t % 256 == 0)
+                future = root;
+            model.step(future, future.velocity > 0.f && (t & 15) == 0);
+        }
+        sink = static_cast<std::int64_t>(future.y);
+    });
+
+    LookaheadBot lookahead(0, 1);
+    run("bot/lookahead/decide", [&](std::uint64_t ticks)
+    {
+        std::int64_t flaps = 0;
+        for (std::uint64_t t = 0; t < ticks; t++)
+            flaps += lookahead.shouldFlap(lookahead_sim);
+        sink = flaps;
+    });
+
+    // Reinforcement-learning environment: one "tick" is one agent step,
+    // so the result reads as nanoseconds per agent per step
+    for (std::size_t count : {64, 1024})
+    {
+        VectorEnv env(count, 1);
+        std::vector<float> observations(env.getAgentCount() * VectorEnv::obs_size);
+        std::vector<float> rewards(env.getAgentCount());
+        std::vector<std::uint8_t> dones(env.getAgentCount());
+        std::vector<std::uint8_t> actions(env.getAgentCount());
+        env.setBuffers(observations.data(), rewards.data(), dones.data());
+        env.reset();
+        run("env/step_batch/" + std::to_string(count), [&](std::uint64_t ticks)
+        {
+            for (std::uint64_t t = 0; t < ticks; t += env.getAgentCount())
+            {
+                for (std::size_t agent = 0; agent < actions.size(); agent++)
+                {
+                    const float* obs = &observations[agent * VectorEnv::obs_size];
+                    actions[agent] = obs[1] > 0.f && obs[0] > (obs[3] + obs[4]) / 2.f;
+                }
+                env.stepBatch(actions.data());
+            }
+            sink = dones[0];
+        });
+    }
+
+    // Neuroevolution: one "tick" is one network evaluated, out of a
+    // population of 4096 with random weights and inputs
+    {
+        const std::size_t count = 4096;
+        BrainPool brains(count);
+        brains.resize(count);
+        std::uint64_t random = 1;
+        auto next = [&random]()
+        {
+            random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+            return static_cast<float>(random >> 40) / (1 << 23) - 1.f;   // In [-1, 1)
+        };
+        std::vector<float> genome(BrainPool::params);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (float& weight : genome)
+                weight = next();
+            brains.load(i, genome.data());
+        }
+        std::vector<float> values[BrainPool::inputs];
+        const float* inputs[BrainPool::inputs];
+        for (int k = 0; k < BrainPool::inputs; k++)
+        {
+            values[k].resize(count);
+            for (float& value : values[k])
+                value = next();
+            inputs[k] = values[k].data();
+        }
+        std::vector<std::uint8_t> flaps(count);
+        run("evolve/forward/4096", [&](std::uint64_t ticks)
+        {
+            std::int64_t total = 0;
+            for (std::uint64_t t = 0; t < ticks; t += count)
+            {
+                brains.forward(inputs, flaps.data());
+                total += flaps[t % count];
+            }
+            sink = total;
+        });
+    }
+
+    // Whole ticks, replaying the scenario from the start whenever it ends
+    Simulation sim(scenario.seed);
+    std::size_t next = scenario.inputs.size();
+    auto replay = [&](std::uint64_t ticks)
+    {
+        for (std::uint64_t t = 0; t < ticks; t++)
+        {
+            if (next == scenario.inputs.size())
+            {
+                sim.reset(scenario.seed);
+                next = 0;
+            }
+            sim.step(scenario.inputs[next++]);
+        }
+        sink = sim.getScore(0);
+    };
+    run("sim/replay", replay);
+
+    // State digest of a match in progress, as recorded every tick with --hashes
+    run("sim/hash", [&](std::uint64_t ticks)
+    {
+        StateHash hash;
+        std::uint64_t total = 0;
+        for (std::uint64_t t = 0; t < ticks; t++)
+        {
+            lookahead_sim.hashState(hash);
+            total += hash.getDigest().combined;
+        }
+        sink = static_cast<std::int64_t>(total);
+    });
+
+    // Rollback netcode: saving plus restoring a match in progress, and one
+    // whole 8-tick correction (restore, then save, hash and step each tick)
+    // as RollbackSession does it; one "tick" here is one rollback
+    SimState saved;
+    lookahead_sim.saveState(saved);
+    Simulation restored(scenario.seed);
+    run("net/save_load", [&](std::uint64_t ticks)
+    {
+        for (std::uint64_t t = 0; t < ticks; t++)
+        {
+            lookahead_sim.saveState(saved);
+            restored.loadState(saved);
+        }
+        sink = static_cast<std::int64_t>(restored.getTick());
+    });
+
+    run("net/rollback/8", [&](std::uint64_t ticks)
+    {
+        SimState states[8];
+        StateHash hash;
+        std::uint64_t total = 0;
+        for (std::uint64_t t = 0; t < ticks; t++)
+        {
+            restored.loadState(saved);
+            for (int depth = 0; depth < 8; depth++)
+            {
+                restored.saveState(states[depth]);
+                restored.hashState(hash);
+                total += hash.combined();
+                std::size_t input = std::min<std::size_t>(restored.getTick(), scenario.inputs.size() - 1);
+                restored.step(scenario.inputs[input]);
+            }
+        }
+        sink = static_cast<std::int64_t>(total);
+    });
+
+    // Paused ticks: the fixed cost of step() with no gameplay running
+    Simulation idle(1);
+    run("sim/idle", [&](std::uint64_t ticks)
+    {
+        for (std::uint64_t t = 0; t < ticks; t++)
+            idle.step(SimInput());
+        sink = static_cast<std::int64_t>(idle.getTick());
+    });
+
+    // Collision and score checks inside real ticks, timed by the profiler's
+    // scoped timers (so they include one timer's overhead each)
+    for (ProfilePhase phase : { ProfilePhase::Collision, ProfilePhase::Score })
+    {
+        std::string name = std::string("sim/replay/") + Profiler::getName(phase);
+        if (name.find(filter) == std::string::npos)
+            continue;
+
+        std::uint64_t ticks = scenario.inputs.size();
+        Result best = { name, 1e300, 0 };
+        for (int run_index = 0; run_index < 5; run_index++)
+        {
+            Profiler profiler;
+            Profiler::setCurrent(&profiler);
+            std::uint64_t allocs_before = AllocationTracker::getCounts().allocations;
+            replay(ticks);
+            std::uint64_t allocs = AllocationTracker::getCounts().allocations - allocs_before;
+            Profiler::setCurrent(nullptr);
+
+            // The run is the profiler's only frame, so its max is the run's total
+            profiler.endFrame(std::chrono::nanoseconds(0));
+            best.ns_per_tick = std::min<double>(best.ns_per_tick, profiler.getStats(phase).max * 1e6 / ticks);
+            best.allocs_per_tick = static_cast<double>(allocs) / ticks;
+        }
+
+        results.push_back(best);
+        print(best);
+    }
+
+    return results;
+}
+
+/**
+ * @brief Writes results as JSON
+ * @param path File to write
+ * @param results Results to write
+ * @return True if the file could be written
+ */
+static bool writeJson(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        file << "    {\"name\": \"" << results[i].name << "\", "
+             << "\"ns_per_tick\": " << std::setprecision(6) << results[i].ns_per_tick << ", "
+             << "\"allocs_per_tick\": " << results[i].allocs_per_tick << "}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n}\n";
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Finds the value of a key inside part of a JSON text
+ * @param text JSON text
+ * @param begin First character to search
+ * @param end One past the last character to search
+ * @param key Key, without quotes
+ * @return Position of the value's first character, or std::string::npos
+ */
+static std::size_t findValue(const std::string& text, std::size_t begin, std::size_t end, const std::string& key)
+{
+    const std::string quoted = "\"" + key + "\"";
+    for (std::size_t at = text.find(quoted, begin); at < end; at = text.find(quoted, at + 1))
+    {
+        std::size_t colon = text.find_first_not_of(" \t\r\n", at + quoted.size());
+        if (colon < end && text[colon] == ':')
+        {
+            std::size_t value = text.find_first_not_of(" \t\r\n", colon + 1);
+            return value < end ? value : std::string::npos;
+        }
+    }
+    return std::string::npos;
+}
+
+/**
+ * @brief Reads results written by writeJson
+ * @param path File to read
+ * @param results Results to fill
+ * @return True if the file could be read and every entry parsed
+ *
+ * Accepts any whitespace and key order, so a baseline reformatted by
+ * another tool still reads. Each innermost object with a "name" is one
+ * benchmark; one missing a time or allocation count, or a file with no
+ * benchmark at all, fails rather than silently comparing against less.
+ */
+static bool readJson(const std::string& path, std::vector<Result>& results)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+    std::stringstream contents;
+    contents << file.rdbuf();
+    const std::string text = contents.str();
+
+    std::size_t searched = 0;
+    for (std::size_t close = text.find('}'); close != std::string::npos; close = text.find('}', close + 1))
+    {
+        // Innermost object: the nearest opening brace not already consumed
+        std::size_t open = text.rfind('{', close);
+        bool inner = open != std::string::npos && open >= searched;
+        searched = close + 1;
+        if (!inner)
+            continue;
+
+        std::size_t name = findValue(text, open, close, "name");
+        if (name == std::string::npos)
+            continue;
+        std::size_t ns = findValue(text, open, close, "ns_per_tick");
+        std::size_t allocs = findValue(text, open, close, "allocs_per_tick");
+        std::size_t name_end = text.find('"', name + 1);
+        if (text[name] != '"' || name_end >= close || ns == std::string::npos || allocs == std::string::npos)
+        {
+            std::cerr << path << ": malformed benchmark entry at offset " << open << std::endl;
+            return false;
+        }
+
+        Result result;
+        result.name = text.substr(name + 1, name_end - name - 1);
+        result.ns_per_tick = std::atof(text.c_str() + ns);
+        result.allocs_per_tick = std::atof(text.c_str() + allocs);
+        results.push_back(result);
+    }
+
+    if (results.empty())
+    {
+        std::cerr << path << ": no benchmark entries found" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Compares results against a baseline and prints the differences
+ * @param results Current results
+ * @param baseline Stored results
+ * @param tolerance Relative slowdown allowed (0.1 = 10%)
+ * @return Number of regressions (slower than tolerated, or more allocations)
+ */
+static int compare(const std::vector<Result>& results, const std::vector<Result>& baseline, double tolerance)
+{
+    int regressions = 0;
+    std::cout << "\n" << std::left << std::setw(28) << "benchmark" << std::right
+              << std::setw(12) << "baseline" << std::setw(12) << "current" << std::setw(9) << "change" << "\n";
+    for (const Result& current : results)
+    {
+        std::vector<Result>::const_iterator old = std::find_if(baseline.begin(), baseline.end(),
+            [&current](const Result& r) { return r.name == current.name; });
+        if (old == baseline.end())
+        {
+            std::cout << std::left << std::setw(28) << current.name << std::right << std::setw(12) << "-"
+                      << std::setw(12) << current.ns_per_tick << "      new\n";
+            continue;
+        }
+
+        double change = current.ns_per_tick / old->ns_per_tick - 1.0;
+        bool slower = change > tolerance;
+        bool allocates = current.allocs_per_tick > old->allocs_per_tick + 1e-9;
+        regressions += slower || allocates;
+
+        std::cout << std::left << std::setw(28) << current.name << std::right << std::fixed
+                  << std::setprecision(2) << std::setw(12) << old->ns_per_tick << std::setw(12) << current.ns_per_tick
+                  << std::setprecision(1) << std::setw(8) << change * 100 << "%"
+                  << (slower ? "  REGRESSION (time)" : "") << (allocates ? "  REGRESSION (allocations)" : "") << "\n";
+    }
+    return regressions;
+}
+
+/**
+ * @brief Main function - benchmark entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
+ * @return 0 on success, 1 on bad arguments or I/O errors, 2 on regressions
+ */
+int main(int argc, char* argv[])
+{
+    std::string json_path, baseline_path, filter, replay_path;
+    double tolerance = 0.10;
+    double min_time = 0.2;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--json") json_path = value;
+        else if (arg == "--baseline") baseline_path = value;
+        else if (arg == "--tolerance") tolerance = std::atof(value.c_str()) / 100.0;
+        else if (arg == "--min-time") min_time = std::atof(value.c_str());
+        else if (arg == "--filter") filter = value;
+        else if (arg == "--replay") replay_path = value;
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    Scenario scenario;
+    if (replay_path.empty())
+    {
+        scenario = recordBotMatch();
+    }
+    else if (!loadScenario(replay_path, scenario) || scenario.inputs.empty())
+    {
+        std::cerr << "Could not read replay file " << replay_path << std::endl;
+        return 1;
+    }
+    if (!AllocationTracker::isEnabled())
+        std::cout << "Built without FLAPPY_TRACK_ALLOCATIONS: allocation counts read zero\n";
+    std::cout << "Replay scenario: " << scenario.inputs.size() << " ticks\n\n";
+
+    std::vector<Result> results = runAll(scenario, min_time, filter);
+
+    if (!json_path.empty() && !writeJson(json_path, results))
+    {
+        std::cerr << "Could not write " << json_path << std::endl;
+        return 1;
+    }
+
+    if (!baseline_path.empty())
+    {
+        std::vector<Result> baseline;
+        if (!readJson(baseline_path, baseline))
+        {
+            std::cerr << "Could not read baseline " << baseline_path << std::endl;
+            return 1;
+        }
+        int regressions = compare(results, baseline, tolerance);
+        std::cout << "\n" << regressions << " regression(s)" << std::endl;
+        return regressions > 0 ? 2 : 0;
+    }
+    return 0;
+}
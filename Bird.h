@@ -2,82 +2,46 @@
  * @file Bird.h
  * @brief Header file for the Bird class in Flappy Bird 2-player game
  * 
- * This file defines the Bird class which handles the physics, animation,
- * and rendering for both player birds in the game. Each bird has its own
- * sprite, animation state, and collision boundaries.
+ * This file defines the Bird class which handles the animation and
+ * rendering of one player's bird. Bird physics live in the headless
+ * Simulation; this class only mirrors a bird's state on screen.
  */
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "Simulation.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
 
 using namespace sf;
 
 /**
  * @class Bird
- * @brief Represents a bird character in the Flappy Bird game
+ * @brief Renders one bird character in the Flappy Bird game
  * 
- * The Bird class manages bird physics (gravity, flapping), sprite animation
- * (alternating between up/down wing positions), and provides collision
- * detection boundaries. Supports two separate birds for 2-player gameplay.
+ * The Bird class registers a bird's wing images in the gameplay atlas and
+ * emits a quad for a BirdState produced by the Simulation. Game creates
+ * one Bird per player; any number of birds can share one batch.
  */
 class Bird
 {
 private:
-    Texture bird1[2];        ///< Textures for Player 1 bird (down and up wing positions)
-    Texture bird2[2];        ///< Textures for Player 2 bird (down and up wing positions)
-    const int gravity;       ///< Gravitational acceleration affecting bird fall speed
-    const int birdflapspeed; ///< Upward velocity applied when bird flaps
-    float velocity;          ///< Current vertical velocity of the bird
-    int animation;           ///< Animation frame counter for wing flapping
-    int animation_switch;    ///< Current animation frame (0 or 1 for wing position)
-    bool birdfly;           ///< Flag indicating whether bird physics are active
+    const TextureAtlas& atlas;   ///< Atlas holding the wing images
+    int frames[2];               ///< Atlas regions of the wing images (down and up positions)
 
 public:
-    Sprite bird1_sprite;    ///< Sprite for Player 1's bird
-    Sprite bird2_sprite;    ///< Sprite for Player 2's bird
-
-    /**
-     * @brief Constructor - initializes bird textures, sprites, and physics constants
-     */
-    Bird();
-
-    /**
-     * @brief Controls whether bird physics should be active
-     * @param should_fly True to enable physics, false to disable
-     */
-    void birdshouldfly(bool should_fly);
-
-    /**
-     * @brief Applies upward flapping force to the bird
-     * @param dt Delta time for frame-independent movement
-     */
-    void birdflap(Time& dt);
-
-    /**
-     * @brief Resets Player 1's bird to starting position
-     */
-    void bird1_resetPosition();
-
-    /**
-     * @brief Resets Player 2's bird to starting position  
-     */
-    void bird2_resetPosition();
-
-    /**
-     * @brief Updates Player 1's bird physics and animation
-     * @param dt Delta time for frame-independent movement
-     */
-    void update1(Time& dt);
-
     /**
-     * @brief Updates Player 2's bird physics and animation
-     * @param dt Delta time for frame-independent movement
+     * @brief Constructor - registers the player's wing images in the atlas
+     * @param atlas Gameplay atlas (must be built before drawing)
+     * @param player Player index (0 or 1)
      */
-    void update2(Time& dt);
+    Bird(TextureAtlas& atlas, int player);
 
     /**
-     * @brief Gets the right boundary of Player 1's bird for collision detection
-     * @return X-coordinate of the right edge of the bird's collision box
+     * @brief Adds the bird's quad to a batch
+     * @param batch Batch drawing from the gameplay atlas
+     * @param state Current state of the bird
+     * @param alpha Fraction of a tick elapsed since the last step, in [0, 1]
      */
-    float getRightBound();
-};
\ No newline at end of file
+    void draw(SpriteBatch& batch, const BirdState& state, float alpha) const;
+};
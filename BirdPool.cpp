@@ -0,0 +1,276 @@
+/**
+ * @file BirdPool.cpp
+ * @brief Implementation of the BirdPool class for Flappy Bird 2-player game
+ *
+ * This file contains the whole-array bird physics passes. Each loop body is
+ * branch-free (conditions become selects) and reads through restrict
+ * pointers, so compilers vectorize them (GCC and Clang at -O3).
+ */
+
+#include "BirdPool.h"
+#include "Globals.h"
+#include "Simulation.h"
+
+/**
+ * @brief Changes the number of birds (new birds start zeroed)
+ * @param count Number of birds
+ */
+void BirdPool::resize(std::size_t count)
+{
+    x.resize(count);
+    y.resize(count);
+    prev_y.resize(count);
+    checked_y.resize(count);
+    velocity.resize(count);
+    animation.resize(count);
+    animation_switch.resize(count);
+    frame.resize(count);
+    flying.resize(count);
+    active.resize(count);
+    collided.resize(count);
+}
+
+/**
+ * @brief Puts a bird back at a starting position, at rest and in the match
+ * @param i Bird index
+ * @param start_x Starting left edge
+ * @param start_y Starting top edge
+ *
+ * The animation phase is left alone, as it always was on restart.
+ */
+void BirdPool::place(std::size_t i, float start_x, float start_y)
+{
+    x[i] = start_x;
+    y[i] = start_y;
+    prev_y[i] = start_y;
+    checked_y[i] = start_y;
+    velocity[i] = 0.f;
+    flying[i] = 0;
+    active[i] = 1;
+    collided[i] = 0;
+}
+
+/**
+ * @brief Removes a bird by moving the last bird into its slot
+ * @param i Bird index
+ *
+ * Constant time, and never frees memory, so a pool can shed birds as
+ * they go out and grow back to its old size without allocating. The
+ * last bird changes index.
+ */
+void BirdPool::remove(std::size_t i)
+{
+    std::size_t last = size() - 1;
+    x[i] = x[last];
+    y[i] = y[last];
+    prev_y[i] = prev_y[last];
+    checked_y[i] = checked_y[last];
+    velocity[i] = velocity[last];
+    animation[i] = animation[last];
+    animation_switch[i] = animation_switch[last];
+    frame[i] = frame[last];
+    flying[i] = flying[last];
+    active[i] = active[last];
+    collided[i] = collided[last];
+    resize(last);
+}
+
+/**
+ * @brief Enables or disables physics for every bird
+ * @param should_fly True to enable physics
+ */
+void BirdPool::setFlying(bool should_fly)
+{
+    for (std::int32_t& f : flying)
+        f = should_fly ? 1 : 0;
+}
+
+/**
+ * @brief Remembers current positions for render interpolation
+ */
+void BirdPool::savePositions()
+{
+    prev_y = y;
+}
+
+/**
+ * @brief Applies the flap impulse to every bird whose flag is set
+ * @param flaps One flag per bird (non-zero = flap)
+ * @param flap_speed Upward velocity applied (pixels per second)
+ */
+void BirdPool::flap(const std::uint8_t* flaps, float flap_speed)
+{
+    float* __restrict v = velocity.data();
+    std::size_t n = size();
+
+    // Negative because Y increases downward
+    for (std::size_t i = 0; i < n; i++)
+        v[i] = flaps[i] ? -flap_speed : v[i];
+}
+
+/**
+ * @brief Advances animation, gravity and movement of every airborne bird
+ * @param gravity Gravitational acceleration (pixels per second squared)
+ * @param dt Tick duration in seconds
+ * @param floor Birds at or below this top edge stop moving
+ *
+ * A bird moves only while physics are enabled and it is above the floor.
+ * Its wing frame changes every 10 ticks, and it cannot rise above the
+ * top of the screen.
+ */
+void BirdPool::integrate(float gravity, float dt, float floor)
+{
+    float* __restrict py = y.data();
+    float* __restrict pv = velocity.data();
+    std::int32_t* __restrict anim = animation.data();
+    std::int32_t* __restrict sw = animation_switch.data();
+    std::int32_t* __restrict fr = frame.data();
+    const std::int32_t* __restrict fly = flying.data();
+    std::size_t n = size();
+
+    // Animation pass
+    for (std::size_t i = 0; i < n; i++)
+    {
+        std::int32_t moving = fly[i] & static_cast<std::int32_t>(py[i] < floor);
+        std::int32_t turn = moving & static_cast<std::int32_t>(anim[i] == 10);
+        std::int32_t keep = turn - 1;    // All ones unless the frame turns
+        fr[i] = (fr[i] & keep) | (sw[i] & ~keep);
+        sw[i] ^= turn;
+        anim[i] = ((anim[i] + moving) & keep) | (turn & ~keep);
+    }
+
+    // Gravity, movement and ceiling clamp pass
+    for (std::size_t i = 0; i < n; i++)
+    {
+        float moving = static_cast<float>(fly[i] & static_cast<std::int32_t>(py[i] < floor));
+        float v = pv[i] + gravity * dt * moving;
+        float new_y = py[i] + v * dt * moving;
+        pv[i] = v;
+        py[i] = new_y < 0.f ? 0.f : new_y;
+    }
+}
+
+/**
+ * @brief Gets the times during which a moving interval overlaps a fixed one
+ * @param start Start of the moving interval at time 0
+ * @param velocity Distance it moves per unit of time
+ * @param low Overlap needs start + velocity * t > low
+ * @param high Overlap needs start + velocity * t < high
+ * @param enter Receives the time overlap begins (may be negative)
+ * @param exit Receives the time overlap ends
+ *
+ * Branch-free so the caller's loop vectorizes: a still interval either
+ * always or never overlaps.
+ */
+static inline void slab(float start, float velocity, float low, float high, float& enter, float& exit)
+{
+    const float never = 1e30f;
+    float inverse = 1.f / (velocity + (velocity == 0.f ? 1.f : 0.f));  // Written so the division stays unconditional
+    float to_low = (low - start) * inverse;
+    float to_high = (high - start) * inverse;
+    float first = to_low < to_high ? to_low : to_high;
+    float last = to_low < to_high ? to_high : to_low;
+    float still_enter = (low < start) & (start < high) ? -never : never;
+    enter = velocity == 0.f ? still_enter : first;
+    exit = velocity == 0.f ? -still_enter : last;
+}
+
+/**
+ * @brief Marks birds whose box touches a moving box at any time during a tick
+ * @param left Left edge of the box at the end of the tick
+ * @param top Top edge of the box
+ * @param width Width of the box
+ * @param height Height of the box
+ * @param dx How far the box moved along x during the tick
+ * @param hits One flag per bird; set to 1 for each bird hit, untouched otherwise
+ * @param impacts One time per bird; set to the fraction of the tick at first contact for each bird hit
+ *
+ * Each bird moves in a straight line from checked_y to y while the box
+ * moves from left - dx to left. In the box's frame that is one segment
+ * per bird, tested against the box widened by the bird's size (the
+ * slab method), which cannot step over the box however far either moves
+ * in one tick. Touching at the end of the tick is the same strict
+ * overlap as sf::Rect::intersects.
+ */
+void BirdPool::sweep(float left, float top, float width, float height, float dx,
+                     std::int32_t* hits, float* impacts) const
+{
+    const float* __restrict px = x.data();
+    const float* __restrict py = y.data();
+    const float* __restrict from_y = checked_y.data();
+    std::int32_t* __restrict h = hits;
+    float* __restrict toi = impacts;
+    float start_left = left - dx;
+    std::size_t n = size();
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        float enter_x, exit_x, enter_y, exit_y;
+        slab(px[i], -dx, start_left - bird_width, start_left + width, enter_x, exit_x);
+        slab(from_y[i], py[i] - from_y[i], top - bird_height, top + height, enter_y, exit_y);
+        float enter = enter_x > enter_y ? enter_x : enter_y;
+        float exit = exit_x < exit_y ? exit_x : exit_y;
+        bool hit = (enter < exit) & (enter < 1.f) & (exit > 0.f);
+        float previous = toi[i];
+        float contact = enter > 0.f ? enter : 0.f;
+        h[i] |= hit;
+        toi[i] = hit ? contact : previous;
+    }
+}
+
+/**
+ * @brief Gets the horizontal span covered by every bird's collision box
+ * @param left Receives the leftmost left edge
+ * @param right Receives the rightmost right edge
+ */
+void BirdPool::getExtent(float& left, float& right) const
+{
+    const float* __restrict px = x.data();
+    std::size_t n = size();
+    float low = px[0];
+    float high = px[0];
+
+    for (std::size_t i = 1; i < n; i++)
+    {
+        low = px[i] < low ? px[i] : low;
+        high = px[i] > high ? px[i] : high;
+    }
+    left = low;
+    right = high + bird_width;
+}
+
+/**
+ * @brief Marks birds at or below the ground line
+ * @param ground Top edge at or below which a bird counts as grounded
+ * @param hits One flag per bird; set to 1 for each bird hit, untouched otherwise
+ */
+void BirdPool::hitGround(float ground, std::int32_t* hits) const
+{
+    const float* __restrict py = y.data();
+    std::int32_t* __restrict h = hits;
+    std::size_t n = size();
+
+    for (std::size_t i = 0; i < n; i++)
+        h[i] |= py[i] >= ground;
+}
+
+/**
+ * @brief Copies one bird out as a plain BirdState
+ * @param i Bird index
+ * @return Snapshot of the bird
+ */
+BirdState BirdPool::get(std::size_t i) const
+{
+    BirdState bird;
+    bird.x = x[i];
+    bird.y = y[i];
+    bird.prev_y = prev_y[i];
+    bird.velocity = velocity[i];
+    bird.animation = animation[i];
+    bird.animation_switch = animation_switch[i];
+    bird.frame = frame[i];
+    bird.flying = flying[i] != 0;
+    bird.active = active[i] != 0;
+    bird.collided = collided[i] != 0;
+    return bird;
+}
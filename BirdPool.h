@@ -0,0 +1,126 @@
+/**
+ * @file BirdPool.h
+ * @brief Header file for the BirdPool class in Flappy Bird 2-player game
+ *
+ * This file defines the structure-of-arrays store for any number of birds.
+ * Each bird attribute lives in its own contiguous array, and physics runs
+ * as whole-array passes that the compiler turns into SIMD loops, so the
+ * same code handles two players or thousands of bots per tick.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct BirdState;
+
+/**
+ * @class BirdPool
+ * @brief Structure-of-arrays bird physics for N birds
+ *
+ * Flags are stored as 32-bit integers (0 or 1) rather than bool so that
+ * they have the same width as the float attributes; every pass is then a
+ * branch-free loop over equally sized lanes that vectorizes cleanly.
+ */
+class BirdPool
+{
+public:
+    std::vector<float> x;                    ///< Left edges of the collision boxes
+    std::vector<float> y;                    ///< Top edges of the collision boxes
+    std::vector<float> prev_y;               ///< Values of y before the last tick
+    std::vector<float> checked_y;            ///< Values of y at the last collision check (where sweeps start)
+    std::vector<float> velocity;             ///< Vertical velocities (pixels per second)
+    std::vector<std::int32_t> animation;     ///< Animation frame counters
+    std::vector<std::int32_t> animation_switch;  ///< Wing positions to show on the next animation step
+    std::vector<std::int32_t> frame;         ///< Wing positions currently shown
+    std::vector<std::int32_t> flying;        ///< 1 if bird physics are active
+    std::vector<std::int32_t> active;        ///< 1 if the bird is still in the match
+    std::vector<std::int32_t> collided;      ///< 1 if the bird has hit a pipe or the ground
+
+    /**
+     * @brief Changes the number of birds (new birds start zeroed)
+     * @param count Number of birds
+     */
+    void resize(std::size_t count);
+
+    /**
+     * @brief Gets the number of birds
+     * @return Bird count
+     */
+    std::size_t size() const { return y.size(); }
+
+    /**
+     * @brief Puts a bird back at a starting position, at rest and in the match
+     * @param i Bird index
+     * @param start_x Starting left edge
+     * @param start_y Starting top edge
+     */
+    void place(std::size_t i, float start_x, float start_y);
+
+    /**
+     * @brief Removes a bird by moving the last bird into its slot
+     * @param i Bird index
+     */
+    void remove(std::size_t i);
+
+    /**
+     * @brief Enables or disables physics for every bird
+     * @param should_fly True to enable physics
+     */
+    void setFlying(bool should_fly);
+
+    /**
+     * @brief Remembers current positions for render interpolation
+     */
+    void savePositions();
+
+    /**
+     * @brief Applies the flap impulse to every bird whose flag is set
+     * @param flaps One flag per bird (non-zero = flap)
+     * @param flap_speed Upward velocity applied (pixels per second)
+     */
+    void flap(const std::uint8_t* flaps, float flap_speed);
+
+    /**
+     * @brief Advances animation, gravity and movement of every airborne bird
+     * @param gravity Gravitational acceleration (pixels per second squared)
+     * @param dt Tick duration in seconds
+     * @param floor Birds at or below this top edge stop moving
+     */
+    void integrate(float gravity, float dt, float floor);
+
+    /**
+     * @brief Marks birds whose box touches a moving box at any time during a tick
+     * @param left Left edge of the box at the end of the tick
+     * @param top Top edge of the box
+     * @param width Width of the box
+     * @param height Height of the box
+     * @param dx How far the box moved along x during the tick
+     * @param hits One flag per bird; set to 1 for each bird hit, untouched otherwise
+     * @param impacts One time per bird; set to the fraction of the tick at first contact for each bird hit
+     */
+    void sweep(float left, float top, float width, float height, float dx,
+               std::int32_t* hits, float* impacts) const;
+
+    /**
+     * @brief Gets the horizontal span covered by every bird's collision box
+     * @param left Receives the leftmost left edge
+     * @param right Receives the rightmost right edge
+     */
+    void getExtent(float& left, float& right) const;
+
+    /**
+     * @brief Marks birds at or below the ground line
+     * @param ground Top edge at or below which a bird counts as grounded
+     * @param hits One flag per bird; set to 1 for each bird hit, untouched otherwise
+     */
+    void hitGround(float ground, std::int32_t* hits) const;
+
+    /**
+     * @brief Copies one bird out as a plain BirdState
+     * @param i Bird index
+     * @return Snapshot of the bird
+     */
+    BirdState get(std::size_t i) const;
+};
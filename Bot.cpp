@@ -0,0 +1,80 @@
+/**
+ * @file Bot.cpp
+ * @brief Implementation of the Bot class for Flappy Bird 2-player game
+ *
+ * This file contains the rule-based flap decision used by bot players.
+ */
+
+#include "Bot.h"
+#include "Globals.h"
+#include "SplitMix64.h"
+
+/**
+ * @brief Constructor - creates a bot for one bird
+ * @param player Bird to control (0 or 1)
+ * @param seed Seed for the bot's aim jitter
+ * @param aim_error Maximum random offset added to the aim line (pixels)
+ */
+Bot::Bot(int player, std::uint64_t seed, float aim_error) :
+player(player),
+aim_error(aim_error),
+state(seed)
+{
+}
+
+/**
+ * @brief Draws a random value for aim jitter (SplitMix64)
+ * @return Uniform value in [-1, 1)
+ */
+float Bot::nextNoise()
+{
+    std::uint64_t x = splitMix64Next(state);
+    return static_cast<float>(x >> 40) / static_cast<float>(1 << 23) - 1.f;
+}
+
+/**
+ * @brief Decides whether the bot's bird should flap this tick
+ * @param sim Match being played
+ * @return True to flap
+ *
+ * Aims 30 pixels above the lower pipe of the first gap the bird has not
+ * yet cleared (or mid-screen when there is none). Flapping is allowed
+ * again once the previous flap has mostly worn off, so the bird can
+ * climb steeply towards a much higher gap.
+ */
+bool Bot::shouldFlap(const Simulation& sim)
+{
+    const BirdState& bird = sim.getBird(player);
+    if (!bird.active)
+        return false;
+
+    float target = 300.f;
+    for (const PipeState& pipe : sim.getPipes())
+    {
+        if (pipe.x + pipe_width > bird.x)
+        {
+            target = pipe.y_pos - bird_height - 30.f;
+            break;
+        }
+    }
+    if (aim_error > 0.f)
+        target += aim_error * nextNoise();
+
+    return bird.y > target && bird.velocity > -200.f;
+}
+
+/**
+ * @brief Fills in the bot's part of the next tick's input
+ * @param sim Match being played
+ * @param input Input to update (start and the bot's flap flag)
+ *
+ * Also presses Enter whenever the match is paused by a collision
+ * while a player is still in, so bot matches never stall.
+ */
+void Bot::play(const Simulation& sim, SimInput& input)
+{
+    if (!sim.isRunning() && !sim.isOver())
+        input.start = true;
+    if (shouldFlap(sim))
+        input.flap[player] = true;
+}
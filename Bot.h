@@ -0,0 +1,56 @@
+/**
+ * @file Bot.h
+ * @brief Header file for the Bot class in Flappy Bird 2-player game
+ *
+ * This file defines a simple rule-based player that can drive either
+ * bird of a Simulation, used for unattended and batch matches.
+ */
+
+#pragma once
+#include <cstdint>
+#include "Simulation.h"
+
+/**
+ * @class Bot
+ * @brief Heuristic player that flaps to stay just above the next pipe gap's bottom
+ *
+ * The bot aims a fixed margin above the lower pipe of the next gap and
+ * flaps whenever its bird sinks below that line. A seeded aim error makes
+ * its play imperfect, so batches of matches produce a spread of results.
+ */
+class Bot
+{
+private:
+    int player;              ///< Bird controlled by the bot (0 or 1)
+    float aim_error;         ///< Maximum random offset added to the aim line (pixels)
+    std::uint64_t state;     ///< State of the bot's private random generator
+
+    /**
+     * @brief Draws a random value for aim jitter
+     * @return Uniform value in [-1, 1)
+     */
+    float nextNoise();
+
+public:
+    /**
+     * @brief Constructor - creates a bot for one bird
+     * @param player Bird to control (0 or 1)
+     * @param seed Seed for the bot's aim jitter
+     * @param aim_error Maximum random offset added to the aim line (pixels)
+     */
+    Bot(int player, std::uint64_t seed = 0, float aim_error = 0.f);
+
+    /**
+     * @brief Decides whether the bot's bird should flap this tick
+     * @param sim Match being played
+     * @return True to flap
+     */
+    bool shouldFlap(const Simulation& sim);
+
+    /**
+     * @brief Fills in the bot's part of the next tick's input
+     * @param sim Match being played
+     * @param input Input to update (start and the bot's flap flag)
+     */
+    void play(const Simulation& sim, SimInput& input);
+};
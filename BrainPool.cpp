@@ -0,0 +1,120 @@
+/**
+ * @file BrainPool.cpp
+ * @brief Implementation of the BrainPool class for Flappy Bird 2-player game
+ *
+ * This file contains the batched network evaluation. Every loop runs
+ * across networks over restrict pointers with no branches, so compilers
+ * vectorize them (GCC and Clang at -O3).
+ */
+
+#include "BrainPool.h"
+#include <cmath>
+
+static_assert(BrainPool::inputs == 3, "BrainPool::forward() is written out for three inputs");
+
+/**
+ * @brief Constructor - reserves room for a number of networks
+ * @param max_count Most networks the pool will hold
+ *
+ * The pool starts empty; this is the only allocation it makes.
+ */
+BrainPool::BrainPool(std::size_t max_count) :
+capacity(max_count),
+count(0),
+weights(params * max_count, 0.f),
+output(max_count, 0.f)
+{
+}
+
+/**
+ * @brief Changes the number of networks (at most the capacity)
+ * @param new_count Number of networks
+ *
+ * Networks added this way keep whatever parameters their slots held;
+ * load() them before use.
+ */
+void BrainPool::resize(std::size_t new_count)
+{
+    count = new_count < capacity ? new_count : capacity;
+}
+
+/**
+ * @brief Sets the parameters of one network
+ * @param i Network index
+ * @param genome params floats
+ */
+void BrainPool::load(std::size_t i, const float* genome)
+{
+    for (int p = 0; p < params; p++)
+        weights[p * capacity + i] = genome[p];
+}
+
+/**
+ * @brief Removes a network by moving the last network into its slot
+ * @param i Network index
+ *
+ * Mirrors BirdPool::remove(), so a bird and its network keep sharing
+ * an index.
+ */
+void BrainPool::remove(std::size_t i)
+{
+    std::size_t last = count - 1;
+    for (int p = 0; p < params; p++)
+        weights[p * capacity + i] = weights[p * capacity + last];
+    count = last;
+}
+
+/**
+ * @brief Squashes a value into (-1, 1)
+ * @param x Value
+ * @return Softsign of x, x / (1 + |x|)
+ *
+ * Shaped like tanh, but with no library call and no clamping branch,
+ * either of which would stop the forward loop from vectorizing.
+ */
+static inline float squash(float x)
+{
+    return x / (1.f + std::fabs(x));
+}
+
+/**
+ * @brief Runs every network once
+ * @param in inputs arrays of size() values, one array per input
+ * @param flaps One flag per network; set to 1 to flap, 0 otherwise
+ *
+ * Works one hidden unit at a time: each is a row-by-row multiply-add
+ * over all networks, whose activation is then folded straight into the
+ * output, so only one accumulator array is ever live.
+ */
+void BrainPool::forward(const float* const* in, std::uint8_t* flaps)
+{
+    float* __restrict out = output.data();
+    const std::size_t n = count;
+
+    const float* __restrict out_bias = &weights[(params - 1) * capacity];
+    for (std::size_t i = 0; i < n; i++)
+        out[i] = out_bias[i];
+
+    for (int h = 0; h < hidden; h++)
+    {
+        const float* row = &weights[h * (inputs + 2) * capacity];
+        const float* __restrict w0 = row;
+        const float* __restrict w1 = row + capacity;
+        const float* __restrict w2 = row + 2 * capacity;
+        const float* __restrict bias = row + inputs * capacity;
+        const float* __restrict w_out = row + (inputs + 1) * capacity;
+        const float* __restrict x0 = in[0];
+        const float* __restrict x1 = in[1];
+        const float* __restrict x2 = in[2];
+
+        for (std::size_t i = 0; i < n; i++)
+        {
+            float sum = bias[i] + w0[i] * x0[i] + w1[i] * x1[i] + w2[i] * x2[i];
+            out[i] += w_out[i] * squash(sum);
+        }
+    }
+
+    std::uint8_t* __restrict f = flaps;
+    for (std::size_t i = 0; i < n; i++)
+        f[i] = out[i] > 0.f;
+}
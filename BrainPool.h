@@ -0,0 +1,82 @@
+/**
+ * @file BrainPool.h
+ * @brief Header file for the BrainPool class in Flappy Bird 2-player game
+ *
+ * This file defines a store of many tiny neural networks, one per bird,
+ * evaluated together. Like BirdPool it keeps every parameter in its own
+ * contiguous array across all networks, so a forward pass is a handful
+ * of whole-array multiply-add loops the compiler turns into SIMD code.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BrainPool
+ * @brief Batched forward passes of N one-hidden-layer networks
+ *
+ * Each network maps inputs values to one output through hidden
+ * softsign units (a cheap tanh); a positive output means flap. A
+ * network is described by a genome of params floats, laid out hidden
+ * unit by hidden unit (its input weights, its bias, its output weight)
+ * followed by the output bias.
+ *
+ * Parameter p of network i is stored at p * capacity + i, so each step
+ * of the forward pass reads one contiguous row per parameter. Networks
+ * can be removed in constant time without reallocating, like birds in
+ * a BirdPool.
+ */
+class BrainPool
+{
+public:
+    static constexpr int inputs = 3;                       ///< Values each network reads
+    static constexpr int hidden = 6;                       ///< Hidden units per network
+    static constexpr int params = hidden * (inputs + 2) + 1;  ///< Floats in one genome
+
+private:
+    std::size_t capacity;          ///< Most networks the pool can hold (row stride)
+    std::size_t count;             ///< Networks currently in the pool
+    std::vector<float> weights;    ///< params rows of capacity floats
+    std::vector<float> output;     ///< Output accumulator of the last forward pass
+
+public:
+    /**
+     * @brief Constructor - reserves room for a number of networks
+     * @param max_count Most networks the pool will hold
+     */
+    explicit BrainPool(std::size_t max_count = 0);
+
+    /**
+     * @brief Gets the number of networks
+     * @return Network count
+     */
+    std::size_t size() const { return count; }
+
+    /**
+     * @brief Changes the number of networks (at most the capacity)
+     * @param new_count Number of networks
+     */
+    void resize(std::size_t new_count);
+
+    /**
+     * @brief Sets the parameters of one network
+     * @param i Network index
+     * @param genome params floats
+     */
+    void load(std::size_t i, const float* genome);
+
+    /**
+     * @brief Removes a network by moving the last network into its slot
+     * @param i Network index
+     */
+    void remove(std::size_t i);
+
+    /**
+     * @brief Runs every network once
+     * @param in inputs arrays of size() values, one array per input
+     * @param flaps One flag per network; set to 1 to flap, 0 otherwise
+     */
+    void forward(const float* const* in, std::uint8_t* flaps);
+};
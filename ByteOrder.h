@@ -0,0 +1,65 @@
+/**
+ * @file ByteOrder.h
+ * @brief Little-endian integer encoding for Flappy Bird 2-player game
+ *
+ * This file defines the helpers every file format and packet of the game
+ * uses to store integers: replays through streams, network packets
+ * through byte buffers.
+ */
+
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+/**
+ * @brief Writes an unsigned integer as little-endian bytes
+ * @param out Destination
+ * @param value Value to write
+ * @param bytes Number of bytes to write
+ */
+inline void putLE(std::uint8_t* out, std::uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        out[i] = static_cast<std::uint8_t>(value >> (8 * i));
+}
+
+/**
+ * @brief Reads an unsigned little-endian integer
+ * @param in Source
+ * @param bytes Number of bytes to read
+ * @return Value read
+ */
+inline std::uint64_t getLE(const std::uint8_t* in, int bytes)
+{
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; i++)
+        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+/**
+ * @brief Writes an unsigned integer as little-endian bytes
+ * @param out Stream to write to
+ * @param value Value to write
+ * @param bytes Number of bytes to write
+ */
+inline void writeLE(std::ostream& out, std::uint64_t value, int bytes)
+{
+    for (int i = 0; i < bytes; i++)
+        out.put(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+/**
+ * @brief Reads an unsigned little-endian integer
+ * @param in Stream to read from
+ * @param bytes Number of bytes to read
+ * @return Value read (garbage if the stream fails)
+ */
+inline std::uint64_t readLE(std::istream& in, int bytes)
+{
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; i++)
+        value |= static_cast<std::uint64_t>(static_cast<std::uint8_t>(in.get())) << (8 * i);
+    return value;
+}
@@ -0,0 +1,47 @@
+/**
+ * @file CollisionMasks.cpp
+ * @brief Loading of the sprite collision masks for Flappy Bird 2-player game
+ */
+
+#include "CollisionMasks.h"
+#include "Globals.h"
+#include <SFML/Graphics.hpp>
+#include <string>
+
+/**
+ * @brief Builds one mask from an image file
+ * @param path Image file path
+ * @param width On-screen width of the sprite
+ * @param height On-screen height of the sprite
+ * @param mask Mask to fill
+ * @return True if the image could be loaded
+ */
+static bool loadMask(const std::string& path, float width, float height, PixelMask& mask)
+{
+    sf::Image image;
+    if (!image.loadFromFile(path))
+        return false;
+
+    sf::Vector2u size = image.getSize();
+    mask.build(image.getPixelsPtr(), static_cast<int>(size.x), static_cast<int>(size.x), static_cast<int>(size.y),
+               static_cast<int>(width), static_cast<int>(height));
+    return true;
+}
+
+/**
+ * @brief Builds every mask from the sprite images in assets/
+ * @return True if every image could be loaded
+ */
+bool CollisionMasks::load()
+{
+    bool loaded = true;
+    for (int player = 0; player < 2; player++)
+    {
+        std::string prefix = "assets/bird" + std::to_string(player + 1);
+        loaded = loadMask(prefix + "down.png", bird_width, bird_height, birds[player][0]) && loaded;
+        loaded = loadMask(prefix + "up.png", bird_width, bird_height, birds[player][1]) && loaded;
+    }
+    loaded = loadMask("assets/pipedown.png", pipe_width, pipe_height, pipe_upper) && loaded;
+    loaded = loadMask("assets/pipe.png", pipe_width, pipe_height, pipe_lower) && loaded;
+    return loaded;
+}
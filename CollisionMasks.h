@@ -0,0 +1,32 @@
+/**
+ * @file CollisionMasks.h
+ * @brief Header file for the CollisionMasks struct in Flappy Bird 2-player game
+ *
+ * This file defines the set of sprite masks the Simulation uses for
+ * pixel-exact collisions. Loading them needs SFML's image decoder, but
+ * only the loader does; the header stays free of SFML.
+ */
+
+#pragma once
+#include "PixelMask.h"
+
+/**
+ * @struct CollisionMasks
+ * @brief Masks of every gameplay sprite the simulation collides
+ *
+ * Masks are sampled at the size each sprite is drawn on screen (its
+ * collision box), straight from the asset files, so the windowed game and
+ * a headless replay build bit-identical masks.
+ */
+struct CollisionMasks
+{
+    PixelMask birds[2][2];   ///< Bird masks by player look, then wing position (0 = down, 1 = up)
+    PixelMask pipe_upper;    ///< Upper pipe segment
+    PixelMask pipe_lower;    ///< Lower pipe segment
+
+    /**
+     * @brief Builds every mask from the sprite images in assets/
+     * @return True if every image could be loaded
+     */
+    bool load();
+};
@@ -0,0 +1,194 @@
+/**
+ * @file CollisionWorld.cpp
+ * @brief Implementation of the CollisionWorld class for Flappy Bird 2-player game
+ */
+
+#include "CollisionWorld.h"
+#include "BirdPool.h"
+#include "CollisionMasks.h"
+#include "Globals.h"
+#include <algorithm>
+#include <cmath>
+
+static const float no_impact = 2.f;   ///< Impact time meaning "never touched"
+
+/**
+ * @brief Constructor - reserves room for a typical number of boxes
+ * @param capacity Boxes that can be added without allocating
+ */
+CollisionWorld::CollisionWorld(std::size_t capacity) :
+max_width(0.f)
+{
+    obstacles.reserve(capacity);
+}
+
+/**
+ * @brief Reserves per-bird scratch space
+ * @param birds Birds that can be tested without allocating
+ *
+ * Scratch otherwise grows with the largest pool seen by collide(), which
+ * for a population that thins out can happen at any point of a run.
+ */
+void CollisionWorld::reserveBirds(std::size_t birds)
+{
+    box_hits.reserve(birds);
+    box_impacts.reserve(birds);
+    impacts.reserve(birds);
+}
+
+/**
+ * @brief Removes every obstacle (keeps the storage)
+ */
+void CollisionWorld::clear()
+{
+    obstacles.clear();
+    max_width = 0.f;
+}
+
+/**
+ * @brief Adds an obstacle for the next query
+ * @param box Obstacle box at the end of the tick
+ * @param mask Opaque pixels of the box (same size), or nullptr if solid
+ * @param dx Distance the box moved along x during the tick
+ */
+void CollisionWorld::add(const Aabb& box, const PixelMask* mask, float dx)
+{
+    Obstacle obstacle = { box, dx, std::min(box.left, box.left - dx), box.width + std::fabs(dx), mask };
+    obstacles.push_back(obstacle);
+    max_width = std::max(max_width, obstacle.swept_width);
+}
+
+/**
+ * @brief Sorts the obstacles by swept left edge
+ *
+ * Pipes are spawned in x order and all move at the same speed, so the
+ * boxes almost always arrive sorted; insertion sort is then one linear
+ * pass, and still correct if some future obstacle breaks the order.
+ */
+void CollisionWorld::build()
+{
+    for (std::size_t i = 1; i < obstacles.size(); i++)
+    {
+        Obstacle obstacle = obstacles[i];
+        std::size_t j = i;
+        for (; j > 0 && obstacles[j - 1].swept_left > obstacle.swept_left; j--)
+            obstacles[j] = obstacles[j - 1];
+        obstacles[j] = obstacle;
+    }
+}
+
+/**
+ * @brief Finds the first obstacle that could reach a column's left edge
+ * @param obstacles Obstacles sorted by swept left edge
+ * @param left Left edge of the column
+ * @param max_width Widest swept area
+ * @return First obstacle whose swept left edge is within max_width of the column
+ */
+template <typename Obstacles>
+static typename Obstacles::const_iterator sweepStart(const Obstacles& obstacles, float left, float max_width)
+{
+    return std::lower_bound(obstacles.begin(), obstacles.end(), left - max_width,
+                            [](const typename Obstacles::value_type& obstacle, float edge) { return obstacle.swept_left < edge; });
+}
+
+/**
+ * @brief Marks every bird that touched any obstacle during the tick
+ * @param birds Birds to test (moving from checked_y to y)
+ * @param hits One flag per bird; set to 1 for each bird hit, untouched otherwise
+ * @param masks Bird masks for pixel-exact tests, or nullptr to test boxes only
+ *
+ * The column is the x-range covered by all birds together. Boxes whose
+ * swept area is outside it cannot touch any bird and are skipped; the
+ * rest go through the swept per-bird box test. For a masked obstacle the
+ * box test only nominates birds, and each nominee's mask (by player
+ * look, bird index modulo 2, and wing position) is ANDed against the
+ * obstacle's mask along the tick.
+ */
+void CollisionWorld::collide(const BirdPool& birds, std::int32_t* hits, const CollisionMasks* masks)
+{
+    impacts.assign(birds.size(), no_impact);
+    if (birds.size() == 0 || obstacles.empty())
+        return;
+
+    float left, right;
+    birds.getExtent(left, right);
+
+    for (std::vector<Obstacle>::const_iterator it = sweepStart(obstacles, left, max_width);
+         it != obstacles.end() && it->swept_left < right; ++it)
+    {
+        const Aabb& box = it->box;
+        if (it->swept_left + it->swept_width <= left)
+            continue;
+
+        box_hits.assign(birds.size(), 0);
+        box_impacts.resize(birds.size());
+        birds.sweep(box.left, box.top, box.width, box.height, it->dx, box_hits.data(), box_impacts.data());
+
+        if (masks && it->mask)
+        {
+            for (std::size_t i = 0; i < birds.size(); i++)
+            {
+                float impact = box_impacts[i];
+                if (box_hits[i] && refine(birds, i, masks->birds[i & 1][birds.frame[i] & 1], *it, impact))
+                {
+                    hits[i] = 1;
+                    impacts[i] = std::min(impacts[i], impact);
+                }
+            }
+            continue;
+        }
+
+        const std::int32_t* __restrict box_hit = box_hits.data();
+        const float* __restrict box_impact = box_impacts.data();
+        std::int32_t* __restrict hit = hits;
+        float* __restrict impact = impacts.data();
+        std::size_t n = birds.size();
+        for (std::size_t i = 0; i < n; i++)
+        {
+            std::int32_t touched = box_hit[i];
+            float time = box_impact[i];
+            float earliest = impact[i];
+            float candidate = touched ? time : no_impact;
+            hit[i] |= touched;
+            impact[i] = candidate < earliest ? candidate : earliest;
+        }
+    }
+}
+
+/**
+ * @brief Confirms a box contact pixel by pixel
+ * @param birds Birds being tested
+ * @param bird Index of a bird whose box touches the obstacle
+ * @param bird_mask Mask of that bird
+ * @param obstacle Masked obstacle
+ * @param impact First time the boxes touch; receives the first time the masks touch
+ * @return True if the masks touch during the tick
+ *
+ * Positions are sampled from the box contact to the end of the tick, at
+ * most one pixel of relative motion apart, so thin opaque parts cannot
+ * be stepped over either.
+ */
+bool CollisionWorld::refine(const BirdPool& birds, std::size_t bird, const PixelMask& bird_mask,
+                            const Obstacle& obstacle, float& impact)
+{
+    float from_y = birds.checked_y[bird];
+    float dy = birds.y[bird] - from_y;
+    float start_left = obstacle.box.left - obstacle.dx;
+    int bird_x = static_cast<int>(std::floor(birds.x[bird]));
+    int box_y = static_cast<int>(std::floor(obstacle.box.top));
+
+    float distance = std::max(std::fabs(obstacle.dx), std::fabs(dy)) * (1.f - impact);
+    int steps = static_cast<int>(std::ceil(distance));
+    for (int step = 0; step <= steps; step++)
+    {
+        float t = steps ? impact + (1.f - impact) * step / steps : 1.f;
+        int bird_y = static_cast<int>(std::floor(from_y + dy * t));
+        int box_x = static_cast<int>(std::floor(start_left + obstacle.dx * t));
+        if (PixelMask::overlaps(bird_mask, bird_x, bird_y, *obstacle.mask, box_x, box_y))
+        {
+            impact = t;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file CollisionWorld.h
+ * @brief Header file for the CollisionWorld class in Flappy Bird 2-player game
+ *
+ * This file defines the collision subsystem the simulation tests birds
+ * against: a cached box for every live pipe segment, a sort-and-sweep
+ * broadphase along x, swept narrowphase box tests batched over every
+ * bird, and optional pixel-exact tests of the boxes that touch.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class BirdPool;
+class PixelMask;
+struct CollisionMasks;
+
+/**
+ * @struct Aabb
+ * @brief Axis-aligned box in window pixels
+ */
+struct Aabb
+{
+    float left;      ///< Left edge
+    float top;       ///< Top edge
+    float width;     ///< Width
+    float height;    ///< Height
+};
+
+/**
+ * @class CollisionWorld
+ * @brief Obstacles moved during one tick, sorted by left edge
+ *
+ * Obstacles are added once per tick with how far they moved, and sorted
+ * by the left edge of the area they swept. A collision query only visits
+ * boxes whose swept x-range overlaps the column the birds occupy, found
+ * by binary search and a sweep that stops at the first box past the
+ * column, so the cost does not grow with obstacles elsewhere on screen.
+ * Each box left after the broadphase is swept against every bird's
+ * motion in one vectorized pass (BirdPool::sweep), so nothing tunnels
+ * through a box however fast birds or pipes move. Given pixel masks,
+ * birds whose box touches a masked obstacle are then checked pixel by
+ * pixel along the part of the tick where the boxes touch.
+ */
+class CollisionWorld
+{
+private:
+    /**
+     * @struct Obstacle
+     * @brief Box plus the optional mask of the sprite filling it
+     */
+    struct Obstacle
+    {
+        Aabb box;                ///< Bounding box at the end of the tick
+        float dx;                ///< Distance moved along x during the tick
+        float swept_left;        ///< Left edge of the area swept during the tick
+        float swept_width;       ///< Width of the area swept during the tick
+        const PixelMask* mask;   ///< Opaque pixels of the box, or nullptr if solid
+    };
+
+    std::vector<Obstacle> obstacles;       ///< Obstacles, sorted by swept left edge after build()
+    std::vector<std::int32_t> box_hits;    ///< Per-bird hits of one obstacle
+    std::vector<float> box_impacts;        ///< Per-bird contact times with one obstacle
+    std::vector<float> impacts;            ///< Per-bird earliest contact time of the last collide()
+    float max_width;                       ///< Widest swept area (bounds how far left an overlap can start)
+
+    /**
+     * @brief Confirms a box contact pixel by pixel
+     * @param birds Birds being tested
+     * @param bird Index of a bird whose box touches the obstacle
+     * @param bird_mask Mask of that bird
+     * @param obstacle Masked obstacle
+     * @param impact Receives the first time the masks touch
+     * @return True if the masks touch during the tick
+     */
+    static bool refine(const BirdPool& birds, std::size_t bird, const PixelMask& bird_mask,
+                       const Obstacle& obstacle, float& impact);
+
+public:
+    /**
+     * @brief Constructor - reserves room for a typical number of boxes
+     * @param capacity Boxes that can be added without allocating
+     */
+    explicit CollisionWorld(std::size_t capacity = 32);
+
+    /**
+     * @brief Reserves per-bird scratch space
+     * @param birds Birds that can be tested without allocating
+     */
+    void reserveBirds(std::size_t birds);
+
+    /**
+     * @brief Removes every obstacle (keeps the storage)
+     */
+    void clear();
+
+    /**
+     * @brief Adds an obstacle for the next query
+     * @param box Obstacle box at the end of the tick
+     * @param mask Opaque pixels of the box (same size), or nullptr if solid
+     * @param dx Distance the box moved along x during the tick
+     */
+    void add(const Aabb& box, const PixelMask* mask = nullptr, float dx = 0.f);
+
+    /**
+     * @brief Sorts the obstacles by left edge
+     */
+    void build();
+
+    /**
+     * @brief Gets the number of obstacles
+     * @return Box count
+     */
+    std::size_t size() const { return obstacles.size(); }
+
+    /**
+     * @brief Gets an obstacle
+     * @param i Index in left-edge order (after build())
+     * @return Obstacle box
+     */
+    const Aabb& getBox(std::size_t i) const { return obstacles[i].box; }
+
+    /**
+     * @brief Marks every bird that touched any obstacle during the tick
+     * @param birds Birds to test (moving from checked_y to y)
+     * @param hits One flag per bird; set to 1 for each bird hit, untouched otherwise
+     * @param masks Bird masks for pixel-exact tests, or nullptr to test boxes only
+     */
+    void collide(const BirdPool& birds, std::int32_t* hits, const CollisionMasks* masks = nullptr);
+
+    /**
+     * @brief Gets when each bird first touched an obstacle in the last collide()
+     * @return Fraction of the tick per bird, in [0, 1]; above 1 if no contact
+     */
+    const std::vector<float>& getImpactTimes() const { return impacts; }
+};
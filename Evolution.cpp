@@ -0,0 +1,299 @@
+/**
+ * @file Evolution.cpp
+ * @brief Implementation of the Evolution class for Flappy Bird 2-player game
+ *
+ * This file contains the population flight loop, which follows the tick
+ * order of Simulation::doProcessing() for a whole population at once,
+ * and the genetic operators that breed each generation.
+ */
+
+#include "Evolution.h"
+#include "Globals.h"
+#include "SplitMix64.h"
+#include <algorithm>
+#include <cmath>
+
+static_assert(BrainPool::params <= 64, "Evolution::breed() draws one crossover bit per parameter from 64 random bits");
+
+/// Left edge of every bird (Player 1's spot)
+static constexpr float start_x = Simulation::start_x;
+
+/// Top edge of every bird at the start of a generation (Player 1's spot)
+static constexpr float start_y = Simulation::player1_start_y;
+
+/**
+ * @brief Constructor - creates a random first generation
+ * @param evolution_config Population and breeding parameters
+ * @param seed Seed of the first course and of the random genomes
+ */
+Evolution::Evolution(const EvolutionConfig& evolution_config, std::uint64_t seed) :
+config(evolution_config),
+base_seed(seed),
+generation(0),
+state(seed),
+genomes(config.population * BrainPool::params),
+offspring(config.population * BrainPool::params),
+best_genome(BrainPool::params, 0.f),
+fitness(config.population, 0.f),
+ranking(config.population),
+brains(config.population),
+owners(config.population),
+gap_offsets(config.population),
+pipe_distances(config.population),
+speeds(config.population),
+flaps(config.population),
+hits(config.population),
+colliders(2 * PipePool::capacity())
+{
+    birds.resize(config.population);
+    colliders.reserveBirds(config.population);
+    for (float& weight : genomes)
+        weight = gaussian();
+}
+
+/**
+ * @brief Draws a uniform random value
+ * @return Value in [0, 1)
+ */
+float Evolution::uniform()
+{
+    return static_cast<float>(splitMix64Next(state) >> 40) / (1 << 24);
+}
+
+/**
+ * @brief Draws an approximately normal random value
+ * @return Value with mean 0 and standard deviation 1
+ *
+ * Sum of four uniforms (Irwin-Hall), rescaled. The tails stop at about
+ * 3.5 deviations, which is harmless for mutation and needs no log or
+ * square root.
+ */
+float Evolution::gaussian()
+{
+    float sum = uniform() + uniform() + uniform() + uniform();
+    return (sum - 2.f) * 1.7320508f;
+}
+
+/**
+ * @brief Picks a parent by tournament
+ * @return Genome index
+ *
+ * The fittest of config.tournament genomes drawn at random.
+ */
+std::uint32_t Evolution::select()
+{
+    std::uint32_t best = static_cast<std::uint32_t>(splitMix64Next(state) % config.population);
+    for (int round = 1; round < config.tournament; round++)
+    {
+        std::uint32_t other = static_cast<std::uint32_t>(splitMix64Next(state) % config.population);
+        if (fitness[other] > fitness[best])
+            best = other;
+    }
+    return best;
+}
+
+/**
+ * @brief Flies the current generation and breeds the next one
+ * @return Results of the generation flown
+ */
+GenerationStats Evolution::runGeneration()
+{
+    GenerationStats stats;
+    stats.generation = generation;
+    fly(base_seed + generation, stats);
+    breed();
+    generation++;
+    return stats;
+}
+
+/**
+ * @brief Fills the network inputs of every live bird
+ *
+ * The next pipe is the oldest one whose right edge is still ahead of
+ * the birds; with none on screen, the gap reads as one screen away at
+ * mid height.
+ */
+void Evolution::observe()
+{
+    float gap_centre = window_height / 2.f;
+    float distance = 1.f;
+    for (const PipeState& pipe : pipes)
+    {
+        if (pipe.x + pipe_width > start_x)
+        {
+            gap_centre = pipe.y_pos - pipe.gap / 2.f;
+            distance = (pipe.x - start_x) / window_width;
+            break;
+        }
+    }
+
+    const float* __restrict y = birds.y.data();
+    const float* __restrict v = birds.velocity.data();
+    float* __restrict offset = gap_offsets.data();
+    float* __restrict ahead = pipe_distances.data();
+    float* __restrict speed = speeds.data();
+    std::size_t n = birds.size();
+    for (std::size_t i = 0; i < n; i++)
+    {
+        offset[i] = (y[i] + bird_height / 2.f - gap_centre) / window_height;
+        ahead[i] = distance;
+        speed[i] = v[i] / 600.f;
+    }
+}
+
+/**
+ * @brief Flies every genome over one course and scores it
+ * @param course Pipe course seed
+ * @param stats Receives survival and score results
+ *
+ * One loop iteration is one Simulation tick for the whole population:
+ * the networks decide, flaps apply, pipes spawn and move, birds that hit
+ * a pipe or the ground are scored and removed, and the rest fall.
+ */
+void Evolution::fly(std::uint64_t course, GenerationStats& stats)
+{
+    const std::uint64_t max_ticks = static_cast<std::uint64_t>(config.max_seconds * Simulation::tick_rate);
+
+    birds.resize(config.population);
+    brains.resize(config.population);
+    for (std::size_t i = 0; i < config.population; i++)
+    {
+        birds.place(i, start_x, start_y);
+        brains.load(i, &genomes[i * BrainPool::params]);
+        owners[i] = static_cast<std::uint32_t>(i);
+    }
+    birds.setFlying(true);
+
+    pipe_stream.setSeed(course);
+    pipes.clear();
+    std::uint64_t pipe_index = 0;
+    const int pipe_spawn_time = Simulation::pipe_spawn_interval;
+    int pipe_counter = pipe_spawn_time + 1;
+    int passed = 0;
+    std::uint64_t best_ticks = 0;
+    double survival_sum = 0;
+
+    const float* inputs[BrainPool::inputs] = { gap_offsets.data(), pipe_distances.data(), speeds.data() };
+    std::uint64_t tick = 0;
+    for (; tick < max_ticks && birds.size() > 0; tick++)
+    {
+        stats.bird_ticks += birds.size();
+
+        observe();
+        brains.forward(inputs, flaps.data());
+        birds.flap(flaps.data(), static_cast<float>(config.sim.birdflapspeed));
+
+        if (pipe_counter > pipe_spawn_time)
+        {
+            if (pipes.full())
+                pipes.pop_front();
+            pipes.emplace_back(static_cast<float>(window_width),
+                               static_cast<float>(window_width),
+                               static_cast<float>(pipe_stream.getHeight(pipe_index++)),
+                               static_cast<float>(config.sim.pipe_distance));
+            pipe_counter = 0;
+        }
+        pipe_counter++;
+
+        for (PipeState& pipe : pipes)
+        {
+            pipe.prev_x = pipe.x;
+            pipe.x -= config.sim.pipe_move_speed * Simulation::tick_dt;
+            // Every bird is at start_x, so a pipe clearing it scores for all of them
+            passed += pipe.prev_x + pipe_width >= start_x && pipe.x + pipe_width < start_x;
+        }
+        while (!pipes.empty() && pipes.front().x + pipe_width < 0)
+            pipes.pop_front();
+
+        std::size_t n = birds.size();
+        std::fill(hits.begin(), hits.begin() + n, 0);
+        if (pipes.size() > 0)
+        {
+            colliders.clear();
+            for (const PipeState& pipe : pipes)
+            {
+                float dx = pipe.x - pipe.prev_x;
+                colliders.add({ pipe.x, pipe.y_pos - pipe.gap - pipe_height, pipe_width, pipe_height }, nullptr, dx);
+                colliders.add({ pipe.x, pipe.y_pos, pipe_width, pipe_height }, nullptr, dx);
+            }
+            colliders.build();
+            colliders.collide(birds, hits.data());
+        }
+        birds.hitGround(Simulation::ground_line, hits.data());
+        birds.checked_y = birds.y;
+
+        // Remove from the back, so the bird moved into a freed slot has already been checked
+        for (std::size_t i = n; i-- > 0;)
+        {
+            if (!hits[i])
+                continue;
+            std::uint32_t owner = owners[i];
+            float miss = std::fabs(gap_offsets[i]);   // Measured at the start of the tick
+            fitness[owner] = static_cast<float>(tick) + 1.f - std::min(miss, 1.f);
+            stats.best_score = std::max(stats.best_score, passed);
+            best_ticks = tick;
+            survival_sum += tick;
+
+            birds.remove(i);
+            brains.remove(i);
+            owners[i] = owners[birds.size()];
+        }
+
+        birds.integrate(static_cast<float>(config.sim.gravity), Simulation::tick_dt, Simulation::floor_y);
+    }
+
+    // Birds still flying at the cut-off
+    stats.finished = birds.size();
+    for (std::size_t i = 0; i < birds.size(); i++)
+        fitness[owners[i]] = static_cast<float>(tick) + 1.f;
+    if (stats.finished > 0)
+    {
+        stats.best_score = std::max(stats.best_score, passed);
+        best_ticks = tick;
+    }
+    survival_sum += static_cast<double>(tick) * stats.finished;
+
+    stats.best_seconds = static_cast<float>(best_ticks) / Simulation::tick_rate;
+    stats.mean_seconds = static_cast<float>(survival_sum / config.population / Simulation::tick_rate);
+}
+
+/**
+ * @brief Replaces the population by the next generation
+ *
+ * The elite are copied unchanged, so a good genome is never lost to
+ * an unlucky crossover or mutation. Every other child takes each parameter from one of
+ * two tournament-selected parents at random, then mutates it with
+ * probability mutation_rate.
+ */
+void Evolution::breed()
+{
+    const int params = BrainPool::params;
+    for (std::size_t i = 0; i < config.population; i++)
+        ranking[i] = static_cast<std::uint32_t>(i);
+    std::sort(ranking.begin(), ranking.end(),
+              [this](std::uint32_t a, std::uint32_t b) { return fitness[a] > fitness[b]; });
+
+    std::copy_n(&genomes[ranking[0] * params], params, best_genome.begin());
+
+    std::size_t elite = std::max<std::size_t>(1, static_cast<std::size_t>(config.population * config.elite_fraction));
+    for (std::size_t child = 0; child < config.population; child++)
+    {
+        float* genome = &offspring[child * params];
+        if (child < elite)
+        {
+            std::copy_n(&genomes[ranking[child] * params], params, genome);
+            continue;
+        }
+
+        const float* mother = &genomes[select() * params];
+        const float* father = &genomes[select() * params];
+        std::uint64_t picks = splitMix64Next(state);
+        for (int p = 0; p < params; p++)
+        {
+            genome[p] = (picks >> p) & 1 ? mother[p] : father[p];
+            if (uniform() < config.mutation_rate)
+                genome[p] += gaussian() * config.mutation_scale;
+        }
+    }
+    genomes.swap(offspring);
+}
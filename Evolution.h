@@ -0,0 +1,161 @@
+/**
+ * @file Evolution.h
+ * @brief Header file for the Evolution class in Flappy Bird 2-player game
+ *
+ * This file defines the neuroevolution trainer: a population of birds,
+ * each flown by its own small neural network, flies one shared pipe
+ * course per generation, and the networks of the longest survivors
+ * breed the next generation.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "BirdPool.h"
+#include "BrainPool.h"
+#include "CollisionWorld.h"
+#include "PipeStream.h"
+#include "Simulation.h"
+
+/**
+ * @struct EvolutionConfig
+ * @brief Population size, generation length and breeding parameters
+ */
+struct EvolutionConfig
+{
+    SimConfig sim;                        ///< Gameplay parameters of every course
+    std::size_t population = 4096;        ///< Birds per generation
+    float max_seconds = 60.f;             ///< Simulated seconds after which a generation is cut off
+    float elite_fraction = 0.02f;         ///< Share of the best genomes copied unchanged
+    int tournament = 8;                   ///< Genomes compared to pick each parent
+    float mutation_rate = 0.1f;           ///< Chance of each parameter being mutated
+    float mutation_scale = 0.3f;          ///< Standard deviation of a mutation
+};
+
+/**
+ * @struct GenerationStats
+ * @brief Results of one generation
+ */
+struct GenerationStats
+{
+    int generation = 0;                   ///< Generation number, from 0
+    float best_seconds = 0.f;             ///< Longest survival (simulated seconds)
+    float mean_seconds = 0.f;             ///< Mean survival (simulated seconds)
+    int best_score = 0;                   ///< Most pipes passed by one bird
+    std::size_t finished = 0;             ///< Birds still flying at the cut-off
+    std::uint64_t bird_ticks = 0;         ///< Bird updates simulated (for throughput)
+};
+
+/**
+ * @class Evolution
+ * @brief Evolves flap networks on a population of birds sharing a pipe course
+ *
+ * Every bird starts at Player 1's spot, so all birds face the same pipe
+ * at the same time: pipes are spawned, moved and turned into colliders
+ * once per tick for the whole population, as in Simulation. Each network
+ * reads the vertical distance from the bird to the centre of the next
+ * gap, the horizontal distance to that pipe and the bird's velocity.
+ *
+ * Birds that go out are removed from the BirdPool and BrainPool, so
+ * every pass runs over live birds only. A genome's fitness is the ticks
+ * its bird survived, with closeness to the gap at the moment it went out
+ * breaking ties. The next generation keeps the elite unchanged and
+ * breeds the rest by tournament selection, uniform crossover and
+ * Gaussian mutation. Generation g flies course seed + g, so networks
+ * learn to fly rather than to memorize one course.
+ *
+ * All memory is allocated in the constructor; generations allocate
+ * nothing.
+ */
+class Evolution
+{
+private:
+    EvolutionConfig config;                 ///< Population and breeding parameters
+    std::uint64_t base_seed;                ///< Course of generation 0
+    int generation;                         ///< Generation flown next
+    std::uint64_t state;                    ///< State of the breeding random generator
+
+    // Genomes, one row of BrainPool::params floats per bird
+    std::vector<float> genomes;             ///< Current generation
+    std::vector<float> offspring;           ///< Next generation, being bred
+    std::vector<float> best_genome;         ///< Best genome of the last generation flown
+    std::vector<float> fitness;             ///< Fitness per genome
+    std::vector<std::uint32_t> ranking;     ///< Genome indices, best first
+
+    // Flight state, indexed by live bird
+    BirdPool birds;                         ///< Birds still flying
+    BrainPool brains;                       ///< Network of each bird still flying
+    std::vector<std::uint32_t> owners;      ///< Genome of each bird still flying
+    std::vector<float> gap_offsets;         ///< Input: bird centre below gap centre (window heights)
+    std::vector<float> pipe_distances;      ///< Input: next pipe ahead (window widths)
+    std::vector<float> speeds;              ///< Input: velocity (600 pixels per second)
+    std::vector<std::uint8_t> flaps;        ///< Decision of each bird still flying
+    std::vector<std::int32_t> hits;         ///< Collision flag of each bird still flying
+
+    // Course
+    PipeStream pipe_stream;                 ///< Pipe heights of the current course
+    PipePool pipes;                         ///< Active pipes, oldest first
+    CollisionWorld colliders;               ///< Boxes of every pipe segment for this tick
+
+    /**
+     * @brief Draws a uniform random value
+     * @return Value in [0, 1)
+     */
+    float uniform();
+
+    /**
+     * @brief Draws an approximately normal random value
+     * @return Value with mean 0 and standard deviation 1
+     */
+    float gaussian();
+
+    /**
+     * @brief Picks a parent by tournament
+     * @return Genome index
+     */
+    std::uint32_t select();
+
+    /**
+     * @brief Flies every genome over one course and scores it
+     * @param course Pipe course seed
+     * @param stats Receives survival and score results
+     */
+    void fly(std::uint64_t course, GenerationStats& stats);
+
+    /**
+     * @brief Fills the network inputs of every live bird
+     */
+    void observe();
+
+    /**
+     * @brief Replaces the population by the next generation
+     */
+    void breed();
+
+public:
+    /**
+     * @brief Constructor - creates a random first generation
+     * @param evolution_config Population and breeding parameters
+     * @param seed Seed of the first course and of the random genomes
+     */
+    explicit Evolution(const EvolutionConfig& evolution_config = EvolutionConfig(), std::uint64_t seed = 1);
+
+    /**
+     * @brief Flies the current generation and breeds the next one
+     * @return Results of the generation flown
+     */
+    GenerationStats runGeneration();
+
+    /**
+     * @brief Gets the number of the next generation to fly
+     * @return Generations flown so far
+     */
+    int getGeneration() const { return generation; }
+
+    /**
+     * @brief Gets the best genome of the last generation flown
+     * @return BrainPool::params floats (all zero before the first generation)
+     */
+    const std::vector<float>& getBestGenome() const { return best_genome; }
+};
@@ -0,0 +1,109 @@
+/**
+ * @file Evolve.cpp
+ * @brief Command-line neuroevolution trainer
+ *
+ * Evolves flap networks for a population of birds with the Evolution
+ * class and prints the results of every generation.
+ *
+ * Command line options:
+ *   --population <n>      Birds per generation (default 4096)
+ *   --generations <n>     Generations to run (default 50)
+ *   --max-seconds <s>     Generation cut-off in simulated seconds (default 60)
+ *   --seed <n>            First pipe course and genome seed (default 1)
+ *   --mutation-rate <p>   Chance of mutating each parameter (default 0.1)
+ *   --mutation-scale <s>  Standard deviation of a mutation (default 0.3)
+ *   --elite <fraction>    Share of genomes copied unchanged (default 0.02)
+ *   --tournament <n>      Genomes compared to pick each parent (default 8)
+ *   --save <file>         Write the last generation's best genome, one value per line
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "Evolution.h"
+
+/**
+ * @brief Main function - trainer entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
+ * @return 0 on success, 1 on bad arguments or if the genome could not be saved
+ */
+int main(int argc, char* argv[])
+{
+    EvolutionConfig config;
+    int generations = 50;
+    std::uint64_t seed = 1;
+    std::string save_path;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--population") config.population = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--generations") generations = std::atoi(value.c_str());
+        else if (arg == "--max-seconds") config.max_seconds = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--seed") seed = std::strtoull(value.c_str(), nullptr, 10);
+        else if (arg == "--mutation-rate") config.mutation_rate = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--mutation-scale") config.mutation_scale = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--elite") config.elite_fraction = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--tournament") config.tournament = std::atoi(value.c_str());
+        else if (arg == "--save") save_path = value;
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+    if (config.population == 0)
+    {
+        std::cerr << "Population must not be empty" << std::endl;
+        return 1;
+    }
+
+    Evolution evolution(config, seed);
+
+    std::cout << "  gen | best s  mean s  score  finished |      ms  Mbird-ticks/s\n";
+    double total_ms = 0;
+    for (int g = 0; g < generations; g++)
+    {
+        auto started = std::chrono::steady_clock::now();
+        GenerationStats stats = evolution.runGeneration();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+        total_ms += ms;
+
+        std::cout << std::setw(5) << stats.generation << " |"
+                  << std::fixed << std::setprecision(1)
+                  << std::setw(7) << stats.best_seconds
+                  << std::setw(8) << stats.mean_seconds
+                  << std::setw(7) << stats.best_score
+                  << std::setw(10) << stats.finished << " |"
+                  << std::setw(8) << ms
+                  << std::setw(15) << stats.bird_ticks / ms / 1000.0 << "\n";
+    }
+    std::cout << generations << " generations of " << config.population << " birds in "
+              << std::setprecision(0) << total_ms << " ms\n";
+
+    if (!save_path.empty())
+    {
+        std::ofstream file(save_path);
+        file << std::setprecision(9);   // Enough digits to read back every float exactly
+        for (float weight : evolution.getBestGenome())
+            file << weight << "\n";
+        if (!file)
+        {
+            std::cerr << "Could not write " << save_path << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file FlappyEnv.cpp
+ * @brief C interface to the VectorEnv reinforcement-learning environment
+ *
+ * Thin wrappers only: the C handle is the VectorEnv itself, and no
+ * exception is allowed to cross into C.
+ */
+
+#include "FlappyEnv.h"
+#include <limits>
+#include "VectorEnv.h"
+
+/// The opaque C handle is the C++ environment
+struct flappy_env : VectorEnv
+{
+    using VectorEnv::VectorEnv;
+};
+
+/**
+ * @brief Creates a batch of matches with the shipped gameplay parameters
+ * @param count Number of matches (at least 1)
+ * @param seed Pipe course of the first episode
+ * @param self_play Non-zero for two agents per match, zero to have the rule bot fly Player 2
+ * @return New environment, or NULL if count is 0 or too large or it could not be created
+ */
+flappy_env* flappy_env_create(size_t count, uint64_t seed, int self_play)
+{
+    EnvConfig config;
+    config.self_play = self_play != 0;
+    std::size_t agents_per_env = config.self_play ? 2 : 1;
+    if (count == 0 || count > std::numeric_limits<std::size_t>::max() / agents_per_env)
+        return nullptr;
+    try
+    {
+        return new flappy_env(count, seed, config);
+    }
+    catch (...)
+    {
+        return nullptr;   // bad_alloc, or length_error from a count no vector can hold
+    }
+}
+
+/**
+ * @brief Destroys an environment
+ * @param env Environment from flappy_env_create() (NULL is ignored)
+ */
+void flappy_env_destroy(flappy_env* env)
+{
+    delete env;
+}
+
+/**
+ * @brief Gets the number of agents
+ * @param env Environment
+ * @return Length of the action, reward and done buffers
+ */
+size_t flappy_env_num_agents(const flappy_env* env)
+{
+    return env->getAgentCount();
+}
+
+/**
+ * @brief Gets the number of floats in one agent's observation
+ * @return Observation size
+ */
+int flappy_env_obs_size(void)
+{
+    return VectorEnv::obs_size;
+}
+
+/**
+ * @brief Sets the caller-owned buffers results are written to
+ * @param env Environment
+ * @param obs num_agents x obs_size floats
+ * @param rewards num_agents floats
+ * @param dones num_agents bytes
+ */
+void flappy_env_set_buffers(flappy_env* env, float* obs, float* rewards, uint8_t* dones)
+{
+    env->setBuffers(obs, rewards, dones);
+}
+
+/**
+ * @brief Starts a new episode in every match and writes the first observations
+ * @param env Environment (buffers must be set)
+ */
+void flappy_env_reset(flappy_env* env)
+{
+    env->reset();
+}
+
+/**
+ * @brief Advances every match by one tick
+ * @param env Environment (buffers must be set)
+ * @param actions num_agents bytes, non-zero to flap
+ */
+void flappy_env_step_batch(flappy_env* env, const uint8_t* actions)
+{
+    env->stepBatch(actions);
+}
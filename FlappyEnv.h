@@ -0,0 +1,87 @@
+/**
+ * @file FlappyEnv.h
+ * @brief C interface to the VectorEnv reinforcement-learning environment
+ *
+ * This header is plain C, so the environment can be loaded from Python
+ * (ctypes, cffi), Julia or any other language with a C FFI. Every call
+ * maps directly onto a VectorEnv method; see VectorEnv.h for the
+ * observation layout, rewards and episode rules.
+ *
+ * Typical use:
+ *   flappy_env* env = flappy_env_create(1024, 1, 0);
+ *   flappy_env_set_buffers(env, obs, rewards, dones);   // caller-owned
+ *   flappy_env_reset(env);
+ *   for (;;) { pick actions from obs; flappy_env_step_batch(env, actions); }
+ *   flappy_env_destroy(env);
+ */
+
+#pragma once
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#define FLAPPY_ENV_API __declspec(dllexport)
+#else
+#define FLAPPY_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Opaque handle to a batch of matches
+typedef struct flappy_env flappy_env;
+
+/**
+ * @brief Creates a batch of matches with the shipped gameplay parameters
+ * @param count Number of matches (at least 1)
+ * @param seed Pipe course of the first episode
+ * @param self_play Non-zero for two agents per match, zero to have the rule bot fly Player 2
+ * @return New environment, or NULL if count is 0 or too large or it could not be created
+ */
+FLAPPY_ENV_API flappy_env* flappy_env_create(size_t count, uint64_t seed, int self_play);
+
+/**
+ * @brief Destroys an environment
+ * @param env Environment from flappy_env_create() (NULL is ignored)
+ */
+FLAPPY_ENV_API void flappy_env_destroy(flappy_env* env);
+
+/**
+ * @brief Gets the number of agents
+ * @param env Environment
+ * @return Length of the action, reward and done buffers
+ */
+FLAPPY_ENV_API size_t flappy_env_num_agents(const flappy_env* env);
+
+/**
+ * @brief Gets the number of floats in one agent's observation
+ * @return Observation size
+ */
+FLAPPY_ENV_API int flappy_env_obs_size(void);
+
+/**
+ * @brief Sets the caller-owned buffers results are written to
+ * @param env Environment
+ * @param obs num_agents x obs_size floats
+ * @param rewards num_agents floats
+ * @param dones num_agents bytes
+ */
+FLAPPY_ENV_API void flappy_env_set_buffers(flappy_env* env, float* obs, float* rewards, uint8_t* dones);
+
+/**
+ * @brief Starts a new episode in every match and writes the first observations
+ * @param env Environment (buffers must be set)
+ */
+FLAPPY_ENV_API void flappy_env_reset(flappy_env* env);
+
+/**
+ * @brief Advances every match by one tick
+ * @param env Environment (buffers must be set)
+ * @param actions num_agents bytes, non-zero to flap
+ */
+FLAPPY_ENV_API void flappy_env_step_batch(flappy_env* env, const uint8_t* actions);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,15 +2,19 @@
  * @file Game.cpp
  * @brief Implementation of the main Game class for Flappy Bird 2-player game
  * 
- * This file contains the core game logic, rendering, collision detection,
- * and event handling for a two-player Flappy Bird game built with SFML.
+ * This file contains menu handling, event handling and rendering for a
+ * two-player Flappy Bird game built with SFML. Gameplay rules are run
+ * by the headless Simulation.
  */
 
 #include "Game.h"
+#include "AllocationTracker.h"
 #include "Globals.h"
+#include "ResourceCache.h"
 #include <iostream>  // Fixed: was <stream>
 #include <SFML/Audio.hpp>  // Fixed: was <SFMI/Audio.hpp>
-#include <sstream>  // Added for toString method
+#include <algorithm>
+#include <cassert>
 
 using namespace sf;
 
@@ -22,226 +26,398 @@ using namespace sf;
  * and sets up the initial game state for both players.
  */
 Game::Game(RenderWindow& window) : win(window),
-enter_pressed(false),
-run_game1(true),
-run_game2(true),
-start_monitoring(false),
-bird1Collided(false),  // Fixed: was birdICollided
-bird2Collided(false),
+record_hashes(false),
+replaying(false),
+fast_forward(false),
+bird1(atlas, 0),
+bird2(atlas, 1),
+pipe(atlas),
 showMainMenu(true),
 showControls(false),
-pipe_counter(71),
-pipe_spawn_time(70),
-score_p1(0),
-score_p2(0)
+shown_score_p1(0),
+shown_score_p2(0),
+alpha(0.f),
+show_profiler(false)
 {
     win.setFramerateLimit(60); // Setting frames per seconds
 
     // Setting Main menu screen
-    menu_texture.loadFromFile("assets/mainmenu.png");
-    menu_sprite.setTexture(menu_texture);
+    menu_texture = Resources::texture("assets/mainmenu.png");
+    menu_sprite.setTexture(*menu_texture);
     menu_sprite.setScale(3.3, 2.8);
     menu_sprite.setPosition(0.f, 0.f);
     
     // Setting Show Controls screen
-    controls_texture.loadFromFile("assets/controls.png");
-    controls_sprite.setTexture(controls_texture);
+    controls_texture = Resources::texture("assets/controls.png");
+    controls_sprite.setTexture(*controls_texture);
     controls_sprite.setScale(1.5, 1.1);
     controls_sprite.setPosition(0.f, 0.f);
     
     // Background Setup
-    background.loadFromFile("assets/bg.png");
-    background_sprite.setTexture(background);
+    background = Resources::texture("assets/bg.png");
+    background_sprite.setTexture(*background);
     background_sprite.setScale(2.3, 2);
     background_sprite.setPosition(0.f, -250.f);
     
-    // Loading and setting ground
-    ground_texture.loadFromFile("assets/ground.png");
-    ground_sprite1.setTexture(ground_texture);
-    ground_sprite2.setTexture(ground_texture);
+    // Packing gameplay images (birds and pipes registered themselves) into the atlas
+    ground_region = atlas.add("assets/ground.png");
+    atlas.build();
+    world.setTexture(atlas.getTexture());
+    world.reserve(2 * PipePool::capacity() + 2 + 2);  // Pipe pairs, ground tiles, birds
     
-    // Scaling ground
-    ground_sprite1.setScale(scaling_factor, scaling_factor);
-    ground_sprite2.setScale(scaling_factor, scaling_factor);
-    
-    // Setting ground position
-    ground_sprite1.setPosition(0, 578);
-    ground_sprite2.setPosition(ground_sprite1.getGlobalBounds().width, 578);  // Fixed: was getGlobalBounds(),width
+    // Collision masks of the sprites, so transparent corners never count as hits
+    masks_loaded = masks.load();
+    sim.setMasks(masks_loaded ? &masks : nullptr);
     
     // Loading normal and game font to use
-    normalfont.loadFromFile("assets/mono.ttf");
-    gamefont.loadFromFile("assets/gamefont.ttf");
-    
-    // Restart game text setting
-    playagain_text.setFont(gamefont);
-    playagain_text.setCharacterSize(65);
-    playagain_text.setFillColor(Color::Black);
-    playagain_text.setPosition(40, 650);
-    playagain_text.setString("Press R to Restart Game");
-    
-    // Player 1 Score text setting
-    player1_score_text.setFont(normalfont);
-    player1_score_text.setCharacterSize(25);
-    player1_score_text.setFillColor(Color::Magenta);
-    player1_score_text.setPosition(15, 15);
-    player1_score_text.setString("Player 1: 0");
-    
-    // Player 2 Score setting
-    player2_score_text.setFont(normalfont);
-    player2_score_text.setCharacterSize(25);
-    player2_score_text.setFillColor(Color(139, 69, 19));
-    player2_score_text.setPosition(410, 15);
-    player2_score_text.setString("Player 2: 0");
-
-    // Player1 Wins text setting
-    p1_win_text.setFont(gamefont);
-    p1_win_text.setCharacterSize(80);
-    p1_win_text.setFillColor(Color::Magenta);
-    p1_win_text.setPosition(130, 450);
-    p1_win_text.setString("Player 1 Wins");
-    
-    // Player2 Wins text setting
-    p2_win_text.setFont(gamefont);
-    p2_win_text.setCharacterSize(80);
-    p2_win_text.setFillColor(Color(139, 69, 19));
-    p2_win_text.setPosition(130, 450);
-    p2_win_text.setString("Player 2 Wins");
-    
-    // Game Draw text setting
-    Draw_text.setFont(gamefont);
-    Draw_text.setCharacterSize(80);
-    Draw_text.setFillColor(Color::White);
-    Draw_text.setPosition(130, 450);
-    Draw_text.setString("Game Draw");
+    normalfont = Resources::font("assets/mono.ttf");
+    gamefont = Resources::font("assets/gamefont.ttf");
+    profile_overlay.setFont(*normalfont);
     
+    // Rasterize every character the HUD shows once, into one glyph atlas
+    int score_face = hud_glyphs.addFace(*normalfont, 25, "Player 12:0123456789");
+    int restart_face = hud_glyphs.addFace(*gamefont, 65, "Press R to Restart Game");
+    int result_face = hud_glyphs.addFace(*gamefont, 80, "Player 12 Wins Game Draw");
+    hud_glyphs.build();
+
+    // Score texts keep ten digit slots, enough for any int
+    player1_score_text.create(hud_glyphs, score_face, "Player 1: ", Vector2f(15, 15), Color::Magenta, 10);
+    player2_score_text.create(hud_glyphs, score_face, "Player 2: ", Vector2f(410, 15), Color(139, 69, 19), 10);
+
+    // Restart, victory and draw texts
+    playagain_text.create(hud_glyphs, restart_face, "Press R to Restart Game", Vector2f(40, 650), Color::Black);
+    p1_win_text.create(hud_glyphs, result_face, "Player 1 Wins", Vector2f(130, 450), Color::Magenta);
+    p2_win_text.create(hud_glyphs, result_face, "Player 2 Wins", Vector2f(130, 450), Color(139, 69, 19));
+    Draw_text.create(hud_glyphs, result_face, "Game Draw", Vector2f(130, 450), Color::White);
+
     // Game over image setting
-    go_texture.loadFromFile("assets/gameover.png");
-    go_sprite.setTexture(go_texture);
+    go_texture = Resources::texture("assets/gameover.png");
+    go_sprite.setTexture(*go_texture);
     go_sprite.setScale(scaling_factor, scaling_factor);
     go_sprite.setPosition(160, 250);
     
     // Bird 1 win pic
-    bird1_win_texture.loadFromFile("assets/bird1_win.png");
-    bird1_win_sprite.setTexture(bird1_win_texture);
+    bird1_win_texture = Resources::texture("assets/bird1_win.png");
+    bird1_win_sprite.setTexture(*bird1_win_texture);
     bird1_win_sprite.setScale(2.0f, 2.0f);
     bird1_win_sprite.setPosition(250.f, 400.f);
     
     // Bird 2 win pic
-    bird2_win_texture.loadFromFile("assets/bird2_win.png");
-    bird2_win_sprite.setTexture(bird2_win_texture);
+    bird2_win_texture = Resources::texture("assets/bird2_win.png");
+    bird2_win_sprite.setTexture(*bird2_win_texture);
     bird2_win_sprite.setScale(2.0f, 2.0f);
     bird2_win_sprite.setPosition(250.f, 400.f);
-
-    Pipe::loadTextures();
-}
-
-/**
- * @brief Processes game logic during active gameplay
- * @param dt Delta time for frame-independent movement
- * 
- * Handles ground movement, pipe spawning, collision detection,
- * and score tracking when the game is active.
- */
-void Game::doProcessing(Time& dt)
-{
-    if (enter_pressed)
-    {
-        moveGround(dt);
-        
-        // Spawn new pipes at regular intervals
-        if (pipe_counter > pipe_spawn_time)
-        {
-            pipes.push_back(Pipe(dist(rd)));
-            pipe_counter = 0;
-        }
-        pipe_counter++;
-        
-        // Update existing pipes and remove off-screen ones
-        for (size_t i = 0; i < pipes.size(); i++)  // Fixed: use size_t to avoid signed/unsigned comparison warning
-        {
-            pipes[i].update(dt);
-            if (pipes[i].getRightBound() < 0)
-            {
-                pipes.erase(pipes.begin() + i);
-                i--; // Decrement i since we removed an element
-            }
-        }
-        
-        checkCollisions1();
-        checkCollisions2();
-        checkScore();
-    }
-
-    // Update both birds
-    bird1.update1(dt);
-    bird2.update2(dt);
 }
 
 /**
  * @brief Main game loop that handles events, updates, and rendering
  * 
- * Displays the main menu, then enters the main game loop where it
- * processes events, updates game state, and renders everything to screen.
+ * Displays the main menu, then starts the simulation thread and runs the
+ * render loop on this thread: it polls window events, takes the newest
+ * simulation snapshot and draws it. A slow present or vsync stall here
+ * only delays drawing; the simulation keeps ticking on its own thread.
+ * 
+ * Snapshots carry the time their tick was due, so the time since then
+ * becomes the interpolation factor used when drawing.
+ * 
+ * When replaying, the menus are skipped and inputs come from the replay
+ * file; in fast-forward mode the simulation thread does not wait between
+ * ticks and each frame shows the newest tick. Online matches skip the
+ * menus too and start on the pipe course the host picked.
  */
 void Game::startGameLoop()
 {
     Clock clock;
+    SimTimes shown_times;
+    
+    // Timers on this thread report to our profiler
+    Profiler::setCurrent(&profiler);
 
-    // Display the main menu screen
-    showMainMenuScreen();
+    if (replaying)
+    {
+        sim.reset(playback.getSeed());
+    }
+    else if (net)
+    {
+        net->start(sim);
+        input_thread.start();
+    }
+    else
+    {
+        // Display the main menu screen
+        showMainMenuScreen();
+        input_thread.start();
+    }
+    
+    sim.getSnapshot(snapshots.back().state);
+    snapshots.back().tick_time = std::chrono::steady_clock::now();
+    snapshots.publish();
+    for (int player = 0; player < 2; player++)
+    {
+        heard_flaps[player] = sim.getFlapCount(player);
+        heard_scores[player] = 0;
+        heard_deaths[player] = false;
+    }
+    audio.setMuted(fast_forward);  // Sounds would pile up in a fast replay
+    sim_running.store(true);
+    sim_thread = std::thread(&Game::runSimulation, this);
     
     // Game Loop
     while (win.isOpen())
     {
-        Time dt = clock.restart();
+        clock.restart();
         Event event;
         
         // Event Loop
-        while (win.pollEvent(event))
         {
-            if (event.type == Event::Closed)
+            ProfileScope scope(ProfilePhase::Events);
+            while (win.pollEvent(event))
             {
-                win.close();
-            }
-            
-            if (event.type == Event::KeyPressed && (run_game1 || run_game2))
-            {
-                if (event.key.code == Keyboard::Enter && !enter_pressed)  // Fixed: was lenter_pressed
-                {
-                    enter_pressed = true;
-                    bird1.birdshouldfly(true);  // Fixed: was bindshouldfly
-                    bird2.birdshouldfly(true);  // Fixed: was bindshouldfly
-                }
-                if (event.key.code == Keyboard::Space && enter_pressed)
+                if (event.type == Event::Closed)
                 {
-                    bird1.birdflap(dt);  // Fixed: was bindflap
+                    win.close();
                 }
-                if (event.key.code == Keyboard::Up && enter_pressed)
+                
+                if (event.type == Event::KeyPressed && event.key.code == Keyboard::F3)
                 {
-                    bird2.birdflap(dt);  // Fixed: was bindflap
+                    show_profiler = !show_profiler;
                 }
+                
+                // Game keys are read by the input thread, which only needs focus changes
+                if (event.type == Event::LostFocus)
+                    input_thread.setFocused(false);
+                if (event.type == Event::GainedFocus)
+                    input_thread.setFocused(true);
             }
+        }
+        
+        // Take the newest tick and interpolate from its due time
+        snapshots.update();
+        const SimFrame& frame = snapshots.front();
+        std::chrono::duration<float> since_tick = std::chrono::steady_clock::now() - frame.tick_time;
+        alpha = std::max(0.f, std::min(1.f, since_tick.count() / Simulation::tick_dt));
+        if (fast_forward || frame.finished)
+            alpha = 1.f;
+        
+        // Charge the simulation thread's work since the last frame to this frame
+        profiler.add(ProfilePhase::Update, frame.times.update - shown_times.update);
+        profiler.add(ProfilePhase::Collision, frame.times.collision - shown_times.collision);
+        profiler.add(ProfilePhase::Score, frame.times.score - shown_times.score);
+        shown_times = frame.times;
+        
+        playSounds(frame.state);
+
+        {
+            ProfileScope scope(ProfilePhase::Draw);
+            updateScoreText(frame.state);
+            draw(frame.state);
             
-            // Restart game logic
-            if (event.type == Event::KeyPressed && (!run_game1 || !run_game2))  // Fixed: was (|run_game1 || |run_game2)
+            // Refresh the overlay twice a second; percentiles are not free
+            if (show_profiler)
             {
-                if (event.key.code == Keyboard::R && (!run_game1 || !run_game2))  // Fixed: was (|run_game1 ||!run_game2)
-                {
-                    restartGame();
-                }
+                if (profiler.getTotalFrames() % 30 == 0)
+                    profile_overlay.refresh(profiler);
+                win.draw(profile_overlay);
             }
         }
-        
-        if (enter_pressed)
+
+        // Display the window
         {
-            doProcessing(dt);
+            ProfileScope scope(ProfilePhase::Display);
+            win.display();
         }
         
-        draw();
+        profiler.endFrame(std::chrono::microseconds(clock.getElapsedTime().asMicroseconds()));
+        checkFrameAllocations(profiler, "Frame");
+    }
 
-        // Display the window
-        win.display();
+    sim_running.store(false);
+    sim_thread.join();
+    input_thread.stop();
+    recorder.close(sim.getTick());
+    Profiler::setCurrent(nullptr);
+    if (!profile_path.empty() && !profiler.writeCsv(profile_path))
+        std::cerr << "Could not write profile to " << profile_path << std::endl;
+}
+
+/**
+ * @brief Simulation thread: steps fixed ticks on schedule and publishes snapshots
+ * 
+ * Each tick is due tick_dt after the previous one and takes the key
+ * presses made before it was due. After a long stall (more than a
+ * quarter second behind) the schedule restarts from now instead of
+ * catching up in a burst. While this thread runs it is the only user of
+ * sim, recorder, playback and net.
+ *
+ * Online, each tick's keys go to the NetPeer instead, which steps sim
+ * (rolling back and resimulating as remote inputs arrive) or holds it
+ * while the other player is too far behind.
+ */
+void Game::runSimulation()
+{
+    typedef std::chrono::steady_clock steady_clock;
+    const steady_clock::duration tick_length = std::chrono::duration_cast<steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / Simulation::tick_rate));
+
+    // Collision and score timers on this thread report here. Each tick is
+    // one profiler frame, so the tick's allocations can be checked; the
+    // running totals of the timers are published with each snapshot
+    Profiler sim_profiler;
+    Profiler::setCurrent(&sim_profiler);
+
+    SimInput input;
+    std::chrono::nanoseconds update_time(0);
+    std::chrono::nanoseconds collision_time(0);
+    std::chrono::nanoseconds score_time(0);
+    steady_clock::time_point next_tick = steady_clock::now() + tick_length;
+
+    while (sim_running.load(std::memory_order_relaxed))
+    {
+        steady_clock::time_point now = steady_clock::now();
+        if (fast_forward && !playback.isFinished(sim.getTick()))
+            next_tick = now;  // Fast replay: no waiting between ticks
+        else if (now - next_tick > std::chrono::milliseconds(250))
+            next_tick = now;
+        else if (next_tick > now)
+            sleep(microseconds(std::chrono::duration_cast<std::chrono::microseconds>(next_tick - now).count()));
+
+        steady_clock::time_point started = steady_clock::now();
+        if (!replaying)
+        {
+            input_thread.collect(next_tick, input);
+            if (bot)
+                input.flap[bot->getPlayer()] = bot->shouldFlap(sim);
+        }
+        if (net)
+        {
+            net->update(input);
+            input = SimInput();
+        }
+        else
+        {
+            stepSimulation(input);
+        }
+        update_time += steady_clock::now() - started;
+        collision_time += sim_profiler.getPending(ProfilePhase::Collision);
+        score_time += sim_profiler.getPending(ProfilePhase::Score);
+
+        SimFrame& frame = snapshots.back();
+        sim.getSnapshot(frame.state);
+        frame.tick_time = next_tick;
+        frame.finished = replaying && playback.isFinished(sim.getTick());
+        frame.times.update = update_time;
+        frame.times.collision = collision_time;
+        frame.times.score = score_time;
+        snapshots.publish();
+
+        sim_profiler.endFrame(steady_clock::now() - started);
+        checkFrameAllocations(sim_profiler, "Tick");
+
+        next_tick += tick_length;
     }
+
+    Profiler::setCurrent(nullptr);
+}
+
+/**
+ * @brief Advances the simulation one tick, recording or replaying inputs
+ * @param input Keyboard inputs for this tick; cleared once applied
+ * 
+ * Inputs only apply to the first tick after they were pressed. While
+ * replaying, keyboard input is replaced by the recorded input for the
+ * tick, and nothing is stepped past the end of the recording.
+ */
+void Game::stepSimulation(SimInput& input)
+{
+    if (replaying)
+    {
+        if (playback.isFinished(sim.getTick()))
+            return;
+        input = playback.read(sim.getTick());
+    }
+    else
+    {
+        recorder.record(sim.getTick(), input);
+    }
+
+    sim.step(input);
+    if (record_hashes && !replaying)
+    {
+        StateHash hash;
+        sim.hashState(hash);
+        recorder.recordHash(sim.getTick() - 1, hash);
+    }
+    input = SimInput();
+}
+
+/**
+ * @brief Records every match started from the menu
+ * @param path Replay file to write (overwritten by each new match)
+ * @param hashes True to also record each tick's state digest, for desync checks
+ */
+void Game::recordTo(const std::string& path, bool hashes)
+{
+    record_path = path;
+    record_hashes = hashes;
+}
+
+/**
+ * @brief Lets the computer fly one bird instead of a player
+ * @param player Bird to hand over (0 or 1)
+ * 
+ * The bot decides on the simulation thread right before each tick, and
+ * its flaps replace that bird's key. They are recorded like key presses,
+ * so replays of bot matches play back without the bot.
+ */
+void Game::setBot(int player)
+{
+    bot = std::make_unique<LookaheadBot>(player, rd());
+}
+
+/**
+ * @brief Plays an online match against a connected peer instead of sharing the keyboard
+ * @param peer Peer whose handshake has completed
+ * 
+ * Either flap key flaps this player's own bird; Enter and R work for
+ * both players. Collisions follow what the peers agreed on, and online
+ * matches are not recorded.
+ */
+void Game::playOnline(std::unique_ptr<NetPeer> peer)
+{
+    net = std::move(peer);
+    if (net->usesPixelCollision() && !masks_loaded)
+        std::cerr << "Online match needs collision masks that could not be loaded; it will desync" << std::endl;
+    sim.setMasks(net->usesPixelCollision() && masks_loaded ? &masks : nullptr);
+    record_path.clear();
+}
+
+/**
+ * @brief Writes the frame profiler's history to a CSV file on exit
+ * @param path CSV file to write
+ */
+void Game::profileTo(const std::string& path)
+{
+    profile_path = path;
+}
+
+/**
+ * @brief Plays back a recorded match instead of reading the keyboard
+ * @param path Replay file to read
+ * @param fast True to replay as fast as possible, false for real time
+ * @return True if the replay file could be loaded
+ */
+bool Game::loadReplay(const std::string& path, bool fast)
+{
+    replaying = playback.open(path);
+    fast_forward = fast;
+    
+    // Older replays were played with bounding-box collisions
+    if ((playback.getFlags() & replay_pixel_collision) && !masks_loaded)
+        std::cerr << "Replay needs collision masks that could not be loaded; it may play out differently" << std::endl;
+    sim.setMasks((playback.getFlags() & replay_pixel_collision) && masks_loaded ? &masks : nullptr);
+    if (replaying && fast_forward)
+        win.setFramerateLimit(0);
+    return replaying;
 }
 
 /**
@@ -310,91 +486,45 @@ void Game::showGameScreen()
 }
 
 /**
- * @brief Checks collision detection for Player 1's bird
+ * @brief Plays sounds for flaps, points and deaths since the last frame
+ * @param state Newest snapshot
  * 
- * Detects collisions with pipes and ground boundaries.
- * Sets bird1Collided flag and stops player 1's game on collision.
+ * The snapshot only holds running counts and flags, so events of ticks
+ * the renderer skipped are still heard. Counts that went down mean the
+ * match restarted, which makes no sound.
  */
-void Game::checkCollisions1()
+void Game::playSounds(const SimSnapshot& state)
 {
-    if (pipes.size() > 0)
+    for (int player = 0; player < 2; player++)
     {
-        if (pipes[0].sprite_down.getGlobalBounds().intersects(bird1.bird1_sprite.getGlobalBounds()) ||
-            pipes[0].sprite_up.getGlobalBounds().intersects(bird1.bird1_sprite.getGlobalBounds()) ||
-            bird1.bird1_sprite.getGlobalBounds().top >= 540)
-        {
-            enter_pressed = false;
-            run_game1 = false;
-            bird1Collided = true;
-        }
+        if (state.flaps[player] > heard_flaps[player])
+            audio.play(SoundEffect::Flap);
+        heard_flaps[player] = state.flaps[player];
+        if (state.scores[player] > heard_scores[player])
+            audio.play(SoundEffect::Score);
+        heard_scores[player] = state.scores[player];
+        if (state.birds[player].collided && !heard_deaths[player])
+            audio.play(SoundEffect::Death);
+        heard_deaths[player] = state.birds[player].collided;
     }
 }
 
 /**
- * @brief Checks collision detection for Player 2's bird
+ * @brief Refreshes score texts when the simulation's scores change
  * 
- * Detects collisions with pipes and ground boundaries.
- * Sets bird2Collided flag and stops player 2's game on collision.
+ * Only the digit quads are rewritten, and only when a score actually changes.
  */
-void Game::checkCollisions2()
+void Game::updateScoreText(const SimSnapshot& state)
 {
-    if (pipes.size() > 0)
+    if (state.scores[0] != shown_score_p1)
     {
-        if (pipes[0].sprite_down.getGlobalBounds().intersects(bird2.bird2_sprite.getGlobalBounds()) ||
-            pipes[0].sprite_up.getGlobalBounds().intersects(bird2.bird2_sprite.getGlobalBounds()) ||
-            bird2.bird2_sprite.getGlobalBounds().top >= 540)
-        {
-            enter_pressed = false;
-            run_game2 = false;
-            bird2Collided = true;
-        }
+        shown_score_p1 = state.scores[0];
+        player1_score_text.setNumber(shown_score_p1);
     }
-}
-
-/**
- * @brief Tracks and updates player scores when passing through pipes
- * 
- * Uses a monitoring system to detect when birds pass through pipe gaps
- * and increments the appropriate player's score.
- */
-void Game::checkScore()
-{
-    if (pipes.size() > 0)
+    if (state.scores[1] != shown_score_p2)
     {
-        if (!start_monitoring)
-        {
-            // Start monitoring when birds enter the pipe gap
-            if (bird1.bird1_sprite.getGlobalBounds().left >
-                pipes[0].sprite_down.getGlobalBounds().left &&
-                bird1.getRightBound() < pipes[0].getRightBound())
-            {
-                start_monitoring = true;
-            }
-            if (bird2.bird2_sprite.getGlobalBounds().left >
-                pipes[0].sprite_down.getGlobalBounds().left &&
-                bird2.getRightBound() < pipes[0].getRightBound())
-            {
-                start_monitoring = true;
-            }
-        }
-        else
-        {
-            // Award points when birds exit the pipe gap
-            if (bird1.bird1_sprite.getGlobalBounds().left >
-                pipes[0].getRightBound())
-            {
-                score_p1++;
-                player1_score_text.setString("Player 1: " + toString(score_p1));
-                start_monitoring = false;
-            }
-            if (bird2.bird2_sprite.getGlobalBounds().left >
-                pipes[0].getRightBound())
-            {
-                score_p2++;
-                player2_score_text.setString("Player 2: " + toString(score_p2));
-                start_monitoring = false;
-            }
-        }
+        shown_score_p2 = state.scores[1];
+        player2_score_text.setNumber(shown_score_p2);
     }
 }
 
@@ -404,35 +534,36 @@ void Game::checkScore()
  * Draws background, pipes, ground, birds (based on game state),
  * score text, and game over/victory screens as appropriate.
  */
-void Game::draw()
+void Game::draw(const SimSnapshot& state)
 {
+    bool run_game1 = state.birds[0].active;
+    bool run_game2 = state.birds[1].active;
+
     win.clear();
     win.draw(background_sprite);
     
-    // Draw all pipes
-    for (Pipe& pipe : pipes)
+    // Batch all pipes, the ground and the live birds into one draw call
+    world.clear();
+    for (const PipeState& pipe_state : state.pipes)
     {
-        win.draw(pipe.sprite_down);
-        win.draw(pipe.sprite_up);
+        pipe.draw(world, pipe_state, alpha);
     }
     
-    win.draw(ground_sprite1);
-    win.draw(ground_sprite2);
+    drawGround(state);
 
-    // Draw birds based on game state
-    if (run_game1 && run_game2) // Both birds are still alive - draw both
-    {
-        win.draw(bird1.bird1_sprite);
-        win.draw(bird2.bird2_sprite);
-    }
-    else if (run_game1 && !run_game2) // Bird2 collided, bird1 is still alive
+    if (run_game1)
+        bird1.draw(world, state.birds[0], alpha);
+    if (run_game2)
+        bird2.draw(world, state.birds[1], alpha);
+    win.draw(world);
+
+    // Show the surviving player's victory picture
+    if (run_game1 && !run_game2) // Bird2 collided, bird1 is still alive
     {
-        win.draw(bird1.bird1_sprite);
         win.draw(bird2_win_sprite); // Show Player 1 victory message
     }
     else if (!run_game1 && run_game2) // Bird1 collided, bird2 is still alive  
     {
-        win.draw(bird2.bird2_sprite);
         win.draw(bird1_win_sprite); // Show Player 2 victory message
     }
 
@@ -462,64 +593,56 @@ void Game::draw()
 }
 
 /**
- * @brief Moves the ground sprites to create scrolling effect
- * @param dt Delta time for frame-independent movement
+ * @brief Adds the scrolling ground tiles to the world batch
  * 
- * Moves both ground sprites leftward and repositions them
- * when they move off-screen to create continuous scrolling.
+ * Places the two ground tiles side by side, shifted left by the
+ * simulation's scroll offset, so they wrap around continuously.
  */
-void Game::moveGround(Time& dt)
+void Game::drawGround(const SimSnapshot& state)
 {
-    ground_sprite1.move(-move_speed * dt.asSeconds(), 0.f);
-    ground_sprite2.move(-move_speed * dt.asSeconds(), 0.f);
-
-    if (ground_sprite1.getGlobalBounds().left + ground_sprite1.getGlobalBounds().width < 0)
-    {
-        ground_sprite1.setPosition(ground_sprite2.getGlobalBounds().left +
-                                   ground_sprite2.getGlobalBounds().width, 578);
-    }
-    if (ground_sprite2.getGlobalBounds().left + ground_sprite2.getGlobalBounds().width < 0)
-    {
-        ground_sprite2.setPosition(ground_sprite1.getGlobalBounds().left +
-                                   ground_sprite1.getGlobalBounds().width, 578);
-    }
+    float offset = state.getGroundOffset(alpha);
+    const IntRect& rect = atlas.getRect(ground_region);
+    float height = rect.height * scaling_factor;
+    world.add(FloatRect(-offset, ground_top, ground_width, height), rect);
+    world.add(FloatRect(ground_width - offset, ground_top, ground_width, height), rect);
 }
 
 /**
  * @brief Resets the game state for a new game
  * 
- * Resets bird positions, collision flags, scores, and pipe state
- * to start a fresh game session.
+ * Starts a fresh simulation match on a newly seeded pipe course,
+ * and starts recording it if recording is enabled.
  */
 void Game::restartGame()
 {
-    bird1.bird1_resetPosition();
-    bird2.bird2_resetPosition();
-    bird1.birdshouldfly(false);
-    bird2.birdshouldfly(false);
-
-    bird1Collided = false;
-    bird2Collided = false;
-    run_game1 = true;
-    run_game2 = true;
-    enter_pressed = false;
-
-    pipe_counter = 71;
-    pipes.clear();
-    score_p1 = 0;
-    score_p2 = 0;
-    player1_score_text.setString("Player 1: 0");
-    player2_score_text.setString("Player 2: 0");
+    std::uint64_t seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+    sim.reset(seed);
+
+    std::uint8_t flags = (sim.hasMasks() ? replay_pixel_collision : 0) | (record_hashes ? replay_state_hashes : 0);
+    if (!record_path.empty() && !recorder.open(record_path, seed, flags))
+        std::cerr << "Could not write replay file " << record_path << std::endl;
 }
 
 /**
- * @brief Converts an integer to string for display purposes
- * @param num Integer to convert
- * @return String representation of the integer
+ * @brief Asserts that a steady-state frame made no heap allocations
+ * @param frames Profiler of the calling thread, with the frame just closed
+ * @param label "Frame" for the render loop, "Tick" for the simulation thread
+ * 
+ * Only active in builds compiled with FLAPPY_TRACK_ALLOCATIONS. The first
+ * warmup_frames frames are exempt, since caches and buffers fill up then.
+ * Allocations are counted per thread, so each thread checks its own
+ * profiler.
  */
-std::string Game::toString(int num)
+void Game::checkFrameAllocations(const Profiler& frames, const char* label)
 {
-    std::stringstream ss;
-    ss << num;
-    return ss.str();
-}
\ No newline at end of file
+    if (!AllocationTracker::isEnabled() || frames.getTotalFrames() <= warmup_frames)
+        return;
+
+    AllocationTracker::Counts counts = frames.getLastFrameAllocations();
+    if (counts.allocations > 0)
+    {
+        std::cerr << label << " " << frames.getTotalFrames() - 1 << " allocated " << counts.allocations
+                  << " times (" << counts.bytes << " bytes)" << std::endl;
+        assert(!"steady-state frame allocated");
+    }
+}
@@ -2,27 +2,72 @@
  * @file Game.h
  * @brief Header file for the main Game class in Flappy Bird 2-player game
  * 
- * This file defines the Game class which orchestrates all game systems
- * including rendering, input handling, collision detection, scoring,
- * and game state management for a two-player Flappy Bird experience.
+ * This file defines the Game class which drives the headless Simulation
+ * from a window: it handles menus, runs the simulation on its own thread
+ * fed by keyboard input, and renders the snapshots it publishes for a
+ * two-player Flappy Bird experience.
  */
 
 #pragma once
 #include <SFML/Graphics.hpp>
+#include "AudioEngine.h"
 #include "Bird.h"
-#include <vector>
+#include "GlyphAtlas.h"
+#include "HudText.h"
+#include "InputThread.h"
+#include "LookaheadBot.h"
+#include "NetPeer.h"
 #include "Pipe.h"
+#include "Profiler.h"
+#include "ProfileOverlay.h"
+#include "Simulation.h"
+#include "Replay.h"
+#include "SpriteBatch.h"
+#include "TextureAtlas.h"
+#include "TripleBuffer.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <random>
+#include <string>
+#include <thread>
 
 using namespace sf;
 
+/**
+ * @struct SimTimes
+ * @brief Running totals of time the simulation thread spent per phase
+ */
+struct SimTimes
+{
+    std::chrono::nanoseconds update{0};      ///< Whole ticks
+    std::chrono::nanoseconds collision{0};   ///< Collision checks
+    std::chrono::nanoseconds score{0};       ///< Score checks
+};
+
+/**
+ * @struct SimFrame
+ * @brief Snapshot published by the simulation thread after each tick
+ */
+struct SimFrame
+{
+    SimSnapshot state;                                ///< Match state after the tick
+    std::chrono::steady_clock::time_point tick_time;  ///< When the tick was due
+    bool finished = false;                            ///< True once a replay has run out of input
+    SimTimes times;                                   ///< Simulation thread time up to this tick
+};
+
 /**
  * @class Game
  * @brief Main game controller class that manages all game systems
  * 
- * The Game class handles the complete game lifecycle including menu screens,
- * gameplay mechanics, collision detection, scoring, and rendering. It manages
- * two bird players, dynamic pipe generation, and multiple game states.
+ * The Game class handles the windowed game lifecycle including menu screens,
+ * input handling and rendering. All gameplay rules run in the Simulation it
+ * owns, so Game is a thin renderer on top of the match state.
+ * 
+ * During a match the simulation steps on its own thread and publishes a
+ * SimFrame after every tick through a triple buffer; the render loop
+ * only ever reads the newest published frame.
  */
 class Game
 {
@@ -31,68 +76,114 @@ private:
     RenderWindow& win;                          ///< Reference to the main game window
     
     // Menu and UI textures/sprites
-    Texture menu_texture, controls_texture;     ///< Textures for menu and controls screens
+    std::shared_ptr<Texture> menu_texture, controls_texture;  ///< Textures for menu and controls screens
     Sprite menu_sprite, controls_sprite;        ///< Sprites for menu and controls screens
     
     // Background and environment
-    Texture background, ground_texture;         ///< Background and ground textures
-    Sprite background_sprite, ground_sprite1, ground_sprite2;  ///< Background and scrolling ground sprites
-    
-    // Player birds
-    Bird bird1;                                 ///< Player 1's bird object
-    Bird bird2;                                 ///< Player 2's bird object
-    
-    // Game state flags
-    bool enter_pressed;                         ///< Flag indicating if game has started
-    bool run_game1, run_game2;                 ///< Flags indicating if each player is still active
-    bool start_monitoring;                      ///< Flag for score monitoring through pipes
-    bool bird1Collided;                         ///< Flag indicating Player 1's bird has collided
-    bool bird2Collided;                         ///< Flag indicating Player 2's bird has collided
+    std::shared_ptr<Texture> background;        ///< Background texture
+    Sprite background_sprite;                   ///< Background sprite
+    
+    // Match state
+    Simulation sim;                             ///< Headless engine running the game rules
+    TripleBuffer<SimFrame> snapshots;           ///< Newest tick handed from the simulation thread
+    std::thread sim_thread;                     ///< Thread stepping sim during a match
+    std::atomic<bool> sim_running;              ///< Cleared to stop the simulation thread
+    std::random_device rd;                      ///< Random device for seeding each new match
+    
+    // Replay recording and playback
+    std::string record_path;                    ///< File each new match is recorded to (empty = off)
+    bool record_hashes;                         ///< Flag for recording every tick's state digest too
+    ReplayWriter recorder;                      ///< Input log of the match being played
+    ReplayReader playback;                      ///< Input log of the match being replayed
+    bool replaying;                             ///< Flag indicating inputs come from a replay
+    bool fast_forward;                          ///< Flag for replaying as fast as possible
+    
+    // Keyboard input
+    InputThread input_thread;                   ///< Captures timestamped key presses between frames
+    std::unique_ptr<LookaheadBot> bot;          ///< Computer player flying one bird (nullptr = two humans)
+    std::unique_ptr<NetPeer> net;               ///< Online connection to the other player (nullptr = local play)
+    
+    // Player birds and pipes
+    // Gameplay sprites (pipes, ground, birds) share one atlas and one draw call
+    TextureAtlas atlas;                         ///< Atlas packing every gameplay image
+    SpriteBatch world;                          ///< Quads for pipes, ground and birds, rebuilt each frame
+    int ground_region;                          ///< Atlas region of the ground tile
+    CollisionMasks masks;                       ///< Sprite masks for pixel-exact collisions
+    bool masks_loaded;                          ///< True if every mask could be built
+    Bird bird1;                                 ///< Player 1's bird renderer
+    Bird bird2;                                 ///< Player 2's bird renderer
+    Pipe pipe;                                  ///< Renderer for every pipe pair
+    
+    // Screen state flags
     bool showMainMenu;                          ///< Flag for displaying main menu
     bool showControls;                          ///< Flag for displaying controls screen
+    int shown_score_p1, shown_score_p2;        ///< Scores currently shown in the score texts
     
-    // Movement and physics
-    const int move_speed = 270;                 ///< Horizontal movement speed for ground/pipes
+    // Sound
+    AudioEngine audio;                          ///< Voice pool for flap, score and death sounds
+    std::uint32_t heard_flaps[2];               ///< Flap counts already played per player
+    int heard_scores[2];                        ///< Scores already played per player
+    bool heard_deaths[2];                       ///< Deaths already played per player
+    float alpha;                                ///< Fraction of a tick elapsed since the last simulation step
     
     // Victory sprites
-    Texture bird1_win_texture;                  ///< Texture for Player 2 victory sprite
+    std::shared_ptr<Texture> bird1_win_texture; ///< Texture for Player 2 victory sprite
     Sprite bird1_win_sprite;                    ///< Sprite for Player 2 victory display
-    Texture bird2_win_texture;                  ///< Texture for Player 1 victory sprite  
+    std::shared_ptr<Texture> bird2_win_texture; ///< Texture for Player 1 victory sprite  
     Sprite bird2_win_sprite;                    ///< Sprite for Player 1 victory display
     
-    // Pipe system
-    int pipe_counter, pipe_spawn_time;          ///< Timing variables for pipe spawning
-    int score_p1, score_p2;                    ///< Player scores
-    std::vector<Pipe> pipes;                    ///< Container for active pipe obstacles
-    std::random_device rd;                      ///< Random device for pipe positioning
-    std::uniform_int_distribution<int> dist{250, 550};  ///< Random distribution for pipe heights
-    
     // Text and fonts
-    Font normalfont;                            ///< Font for regular UI text
-    Font gamefont;                              ///< Font for game title and headers
-    Text playagain_text, player1_score_text, player2_score_text;  ///< Score and restart text
-    Text p1_win_text, p2_win_text, Draw_text;  ///< Victory and draw message text
-    Texture go_texture;                         ///< Game over screen texture
+    std::shared_ptr<Font> normalfont;           ///< Font for regular UI text
+    std::shared_ptr<Font> gamefont;             ///< Font for game title and headers
+    GlyphAtlas hud_glyphs;                      ///< Pre-rasterized characters of every HUD text
+    HudText playagain_text, player1_score_text, player2_score_text;  ///< Score and restart text
+    HudText p1_win_text, p2_win_text, Draw_text;  ///< Victory and draw message text
+    std::shared_ptr<Texture> go_texture;        ///< Game over screen texture
     Sprite go_sprite;                           ///< Game over screen sprite
+    
+    // Frame profiling
+    Profiler profiler;                          ///< Per-phase timings of recent frames
+    ProfileOverlay profile_overlay;             ///< On-screen timings, toggled with F3
+    bool show_profiler;                         ///< Flag for displaying the profiler overlay
+    static const int warmup_frames = 120;       ///< Frames allowed to allocate before the no-allocation check
+    std::string profile_path;                   ///< CSV file the timings are written to on exit (empty = off)
 
     // Private methods for game logic
     
     /**
-     * @brief Renders all game objects to the screen
+     * @brief Renders all game objects to the screen, interpolated by alpha
+     * @param state Snapshot to draw
+     */
+    void draw(const SimSnapshot& state);
+    
+    /**
+     * @brief Adds the scrolling ground tiles to the world batch
+     * @param state Snapshot to draw
+     */
+    void drawGround(const SimSnapshot& state);
+    
+    /**
+     * @brief Simulation thread: steps fixed ticks on schedule and publishes snapshots
      */
-    void draw();
+    void runSimulation();
     
     /**
-     * @brief Moves ground sprites to create scrolling effect
-     * @param dt Delta time for frame-independent movement
+     * @brief Advances the simulation one tick, recording or replaying inputs
+     * @param input Keyboard inputs for this tick; cleared once applied
      */
-    void moveGround(Time& dt);
+    void stepSimulation(SimInput& input);
     
     /**
-     * @brief Processes core game logic during active gameplay
-     * @param dt Delta time for frame-independent updates
+     * @brief Plays sounds for flaps, points and deaths since the last frame
+     * @param state Newest snapshot
      */
-    void doProcessing(Time& dt);
+    void playSounds(const SimSnapshot& state);
+    
+    /**
+     * @brief Refreshes score texts when the scores change
+     * @param state Snapshot holding the scores
+     */
+    void updateScoreText(const SimSnapshot& state);
     
     /**
      * @brief Displays the main menu screen
@@ -110,38 +201,56 @@ private:
     void showControlsScreen();
     
     /**
-     * @brief Checks collision detection for Player 1's bird
+     * @brief Resets game state for a new game session
      */
-    void checkCollisions1();
+    void restartGame();
     
     /**
-     * @brief Checks collision detection for Player 2's bird
+     * @brief Asserts that a steady-state frame made no heap allocations
+     * @param frames Profiler of the calling thread, with the frame just closed
+     * @param label "Frame" for the render loop, "Tick" for the simulation thread
+     */
+    void checkFrameAllocations(const Profiler& frames, const char* label);
+
+public:
+    /**
+     * @brief Constructor - initializes all game systems and assets
+     * @param window Reference to the SFML RenderWindow for rendering
      */
-    void checkCollisions2();
+    Game(RenderWindow& window);
     
     /**
-     * @brief Resets game state for a new game session
+     * @brief Records every match started from the menu
+     * @param path Replay file to write (overwritten by each new match)
+     * @param hashes True to also record each tick's state digest, for desync checks
      */
-    void restartGame();
+    void recordTo(const std::string& path, bool hashes = false);
     
     /**
-     * @brief Updates player scores when passing through pipes
+     * @brief Lets the computer fly one bird instead of a player
+     * @param player Bird to hand over (0 or 1)
      */
-    void checkScore();
+    void setBot(int player);
     
     /**
-     * @brief Converts integer to string for score display
-     * @param num Integer value to convert
-     * @return String representation of the number
+     * @brief Plays an online match against a connected peer instead of sharing the keyboard
+     * @param peer Peer whose handshake has completed
      */
-    std::string toString(int num);
-
-public:
+    void playOnline(std::unique_ptr<NetPeer> peer);
+    
     /**
-     * @brief Constructor - initializes all game systems and assets
-     * @param window Reference to the SFML RenderWindow for rendering
+     * @brief Writes the frame profiler's history to a CSV file on exit
+     * @param path CSV file to write
      */
-    Game(RenderWindow& window);
+    void profileTo(const std::string& path);
+    
+    /**
+     * @brief Plays back a recorded match instead of reading the keyboard
+     * @param path Replay file to read
+     * @param fast True to replay as fast as possible, false for real time
+     * @return True if the replay file could be loaded
+     */
+    bool loadReplay(const std::string& path, bool fast);
     
     /**
      * @brief Main game loop that handles events, updates, and rendering
@@ -14,3 +14,11 @@ constexpr int window_height = 768;  ///< Height of the game window in pixels
 
 // Sprite scaling
 constexpr float scaling_factor = 1.5f;  ///< Uniform scaling factor for game sprites
+
+// World geometry shared by the simulation and the renderer (in window pixels)
+constexpr float bird_width = 34 * scaling_factor;    ///< Width of a bird's collision box
+constexpr float bird_height = 24 * scaling_factor;   ///< Height of a bird's collision box
+constexpr float pipe_width = 52 * scaling_factor;    ///< Width of a pipe segment
+constexpr float pipe_height = 320 * scaling_factor;  ///< Height of a pipe segment
+constexpr float ground_top = 578.f;                  ///< Top edge of the ground strip
+constexpr float ground_width = 400 * scaling_factor; ///< Width of one ground tile
@@ -0,0 +1,115 @@
+/**
+ * @file GlyphAtlas.cpp
+ * @brief Implementation of the GlyphAtlas class for Flappy Bird 2-player game
+ *
+ * This file contains glyph rasterization and copying out of font pages.
+ */
+
+#include "GlyphAtlas.h"
+
+static const int glyph_padding = 1;   ///< Transparent border kept around each glyph, as sf::Text draws it
+
+/**
+ * @brief Rasterizes the characters of one font face
+ * @param font Font to rasterize (must outlive the atlas)
+ * @param size Character size in pixels
+ * @param characters Every character the face will show (repeats are ignored)
+ * @return Face index to pass to getGlyph()
+ *
+ * Characters outside printable ASCII are skipped. The font's page texture
+ * is read back once, after every character has been rasterized into it,
+ * since rasterizing more characters may grow and rearrange the page.
+ */
+int GlyphAtlas::addFace(const Font& font, unsigned size, const std::string& characters)
+{
+    Face face;
+    face.font = &font;
+    face.size = size;
+    for (int i = 0; i < char_count; i++)
+        face.glyphs[i] = -1;
+
+    std::size_t first_glyph = glyphs.size();
+    std::vector<IntRect> page_rects;
+    for (char c : characters)
+    {
+        int index = c - first_char;
+        if (index < 0 || index >= char_count || face.glyphs[index] >= 0)
+            continue;
+
+        const Glyph& glyph = font.getGlyph(static_cast<Uint32>(c), size, false);
+        AtlasGlyph placed;
+        placed.bounds = glyph.bounds;
+        placed.advance = glyph.advance;
+        face.glyphs[index] = static_cast<int>(glyphs.size());
+        glyphs.push_back(placed);
+        page_rects.push_back(glyph.textureRect);
+    }
+
+    Image page = font.getTexture(size).copyToImage();
+    for (std::size_t i = 0; i < page_rects.size(); i++)
+    {
+        AtlasGlyph& placed = glyphs[first_glyph + i];
+        const IntRect& source = page_rects[i];
+        if (source.width <= 0 || source.height <= 0)
+        {
+            regions.push_back(-1);  // Whitespace only moves the pen
+            continue;
+        }
+
+        placed.bounds.left -= glyph_padding;
+        placed.bounds.top -= glyph_padding;
+        placed.bounds.width += 2 * glyph_padding;
+        placed.bounds.height += 2 * glyph_padding;
+
+        Image pixels;
+        pixels.create(source.width + 2 * glyph_padding, source.height + 2 * glyph_padding, Color::Transparent);
+        pixels.copy(page, 0, 0, IntRect(source.left - glyph_padding, source.top - glyph_padding,
+                                        source.width + 2 * glyph_padding, source.height + 2 * glyph_padding));
+        regions.push_back(atlas.add(pixels));
+    }
+
+    faces.push_back(face);
+    return static_cast<int>(faces.size() - 1);
+}
+
+/**
+ * @brief Packs every face into the atlas texture
+ * @return True if the texture could be created
+ */
+bool GlyphAtlas::build()
+{
+    bool built = atlas.build();
+    for (std::size_t i = 0; i < glyphs.size(); i++)
+    {
+        if (regions[i] >= 0)
+            glyphs[i].rect = atlas.getRect(regions[i]);
+    }
+    return built;
+}
+
+/**
+ * @brief Gets where a character lives inside the atlas
+ * @param face Index returned by addFace()
+ * @param character Character to look up
+ * @return Glyph (valid after build()), or nullptr if the face lacks the character
+ */
+const AtlasGlyph* GlyphAtlas::getGlyph(int face, char character) const
+{
+    int index = character - first_char;
+    if (index < 0 || index >= char_count || faces[face].glyphs[index] < 0)
+        return nullptr;
+    return &glyphs[faces[face].glyphs[index]];
+}
+
+/**
+ * @brief Gets the kerning between two characters of a face
+ * @param face Index returned by addFace()
+ * @param first Character on the left
+ * @param second Character on the right
+ * @return Offset to add to the pen position between them
+ */
+float GlyphAtlas::getKerning(int face, char first, char second) const
+{
+    const Face& entry = faces[face];
+    return entry.font->getKerning(static_cast<Uint32>(first), static_cast<Uint32>(second), entry.size);
+}
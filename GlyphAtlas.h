@@ -0,0 +1,106 @@
+/**
+ * @file GlyphAtlas.h
+ * @brief Header file for the GlyphAtlas class in Flappy Bird 2-player game
+ *
+ * This file defines the GlyphAtlas class which rasterizes the characters
+ * the HUD needs once at startup and packs them into one texture, so
+ * score and game over texts never touch the font again while playing.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+#include "TextureAtlas.h"
+
+using namespace sf;
+
+/**
+ * @struct AtlasGlyph
+ * @brief Placement of one pre-rasterized character
+ */
+struct AtlasGlyph
+{
+    FloatRect bounds;   ///< Quad relative to the pen position on the baseline (empty for spaces)
+    IntRect rect;       ///< Pixels inside the atlas texture
+    float advance;      ///< Distance to the next pen position
+};
+
+/**
+ * @class GlyphAtlas
+ * @brief Pre-rasterized characters of a few font faces in one texture
+ *
+ * Each face is a font at one character size with the characters it will
+ * ever have to show. addFace() has the font rasterize those characters
+ * and copies their pixels out of the font's page; build() packs every
+ * face into a single TextureAtlas. Glyph pixels are white with alpha, so
+ * quads are coloured through their vertex colour, exactly like sf::Text.
+ */
+class GlyphAtlas
+{
+private:
+    static const int first_char = 32;    ///< First printable ASCII character
+    static const int char_count = 95;    ///< Printable ASCII characters
+
+    /**
+     * @struct Face
+     * @brief Characters of one font at one size
+     */
+    struct Face
+    {
+        const Font* font;             ///< Font the glyphs came from (kerning lookups)
+        unsigned size;                ///< Character size in pixels
+        int glyphs[char_count];       ///< Index into glyphs for each character, -1 if missing
+    };
+
+    std::vector<Face> faces;          ///< Registered faces
+    std::vector<AtlasGlyph> glyphs;   ///< Every character of every face
+    std::vector<int> regions;         ///< Atlas region of each glyph, -1 for glyphs without pixels
+    TextureAtlas atlas;               ///< Packed glyph pixels
+
+public:
+    /**
+     * @brief Rasterizes the characters of one font face
+     * @param font Font to rasterize (must outlive the atlas)
+     * @param size Character size in pixels
+     * @param characters Every character the face will show (repeats are ignored)
+     * @return Face index to pass to getGlyph()
+     */
+    int addFace(const Font& font, unsigned size, const std::string& characters);
+
+    /**
+     * @brief Packs every face into the atlas texture
+     * @return True if the texture could be created
+     */
+    bool build();
+
+    /**
+     * @brief Gets where a character lives inside the atlas
+     * @param face Index returned by addFace()
+     * @param character Character to look up
+     * @return Glyph (valid after build()), or nullptr if the face lacks the character
+     */
+    const AtlasGlyph* getGlyph(int face, char character) const;
+
+    /**
+     * @brief Gets the character size of a face
+     * @param face Index returned by addFace()
+     * @return Character size in pixels
+     */
+    unsigned getCharacterSize(int face) const { return faces[face].size; }
+
+    /**
+     * @brief Gets the kerning between two characters of a face
+     * @param face Index returned by addFace()
+     * @param first Character on the left
+     * @param second Character on the right
+     * @return Offset to add to the pen position between them
+     */
+    float getKerning(int face, char first, char second) const;
+
+    /**
+     * @brief Gets the packed glyph texture
+     * @return Atlas texture (valid after build())
+     */
+    const Texture& getTexture() const { return atlas.getTexture(); }
+};
@@ -0,0 +1,161 @@
+/**
+ * @file HudText.cpp
+ * @brief Implementation of the HudText class for Flappy Bird 2-player game
+ */
+
+#include "HudText.h"
+
+HudText::HudText() :
+vertices(Triangles),
+atlas(nullptr),
+face(0),
+digits_first(0),
+digit_slots(0)
+{
+}
+
+/**
+ * @brief Lays out the text and reserves digit slots after it
+ * @param glyph_atlas Built atlas holding the glyphs (must outlive the text)
+ * @param glyph_face Face of the atlas to use
+ * @param text Fixed text, laid out once
+ * @param position Top-left corner of the line, as for sf::Text
+ * @param color Fill colour
+ * @param digits Number of digit slots for setNumber() (0 = none)
+ *
+ * Places characters the way sf::Text does: the baseline sits one
+ * character size below position, and kerning is applied between
+ * neighbouring characters of the fixed text. Characters the face lacks
+ * are skipped. The digit slots start out showing 0.
+ */
+void HudText::create(const GlyphAtlas& glyph_atlas, int glyph_face, const char* text,
+                     Vector2f position, const Color& color, int digits)
+{
+    atlas = &glyph_atlas;
+    face = glyph_face;
+    vertices.clear();
+
+    Vector2f pen(position.x, position.y + atlas->getCharacterSize(face));
+    char previous = 0;
+    for (const char* c = text; *c; c++)
+    {
+        const AtlasGlyph* glyph = atlas->getGlyph(face, *c);
+        if (!glyph)
+            continue;
+        if (previous)
+            pen.x += atlas->getKerning(face, previous, *c);
+        if (glyph->bounds.width > 0.f)
+            appendQuad(glyph, pen, color);
+        pen.x += glyph->advance;
+        previous = *c;
+    }
+
+    digits_first = vertices.getVertexCount();
+    digit_slots = digits;
+    digits_pen = pen;
+    for (int i = 0; i < digit_slots; i++)
+        appendQuad(nullptr, pen, color);
+    if (digit_slots > 0)
+        setNumber(0);
+}
+
+/**
+ * @brief Shows a number in the digit slots
+ * @param value Number to show (negative values show as 0, too many digits as all nines)
+ *
+ * Digits follow each other by their advance only; the fixed text's
+ * kerning is not looked up again, so this never calls into the font.
+ */
+void HudText::setNumber(int value)
+{
+    char digits[16];
+    int count = 0;
+    unsigned number = value > 0 ? static_cast<unsigned>(value) : 0u;
+    do
+    {
+        digits[count++] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    } while (number > 0 && count < 16);
+
+    if (count > digit_slots)
+    {
+        count = digit_slots;
+        for (int i = 0; i < count; i++)
+            digits[i] = '9';
+    }
+
+    Vector2f pen = digits_pen;
+    for (int slot = 0; slot < digit_slots; slot++)
+    {
+        std::size_t first = digits_first + static_cast<std::size_t>(slot) * 6;
+        const AtlasGlyph* glyph = slot < count ? atlas->getGlyph(face, digits[count - 1 - slot]) : nullptr;
+        setQuad(first, glyph, pen);
+        if (glyph)
+            pen.x += glyph->advance;
+    }
+}
+
+/**
+ * @brief Appends one character quad
+ * @param glyph Character to draw (nullptr for an empty quad)
+ * @param pen Pen position on the baseline
+ * @param color Vertex colour
+ */
+void HudText::appendQuad(const AtlasGlyph* glyph, Vector2f pen, const Color& color)
+{
+    std::size_t first = vertices.getVertexCount();
+    vertices.resize(first + 6);
+    for (std::size_t i = first; i < first + 6; i++)
+        vertices[i].color = color;
+    setQuad(first, glyph, pen);
+}
+
+/**
+ * @brief Rewrites one existing character quad
+ * @param first First vertex of the quad
+ * @param glyph Character to draw (nullptr for an empty quad)
+ * @param pen Pen position on the baseline
+ */
+void HudText::setQuad(std::size_t first, const AtlasGlyph* glyph, Vector2f pen)
+{
+    if (!glyph)
+    {
+        for (std::size_t i = first; i < first + 6; i++)
+        {
+            vertices[i].position = pen;
+            vertices[i].texCoords = Vector2f(0.f, 0.f);
+        }
+        return;
+    }
+
+    float left = pen.x + glyph->bounds.left, top = pen.y + glyph->bounds.top;
+    float right = left + glyph->bounds.width, bottom = top + glyph->bounds.height;
+    float u0 = static_cast<float>(glyph->rect.left), v0 = static_cast<float>(glyph->rect.top);
+    float u1 = u0 + glyph->rect.width, v1 = v0 + glyph->rect.height;
+
+    vertices[first + 0].position = Vector2f(left, top);
+    vertices[first + 1].position = Vector2f(right, top);
+    vertices[first + 2].position = Vector2f(right, bottom);
+    vertices[first + 3].position = Vector2f(left, top);
+    vertices[first + 4].position = Vector2f(right, bottom);
+    vertices[first + 5].position = Vector2f(left, bottom);
+    vertices[first + 0].texCoords = Vector2f(u0, v0);
+    vertices[first + 1].texCoords = Vector2f(u1, v0);
+    vertices[first + 2].texCoords = Vector2f(u1, v1);
+    vertices[first + 3].texCoords = Vector2f(u0, v0);
+    vertices[first + 4].texCoords = Vector2f(u1, v1);
+    vertices[first + 5].texCoords = Vector2f(u0, v1);
+}
+
+/**
+ * @brief Draws every quad with one call
+ * @param target Render target
+ * @param states Render states (the atlas texture is added)
+ */
+void HudText::draw(RenderTarget& target, RenderStates states) const
+{
+    if (!atlas)
+        return;
+    states.texture = &atlas->getTexture();
+    target.draw(vertices, states);
+}
@@ -0,0 +1,80 @@
+/**
+ * @file HudText.h
+ * @brief Header file for the HudText class in Flappy Bird 2-player game
+ *
+ * This file defines the HudText class which draws a line of text from a
+ * GlyphAtlas, with an optional number whose digits can change without
+ * laying the line out again.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "GlyphAtlas.h"
+
+using namespace sf;
+
+/**
+ * @class HudText
+ * @brief One line of atlas text followed by a fixed number of digit slots
+ *
+ * create() lays the text out once into a vertex array, one quad per
+ * visible character, then appends one quad per digit slot. setNumber()
+ * only rewrites the positions and texture coordinates of the digit
+ * quads; slots the number does not need collapse to empty quads. The
+ * vertex array never changes size after create(), so updating the
+ * number never allocates.
+ */
+class HudText : public Drawable
+{
+private:
+    VertexArray vertices;        ///< Two triangles per character quad
+    const GlyphAtlas* atlas;     ///< Glyphs the quads sample from
+    int face;                    ///< Face of the atlas the text uses
+    std::size_t digits_first;    ///< First vertex of the digit slots
+    int digit_slots;             ///< Number of digit quads after the text
+    Vector2f digits_pen;         ///< Pen position the number starts at
+
+    /**
+     * @brief Appends one character quad
+     * @param glyph Character to draw (nullptr for an empty quad)
+     * @param pen Pen position on the baseline
+     * @param color Vertex colour
+     */
+    void appendQuad(const AtlasGlyph* glyph, Vector2f pen, const Color& color);
+
+    /**
+     * @brief Rewrites one existing character quad
+     * @param first First vertex of the quad
+     * @param glyph Character to draw (nullptr for an empty quad)
+     * @param pen Pen position on the baseline
+     */
+    void setQuad(std::size_t first, const AtlasGlyph* glyph, Vector2f pen);
+
+    /**
+     * @brief Draws every quad with one call
+     * @param target Render target
+     * @param states Render states (the atlas texture is added)
+     */
+    void draw(RenderTarget& target, RenderStates states) const override;
+
+public:
+    HudText();
+
+    /**
+     * @brief Lays out the text and reserves digit slots after it
+     * @param glyph_atlas Built atlas holding the glyphs (must outlive the text)
+     * @param glyph_face Face of the atlas to use
+     * @param text Fixed text, laid out once
+     * @param position Top-left corner of the line, as for sf::Text
+     * @param color Fill colour
+     * @param digits Number of digit slots for setNumber() (0 = none)
+     */
+    void create(const GlyphAtlas& glyph_atlas, int glyph_face, const char* text,
+                Vector2f position, const Color& color, int digits = 0);
+
+    /**
+     * @brief Shows a number in the digit slots
+     * @param value Number to show (negative values show as 0, too many digits as all nines)
+     */
+    void setNumber(int value);
+};
@@ -0,0 +1,102 @@
+/**
+ * @file InputThread.cpp
+ * @brief Implementation of the InputThread class for Flappy Bird 2-player game
+ */
+
+#include "InputThread.h"
+
+static const Keyboard::Key game_keys[4] = { Keyboard::Enter, Keyboard::Space, Keyboard::Up, Keyboard::R };
+
+InputThread::InputThread() :
+running(false),
+focused(true)
+{
+}
+
+/**
+ * @brief Stops the thread if it is running
+ */
+InputThread::~InputThread()
+{
+    stop();
+}
+
+/**
+ * @brief Starts sampling (keys already held count as not pressed)
+ */
+void InputThread::start()
+{
+    if (running.exchange(true))
+        return;
+    thread = std::thread(&InputThread::run, this);
+}
+
+/**
+ * @brief Stops sampling and joins the thread
+ */
+void InputThread::stop()
+{
+    running.store(false);
+    if (thread.joinable())
+        thread.join();
+}
+
+/**
+ * @brief Sampling loop run by the thread
+ *
+ * Samples every millisecond (sf::sleep raises the timer resolution where
+ * the OS needs it) and queues a timestamped event whenever a game key
+ * goes from up to down.
+ */
+void InputThread::run()
+{
+    bool was_down[4];
+    for (int i = 0; i < 4; i++)
+        was_down[i] = Keyboard::isKeyPressed(game_keys[i]);
+
+    while (running.load(std::memory_order_relaxed))
+    {
+        bool has_focus = focused.load(std::memory_order_relaxed);
+        bool pressed[4];
+        bool any = false;
+        for (int i = 0; i < 4; i++)
+        {
+            bool down = has_focus && Keyboard::isKeyPressed(game_keys[i]);
+            pressed[i] = down && !was_down[i];
+            was_down[i] = down;
+            any = any || pressed[i];
+        }
+
+        if (any)
+        {
+            InputEvent event;
+            event.time = std::chrono::steady_clock::now();
+            event.input.start = pressed[0];
+            event.input.flap[0] = pressed[1];
+            event.input.flap[1] = pressed[2];
+            event.input.restart = pressed[3];
+            events.push(event);  // Only fails if the game loop has stalled for 256 presses
+        }
+
+        sleep(milliseconds(1));
+    }
+}
+
+/**
+ * @brief Merges every press that happened up to a point in time into an input
+ * @param until Presses after this time stay queued
+ * @param input Input to add the presses to
+ */
+void InputThread::collect(std::chrono::steady_clock::time_point until, SimInput& input)
+{
+    while (const InputEvent* event = events.front())
+    {
+        if (event->time > until)
+            break;
+        input.start = input.start || event->input.start;
+        input.flap[0] = input.flap[0] || event->input.flap[0];
+        input.flap[1] = input.flap[1] || event->input.flap[1];
+        input.restart = input.restart || event->input.restart;
+        events.pop();
+    }
+}
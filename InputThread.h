@@ -0,0 +1,87 @@
+/**
+ * @file InputThread.h
+ * @brief Header file for the InputThread class in Flappy Bird 2-player game
+ *
+ * This file defines InputThread, which samples the game keys on its own
+ * thread about once per millisecond and queues each press with the time
+ * it happened, so the game loop can apply it to the exact simulation
+ * tick it belongs to instead of the next rendered frame.
+ */
+
+#pragma once
+#include <SFML/Window.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include "Simulation.h"
+#include "SpscQueue.h"
+
+using namespace sf;
+
+/**
+ * @struct InputEvent
+ * @brief Key presses seen in one sample, with the time they were seen
+ */
+struct InputEvent
+{
+    std::chrono::steady_clock::time_point time;   ///< When the keys went down
+    SimInput input;                               ///< Keys that went down
+};
+
+/**
+ * @class InputThread
+ * @brief Polls the game keys on a background thread into a lock-free queue
+ *
+ * SFML window events can only be read on the thread that owns the window,
+ * so the thread reads the real-time keyboard state instead and reports
+ * keys that went down since the previous sample. Keys are ignored while
+ * the window does not have focus; the game loop reports focus changes
+ * through setFocused().
+ */
+class InputThread
+{
+private:
+    SpscQueue<InputEvent, 256> events;   ///< Presses waiting for the game loop
+    std::thread thread;                  ///< Sampling thread
+    std::atomic<bool> running;           ///< Cleared to stop the thread
+    std::atomic<bool> focused;           ///< True while the game window has focus
+
+    /**
+     * @brief Sampling loop run by the thread
+     */
+    void run();
+
+public:
+    InputThread();
+
+    /**
+     * @brief Stops the thread if it is running
+     */
+    ~InputThread();
+
+    InputThread(const InputThread&) = delete;
+    InputThread& operator=(const InputThread&) = delete;
+
+    /**
+     * @brief Starts sampling (keys already held count as not pressed)
+     */
+    void start();
+
+    /**
+     * @brief Stops sampling and joins the thread
+     */
+    void stop();
+
+    /**
+     * @brief Tells the thread whether the game window has focus
+     * @param has_focus True if key presses should be captured
+     */
+    void setFocused(bool has_focus) { focused.store(has_focus, std::memory_order_relaxed); }
+
+    /**
+     * @brief Merges every press that happened up to a point in time into an input
+     * @param until Presses after this time stay queued
+     * @param input Input to add the presses to
+     */
+    void collect(std::chrono::steady_clock::time_point until, SimInput& input);
+};
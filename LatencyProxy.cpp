@@ -0,0 +1,87 @@
+/**
+ * @file LatencyProxy.cpp
+ * @brief Implementation of the simulated-latency UDP proxy for Flappy Bird 2-player game
+ */
+
+#include "LatencyProxy.h"
+
+/**
+ * @brief Constructor - creates an unbound proxy
+ * @param proxy_config Network conditions to simulate
+ * @param seed Seed of the jitter and loss random generator
+ */
+LatencyProxy::LatencyProxy(const ProxyConfig& proxy_config, std::uint32_t seed) :
+target_port(0),
+client_port(0),
+config(proxy_config),
+random(seed),
+forwarded(0),
+dropped(0)
+{
+    socket.setBlocking(false);
+    queue.reserve(256);
+}
+
+/**
+ * @brief Starts listening and sets where client packets go
+ * @param port Port clients send to (0 = any free port)
+ * @param address Target address
+ * @param target Target port
+ * @return True if the port could be bound
+ */
+bool LatencyProxy::open(unsigned short port, const IpAddress& address, unsigned short target)
+{
+    target_address = address;
+    target_port = target;
+    return socket.bind(port) == Socket::Done;
+}
+
+/**
+ * @brief Receives waiting packets and forwards those that are due
+ * @param now Current time
+ */
+void LatencyProxy::pump(std::chrono::steady_clock::time_point now)
+{
+    std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+    Datagram packet;
+    IpAddress sender;
+    unsigned short sender_port;
+    while (socket.receive(packet.data, sizeof(packet.data), packet.size, sender, sender_port) == Socket::Done)
+    {
+        packet.to_target = !(sender == target_address && sender_port == target_port);
+        if (packet.to_target)
+        {
+            client_address = sender;
+            client_port = sender_port;
+        }
+        if (chance(random) < config.loss)
+        {
+            dropped++;
+            continue;
+        }
+
+        float delay_ms = config.delay_ms + config.jitter_ms * chance(random);
+        packet.due = now + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<float, std::milli>(delay_ms));
+        queue.push_back(packet);
+    }
+
+    // Forward due packets; the rest keep their order in the queue
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < queue.size(); i++)
+    {
+        const Datagram& due = queue[i];
+        if (due.due > now)
+        {
+            queue[kept++] = due;
+            continue;
+        }
+        if (due.to_target)
+            socket.send(due.data, due.size, target_address, target_port);
+        else if (client_port != 0)
+            socket.send(due.data, due.size, client_address, client_port);
+        forwarded++;
+    }
+    queue.resize(kept);
+}
@@ -0,0 +1,111 @@
+/**
+ * @file LatencyProxy.h
+ * @brief Header file for the LatencyProxy class in Flappy Bird 2-player game
+ *
+ * This file defines a UDP forwarder that sits between an online guest
+ * and its host and makes a local connection behave like a bad one:
+ * every packet is held back by a fixed delay plus random jitter, and
+ * some are dropped. Online play and rollback can then be tried on one
+ * machine.
+ */
+
+#pragma once
+#include <SFML/Network.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+using namespace sf;
+
+/**
+ * @struct ProxyConfig
+ * @brief Network conditions a LatencyProxy simulates, in each direction
+ */
+struct ProxyConfig
+{
+    float delay_ms = 40.f;          ///< Fixed one-way delay (milliseconds)
+    float jitter_ms = 10.f;         ///< Extra random delay, uniform in [0, jitter_ms]
+    float loss = 0.02f;             ///< Chance of dropping each packet
+};
+
+/**
+ * @class LatencyProxy
+ * @brief Forwards datagrams between a client and a target with delay, jitter and loss
+ *
+ * Packets from the target go to the client that last sent something;
+ * packets from anyone else are taken as coming from the client and go to
+ * the target. Jitter can reorder packets, as on a real network.
+ *
+ * The proxy never sleeps or reads the clock itself: pump() is given the
+ * current time, so a test harness can drive it with simulated time and
+ * get the same delays however fast it runs.
+ */
+class LatencyProxy
+{
+private:
+    /**
+     * @struct Datagram
+     * @brief A packet waiting for its delivery time
+     */
+    struct Datagram
+    {
+        std::chrono::steady_clock::time_point due;   ///< When to forward it
+        bool to_target;                              ///< Direction (true = client to target)
+        std::size_t size;                            ///< Bytes used in data
+        std::uint8_t data[512];                      ///< Packet bytes
+    };
+
+    UdpSocket socket;                            ///< Socket both sides talk to
+    IpAddress target_address;                    ///< Where client packets go
+    unsigned short target_port;                  ///< Port of the target
+    IpAddress client_address;                    ///< Where target packets go (last client seen)
+    unsigned short client_port;                  ///< Port of the client (0 = none seen yet)
+    ProxyConfig config;                          ///< Simulated network conditions
+    std::mt19937 random;                         ///< Jitter and loss random generator
+    std::vector<Datagram> queue;                 ///< Packets in flight
+    std::uint64_t forwarded;                     ///< Packets delivered
+    std::uint64_t dropped;                       ///< Packets lost on purpose
+
+public:
+    /**
+     * @brief Constructor - creates an unbound proxy
+     * @param proxy_config Network conditions to simulate
+     * @param seed Seed of the jitter and loss random generator
+     */
+    explicit LatencyProxy(const ProxyConfig& proxy_config = ProxyConfig(), std::uint32_t seed = 1);
+
+    /**
+     * @brief Starts listening and sets where client packets go
+     * @param port Port clients send to (0 = any free port)
+     * @param address Target address
+     * @param target Target port
+     * @return True if the port could be bound
+     */
+    bool open(unsigned short port, const IpAddress& address, unsigned short target);
+
+    /**
+     * @brief Receives waiting packets and forwards those that are due
+     * @param now Current time
+     */
+    void pump(std::chrono::steady_clock::time_point now);
+
+    /**
+     * @brief Gets the port clients send to
+     * @return Local UDP port
+     */
+    unsigned short getLocalPort() const { return socket.getLocalPort(); }
+
+    /**
+     * @brief Gets the number of packets delivered
+     * @return Packets forwarded in either direction
+     */
+    std::uint64_t getForwarded() const { return forwarded; }
+
+    /**
+     * @brief Gets the number of packets dropped on purpose
+     * @return Packets lost in either direction
+     */
+    std::uint64_t getDropped() const { return dropped; }
+};
@@ -0,0 +1,147 @@
+/**
+ * @file LookaheadBot.cpp
+ * @brief Implementation of the LookaheadBot class for Flappy Bird 2-player game
+ *
+ * This file contains the rollout search used by lookahead bot players.
+ */
+
+#include "LookaheadBot.h"
+#include "Globals.h"
+#include "SplitMix64.h"
+#include <algorithm>
+
+/**
+ * @brief Constructor - creates a bot for one bird
+ * @param player Bird to control (0 or 1)
+ * @param seed Seed for the rollout policy
+ * @param rollouts Futures tried per tick
+ * @param horizon Ticks each future is played out for (at most max_horizon)
+ */
+LookaheadBot::LookaheadBot(int player, std::uint64_t seed, int rollouts, int horizon) :
+player(player),
+rollouts(rollouts),
+horizon(std::min(horizon, max_horizon)),
+plan_length(0),
+state(seed)
+{
+    for (int word = 0; word < plan_words; word++)
+        plan[word] = 0;
+}
+
+/**
+ * @brief Plays out one future
+ * @param model Rules of the match
+ * @param root State to start from (copied)
+ * @param prefix Inputs of the first ticks, one bit per tick
+ * @param prefix_length Number of ticks taken from prefix
+ * @param moves Receives the input of every tick played, one bit per tick
+ * @return Ticks the bird survived, up to horizon
+ *
+ * After the prefix the bird follows the rule-based bot's policy: flap
+ * when below an aim line in the next gap, unless still rising fast. The
+ * aim line's depth in the gap is drawn again every 24 ticks, so the
+ * rollouts cover high, low and changing lines through each gap.
+ */
+int LookaheadBot::rollout(const RolloutModel& model, const RolloutState& root,
+                          const std::uint64_t* prefix, int prefix_length, std::uint64_t* moves)
+{
+    RolloutState future = root;
+    for (int word = 0; word < plan_words; word++)
+        moves[word] = 0;
+
+    float depth = 0.f;
+    int tick = 0;
+    for (; tick < horizon && future.alive; tick++)
+    {
+        bool flap;
+        if (tick < prefix_length)
+        {
+            flap = (prefix[tick / 64] >> (tick % 64)) & 1;
+        }
+        else
+        {
+            if ((tick - prefix_length) % 24 == 0)
+                depth = static_cast<float>(splitMix64Next(state) >> 40) / (1 << 24);
+            float target = 300.f;
+            if (future.first_pipe < future.pipe_end)
+            {
+                const RolloutPipe& next = future.pipes[future.first_pipe];
+                target = next.gap_top + (next.gap_bottom - next.gap_top - bird_height) * depth;
+            }
+            flap = future.y > target && future.velocity > -200.f;
+        }
+        moves[tick / 64] |= static_cast<std::uint64_t>(flap) << (tick % 64);
+        model.step(future, flap);
+    }
+    return future.alive ? horizon : tick;
+}
+
+/**
+ * @brief Decides whether the bot's bird should flap this tick
+ * @param sim Match being played
+ * @return True to flap
+ *
+ * The first rollout replays the plan kept from the previous tick, so a
+ * way through found once is not lost to the luck of later draws. The
+ * rest alternate between starting with and without a flap. The plan
+ * kept for the next tick is the best rollout of the chosen input.
+ * Does no search before the bird's first start or after it is out.
+ * When both choices look equally good the bot does not flap.
+ */
+bool LookaheadBot::shouldFlap(const Simulation& sim)
+{
+    const BirdState& bird = sim.getBird(player);
+    if (!bird.active || !bird.flying)
+    {
+        plan_length = 0;
+        return false;
+    }
+
+    RolloutModel model(sim, player);
+    RolloutState root;
+    model.capture(sim, player, root);
+
+    std::uint64_t moves[plan_words];
+    std::uint64_t best_moves[2][plan_words] = {};
+    int best[2] = { -1, -1 };
+    long total[2] = { 0, 0 };
+    for (int i = -1; i < rollouts; i++)
+    {
+        std::uint64_t first = static_cast<std::uint64_t>(i & 1);
+        int survived = i < 0 ? rollout(model, root, plan, plan_length, moves)
+                             : rollout(model, root, &first, 1, moves);
+        int choice = static_cast<int>(moves[0] & 1);
+        total[choice] += survived;
+        if (survived > best[choice])
+        {
+            best[choice] = survived;
+            for (int word = 0; word < plan_words; word++)
+                best_moves[choice][word] = moves[word];
+        }
+    }
+
+    bool flap = best[1] != best[0] ? best[1] > best[0] : total[1] > total[0];
+
+    // Keep the rest of the chosen rollout as the next tick's plan
+    const std::uint64_t* chosen = best_moves[flap ? 1 : 0];
+    for (int word = 0; word < plan_words; word++)
+        plan[word] = (chosen[word] >> 1) | (word + 1 < plan_words ? chosen[word + 1] << 63 : 0);
+    plan_length = std::max(0, best[flap ? 1 : 0] - 1);
+    return flap;
+}
+
+/**
+ * @brief Fills in the bot's part of the next tick's input
+ * @param sim Match being played
+ * @param input Input to update (start and the bot's flap flag)
+ *
+ * Also presses Enter whenever the match is paused by a collision
+ * while a player is still in, so bot matches never stall.
+ */
+void LookaheadBot::play(const Simulation& sim, SimInput& input)
+{
+    if (!sim.isRunning() && !sim.isOver())
+        input.start = true;
+    if (shouldFlap(sim))
+        input.flap[player] = true;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file LookaheadBot.h
+ * @brief Header file for the LookaheadBot class in Flappy Bird 2-player game
+ *
+ * This file defines a search-based player that can drive either bird of
+ * a Simulation: each tick it plays out many random futures and picks
+ * the input whose futures survive longest.
+ */
+
+#pragma once
+#include <cstdint>
+#include "Rollout.h"
+#include "Simulation.h"
+
+/**
+ * @class LookaheadBot
+ * @brief Monte Carlo player that tries both inputs before every tick
+ *
+ * For each choice (flap or not) the bot runs half its rollouts from a
+ * copy of the bird's RolloutState: the choice first, then a randomized
+ * version of the rule-based policy for the rest of the horizon. A choice
+ * is scored by its best rollout's survival time, since the bot gets to
+ * choose every later input as well, with the average survival breaking
+ * ties between choices that both reach the horizon. The best rollout is
+ * kept as a plan and tried again on the next tick. Rollouts are seeded,
+ * so a bot plays a given match the same way every time.
+ */
+class LookaheadBot
+{
+public:
+    static constexpr int max_horizon = 256;   ///< Longest horizon a plan can hold
+
+private:
+    static constexpr int plan_words = max_horizon / 64;   ///< Words of one tick-per-bit input sequence
+
+    int player;              ///< Bird controlled by the bot (0 or 1)
+    int rollouts;            ///< Futures tried per tick, split between both choices
+    int horizon;             ///< Ticks each future is played out for
+    std::uint64_t plan[plan_words];   ///< Inputs of the best future found last tick, from this tick on
+    int plan_length;         ///< Ticks of plan known to survive
+    std::uint64_t state;     ///< State of the bot's private random generator
+
+    /**
+     * @brief Plays out one future
+     * @param model Rules of the match
+     * @param root State to start from (copied)
+     * @param prefix Inputs of the first ticks, one bit per tick
+     * @param prefix_length Number of ticks taken from prefix
+     * @param moves Receives the input of every tick played, one bit per tick
+     * @return Ticks the bird survived, up to horizon
+     */
+    int rollout(const RolloutModel& model, const RolloutState& root,
+                const std::uint64_t* prefix, int prefix_length, std::uint64_t* moves);
+
+public:
+    /**
+     * @brief Constructor - creates a bot for one bird
+     * @param player Bird to control (0 or 1)
+     * @param seed Seed for the rollout policy
+     * @param rollouts Futures tried per tick
+     * @param horizon Ticks each future is played out for (at most max_horizon)
+     */
+    LookaheadBot(int player, std::uint64_t seed = 0, int rollouts = 256, int horizon = max_horizon);
+
+    /**
+     * @brief Gets the bird the bot controls
+     * @return Player index (0 or 1)
+     */
+    int getPlayer() const { return player; }
+
+    /**
+     * @brief Decides whether the bot's bird should flap this tick
+     * @param sim Match being played
+     * @return True to flap
+     */
+    bool shouldFlap(const Simulation& sim);
+
+    /**
+     * @brief Fills in the bot's part of the next tick's input
+     * @param sim Match being played
+     * @param input Input to update (start and the bot's flap flag)
+     */
+    void play(const Simulation& sim, SimInput& input);
+};
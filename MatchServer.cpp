@@ -0,0 +1,559 @@
+/**
+ * @file MatchServer.cpp
+ * @brief Implementation of the headless match server for Flappy Bird 2-player game
+ *
+ * This file contains the event loop, match stepping and the packet
+ * encoding. Every packet starts with "FS" and a type byte; integers are
+ * little-endian:
+ *   - join:    u32 match key
+ *   - welcome: u32 match key, u16 slot, u8 player, u32 token
+ *   - full:    u32 match key
+ *   - input:   u16 slot, u8 player, u32 token, u32 newest state tick held,
+ *              u16 key packet number, u8 key bits (server_key_*)
+ *   - state:   u8 player, u16 last key packet applied, u32 base tick
+ *              (0 = empty base), u32 checksum of the full state, WireState delta
+ */
+
+#include "MatchServer.h"
+#include "ByteOrder.h"
+#include "SplitMix64.h"
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+static const WireState empty_state;                     ///< Base of full-state deltas
+static const int max_catch_up = Simulation::tick_rate / 4;  ///< Most missed ticks run at once
+
+/**
+ * @brief Checks whether two socket addresses are the same endpoint
+ * @param a First address
+ * @param b Second address
+ * @return True if address and port match
+ */
+static bool sameEndpoint(const sockaddr_in& a, const sockaddr_in& b)
+{
+    return a.sin_addr.s_addr == b.sin_addr.s_addr && a.sin_port == b.sin_port;
+}
+
+/**
+ * @brief Constructor - allocates every match slot
+ * @param server_config Port, capacity and pacing
+ */
+MatchServer::MatchServer(const ServerConfig& server_config) :
+config(server_config),
+socket_fd(-1),
+epoll_fd(-1),
+timer_fd(-1),
+key_mask(1),
+clients(0),
+pool(server_config.threads),
+random(std::random_device()()),
+tick(0)
+{
+    config.send_interval = std::max(1, config.send_interval);
+    config.max_matches = std::min<std::size_t>(config.max_matches, max_slots);
+    matches.reserve(config.max_matches);
+    free_slots.reserve(config.max_matches);
+    live.reserve(config.max_matches);
+
+    // At most half full, so probes stay short
+    while (key_mask + 1 < 2 * config.max_matches)
+        key_mask = 2 * key_mask + 1;
+    keys.assign(key_mask + 1, KeyEntry{ 0, no_slot });
+    for (std::size_t i = 0; i < config.max_matches; i++)
+    {
+        matches.push_back(std::unique_ptr<Match>(new Match()));
+        free_slots.push_back(static_cast<std::uint32_t>(config.max_matches - 1 - i));   // Lowest slot first
+    }
+    for (unsigned i = 0; i < pool.getThreadCount(); i++)
+        outboxes.push_back(std::unique_ptr<Outbox>(new Outbox()));
+}
+
+/**
+ * @brief Destructor - closes the socket and event loop
+ */
+MatchServer::~MatchServer()
+{
+    for (int fd : { timer_fd, epoll_fd, socket_fd })
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+}
+
+/**
+ * @brief Binds the socket and starts the tick timer
+ * @return True if the server is ready
+ */
+bool MatchServer::open()
+{
+    socket_fd = socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+    if (socket_fd < 0)
+        return false;
+    sockaddr_in address = {};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(config.port);
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(socket_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        return false;
+
+    // Every client's keys can arrive while a tick runs; the kernel caps this at net.core.rmem_max
+    int buffer_size = socket_buffer;
+    setsockopt(socket_fd, SOL_SOCKET, SO_RCVBUF, &buffer_size, sizeof(buffer_size));
+    setsockopt(socket_fd, SOL_SOCKET, SO_SNDBUF, &buffer_size, sizeof(buffer_size));
+
+    timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (timer_fd < 0)
+        return false;
+    itimerspec interval = {};
+    interval.it_interval.tv_nsec = 1000000000L / Simulation::tick_rate;
+    interval.it_value = interval.it_interval;
+    if (timerfd_settime(timer_fd, 0, &interval, nullptr) != 0)
+        return false;
+
+    epoll_fd = epoll_create1(0);
+    if (epoll_fd < 0)
+        return false;
+    for (int fd : { socket_fd, timer_fd })
+    {
+        epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Gets the port clients send to
+ * @return Bound UDP port (0 before open())
+ */
+unsigned short MatchServer::getPort() const
+{
+    sockaddr_in address = {};
+    socklen_t length = sizeof(address);
+    if (socket_fd < 0 || getsockname(socket_fd, reinterpret_cast<sockaddr*>(&address), &length) != 0)
+        return 0;
+    return ntohs(address.sin_port);
+}
+
+/**
+ * @brief Waits for the next event and handles it
+ * @param timeout_ms Most milliseconds to wait
+ *
+ * Packets are handled between ticks on this thread, so workers never
+ * see a match change under them.
+ */
+void MatchServer::update(int timeout_ms)
+{
+    epoll_event events[2];
+    int count = epoll_wait(epoll_fd, events, 2, timeout_ms);
+    for (int i = 0; i < count; i++)
+    {
+        if (events[i].data.fd == socket_fd)
+        {
+            receive();
+        }
+        else if (events[i].data.fd == timer_fd)
+        {
+            std::uint64_t expirations = 0;
+            if (read(timer_fd, &expirations, sizeof(expirations)) != sizeof(expirations))
+                continue;
+            for (std::uint64_t t = 0; t < std::min<std::uint64_t>(expirations, max_catch_up); t++)
+                runTick();
+        }
+    }
+}
+
+/**
+ * @brief Steps every open match once and sends due states
+ *
+ * Matches are dealt to the workers in chunks; each worker queues and
+ * sends the packets of its own matches. Once a second, silent clients
+ * are dropped.
+ */
+void MatchServer::runTick()
+{
+    auto started = std::chrono::steady_clock::now();
+
+    pool.parallelFor(live.size(), 16, [this](std::size_t begin, std::size_t end, unsigned worker)
+    {
+        Outbox& outbox = *outboxes[worker];
+        for (std::size_t i = begin; i < end; i++)
+            stepMatch(*matches[live[i]], outbox);
+        flush(outbox);
+    });
+
+    stats.match_ticks += live.size();
+    tick++;
+    stats.ticks = tick;
+    if (tick % Simulation::tick_rate == 0)
+        expire();
+
+    stats.packets_out = 0;
+    stats.bytes_out = 0;
+    for (const std::unique_ptr<Outbox>& outbox : outboxes)
+    {
+        stats.packets_out += outbox->packets;
+        stats.bytes_out += outbox->bytes;
+    }
+    stats.tick_time += std::chrono::steady_clock::now() - started;
+}
+
+/**
+ * @brief Steps one match and queues its state for each client when due
+ * @param match Match to step
+ * @param outbox Outbox of the calling worker
+ *
+ * States are sent on match ticks that are multiples of send_interval,
+ * so a state's tick also says where it is kept in the history.
+ */
+void MatchServer::stepMatch(Match& match, Outbox& outbox)
+{
+    match.sim.step(match.pending);
+    match.pending = SimInput();
+
+    std::uint64_t now = match.sim.getTick();
+    if (now % config.send_interval != 0)
+        return;
+    WireState& state = match.sent[(now / config.send_interval) % history];
+    state.capture(match.sim);
+    std::uint32_t checksum = state.checksum();
+
+    for (int player = 0; player < 2; player++)
+    {
+        const Seat& seat = match.seats[player];
+        if (!seat.taken)
+            continue;
+
+        // Delta against the newest state the client holds, if still in the history
+        std::uint32_t base_tick = seat.acked;
+        const WireState* base = &match.sent[(base_tick / config.send_interval) % history];
+        if (base_tick == 0 || base_tick >= now || base->getTick() != base_tick)
+        {
+            base_tick = 0;
+            base = &empty_state;
+        }
+
+        std::uint8_t* packet = queue(outbox, seat.address);
+        packet[0] = 'F';
+        packet[1] = 'S';
+        packet[2] = server_state;
+        packet[3] = static_cast<std::uint8_t>(player);
+        putLE(packet + 4, seat.last_seq, 2);
+        putLE(packet + 6, base_tick, 4);
+        putLE(packet + 10, checksum, 4);
+        std::size_t size = 14 + WireState::encodeDelta(*base, state, packet + 14);
+        outbox.vectors[outbox.count - 1].iov_len = size;
+        outbox.bytes += size;
+    }
+}
+
+/**
+ * @brief Queues a packet in a worker's outbox, sending the batch when full
+ * @param outbox Outbox of the calling worker
+ * @param address Destination
+ * @return Buffer of max_packet bytes to fill; set its size in the last vector
+ */
+std::uint8_t* MatchServer::queue(Outbox& outbox, const sockaddr_in& address)
+{
+    if (outbox.count == batch)
+        flush(outbox);
+
+    int i = outbox.count++;
+    outbox.addresses[i] = address;
+    outbox.vectors[i].iov_base = outbox.buffers[i];
+    outbox.vectors[i].iov_len = max_packet;
+    mmsghdr& header = outbox.headers[i];
+    header = mmsghdr();
+    header.msg_hdr.msg_name = &outbox.addresses[i];
+    header.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+    header.msg_hdr.msg_iov = &outbox.vectors[i];
+    header.msg_hdr.msg_iovlen = 1;
+    return outbox.buffers[i];
+}
+
+/**
+ * @brief Sends every queued packet of an outbox
+ * @param outbox Outbox to empty
+ *
+ * One system call per batch. Packets the kernel refuses (full send
+ * buffer) are dropped; clients recover from the next state.
+ */
+void MatchServer::flush(Outbox& outbox)
+{
+    int sent = 0;
+    while (sent < outbox.count)
+    {
+        int result = sendmmsg(socket_fd, outbox.headers + sent, static_cast<unsigned>(outbox.count - sent), 0);
+        if (result <= 0)
+            break;
+        sent += result;
+    }
+    outbox.packets += static_cast<std::uint64_t>(sent);
+    outbox.count = 0;
+}
+
+/**
+ * @brief Reads and handles every waiting packet
+ */
+void MatchServer::receive()
+{
+    static const std::size_t buffer_size = 64;
+    mmsghdr headers[batch];
+    iovec vectors[batch];
+    sockaddr_in senders[batch];
+    std::uint8_t buffers[batch][buffer_size];
+
+    while (true)
+    {
+        for (int i = 0; i < batch; i++)
+        {
+            vectors[i].iov_base = buffers[i];
+            vectors[i].iov_len = buffer_size;
+            headers[i] = mmsghdr();
+            headers[i].msg_hdr.msg_name = &senders[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            headers[i].msg_hdr.msg_iov = &vectors[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        int count = recvmmsg(socket_fd, headers, batch, 0, nullptr);
+        if (count <= 0)
+            return;   // EAGAIN: drained
+        stats.packets_in += static_cast<std::uint64_t>(count);
+        for (int i = 0; i < count; i++)
+        {
+            if (headers[i].msg_hdr.msg_namelen == sizeof(sockaddr_in))
+                handle(buffers[i], headers[i].msg_len, senders[i]);
+        }
+        if (count < batch)
+            return;
+    }
+}
+
+/**
+ * @brief Handles one packet
+ * @param data Packet bytes
+ * @param size Packet size in bytes
+ * @param sender Where it came from
+ */
+void MatchServer::handle(const std::uint8_t* data, std::size_t size, const sockaddr_in& sender)
+{
+    if (size < 3 || data[0] != 'F' || data[1] != 'S')
+        return;
+    if (data[2] == server_join && size >= 7)
+        join(static_cast<std::uint32_t>(getLE(data + 3, 4)), sender);
+    else if (data[2] == server_input && size >= 17)
+        applyInput(data, sender);
+}
+
+/**
+ * @brief Gets the key table cell where a key's probe starts
+ * @param key Match key
+ * @return Cell index
+ */
+std::size_t MatchServer::getHome(std::uint32_t key) const
+{
+    return static_cast<std::size_t>(splitMix64Finish(key)) & key_mask;
+}
+
+/**
+ * @brief Looks up the match opened with a key
+ * @param key Match key
+ * @return Slot of the match, or no_slot if no open match has the key
+ */
+std::uint32_t MatchServer::findKey(std::uint32_t key) const
+{
+    for (std::size_t i = getHome(key); keys[i].slot != no_slot; i = (i + 1) & key_mask)
+    {
+        if (keys[i].key == key)
+            return keys[i].slot;
+    }
+    return no_slot;
+}
+
+/**
+ * @brief Adds a key to the key table
+ * @param key Match key, not in the table
+ * @param slot Slot of the match
+ *
+ * The table has twice as many cells as match slots, so a free cell
+ * always exists.
+ */
+void MatchServer::addKey(std::uint32_t key, std::uint32_t slot)
+{
+    std::size_t i = getHome(key);
+    while (keys[i].slot != no_slot)
+        i = (i + 1) & key_mask;
+    keys[i] = KeyEntry{ key, slot };
+}
+
+/**
+ * @brief Removes a key from the key table
+ * @param key Match key
+ *
+ * Entries after the hole that could not be placed at or before it are
+ * shifted back, so lookups never need tombstones.
+ */
+void MatchServer::removeKey(std::uint32_t key)
+{
+    std::size_t hole = getHome(key);
+    while (keys[hole].slot != no_slot && keys[hole].key != key)
+        hole = (hole + 1) & key_mask;
+    if (keys[hole].slot == no_slot)
+        return;
+
+    keys[hole].slot = no_slot;
+    for (std::size_t i = (hole + 1) & key_mask; keys[i].slot != no_slot; i = (i + 1) & key_mask)
+    {
+        // Move the entry into the hole unless its home lies between the two
+        std::size_t home = getHome(keys[i].key);
+        if (((i - home) & key_mask) >= ((i - hole) & key_mask))
+        {
+            keys[hole] = keys[i];
+            keys[i].slot = no_slot;
+            hole = i;
+        }
+    }
+}
+
+/**
+ * @brief Seats a client in the match with a key, opening the match if needed
+ * @param key Match key
+ * @param sender Client address
+ *
+ * A repeated join from a seated client (whose welcome was lost) gets
+ * the same seat again.
+ */
+void MatchServer::join(std::uint32_t key, const sockaddr_in& sender)
+{
+    std::uint8_t reply[14] = { 'F', 'S', server_full };
+    putLE(reply + 3, key, 4);
+    std::size_t reply_size = 7;
+
+    std::uint32_t slot = findKey(key);
+    if (slot == no_slot && !free_slots.empty())
+    {
+        slot = free_slots.back();
+        free_slots.pop_back();
+        live.push_back(slot);
+        addKey(key, slot);
+
+        Match& match = *matches[slot];
+        match.sim.reset(random());
+        match.pending = SimInput();
+        match.key = key;
+        for (Seat& seat : match.seats)
+            seat.taken = false;
+        for (WireState& state : match.sent)
+            state = WireState();
+    }
+    else if (slot == no_slot)
+    {
+        sendto(socket_fd, reply, reply_size, 0, reinterpret_cast<const sockaddr*>(&sender), sizeof(sender));
+        return;
+    }
+
+    Match& match = *matches[slot];
+    int player = -1;
+    for (int p = 0; p < 2 && player < 0; p++)
+    {
+        if (match.seats[p].taken && sameEndpoint(match.seats[p].address, sender))
+            player = p;
+    }
+    for (int p = 0; p < 2 && player < 0; p++)
+    {
+        if (!match.seats[p].taken)
+        {
+            Seat& seat = match.seats[p];
+            seat.address = sender;
+            seat.token = static_cast<std::uint32_t>(random());
+            seat.last_seq = 0;
+            seat.acked = 0;
+            seat.taken = true;
+            clients++;
+            player = p;
+        }
+    }
+
+    if (player >= 0)
+    {
+        Seat& seat = match.seats[player];
+        seat.last_heard = tick;
+        reply[2] = server_welcome;
+        putLE(reply + 7, slot, 2);
+        reply[9] = static_cast<std::uint8_t>(player);
+        putLE(reply + 10, seat.token, 4);
+        reply_size = 14;
+    }
+    sendto(socket_fd, reply, reply_size, 0, reinterpret_cast<const sockaddr*>(&sender), sizeof(sender));
+}
+
+/**
+ * @brief Applies a client's keys and acknowledgement
+ * @param data Packet bytes (at least 17)
+ * @param sender Client address
+ *
+ * Key packets are numbered; only the one after the last applied number
+ * is applied, so resent packets count once. The keys apply to the next
+ * tick.
+ */
+void MatchServer::applyInput(const std::uint8_t* data, const sockaddr_in& sender)
+{
+    std::uint32_t slot = static_cast<std::uint32_t>(getLE(data + 3, 2));
+    int player = data[5];
+    if (slot >= matches.size() || player > 1)
+        return;
+    Match& match = *matches[slot];
+    Seat& seat = match.seats[player];
+    if (!seat.taken || seat.token != getLE(data + 6, 4) || !sameEndpoint(seat.address, sender))
+        return;
+
+    seat.last_heard = tick;
+    std::uint32_t acked = static_cast<std::uint32_t>(getLE(data + 10, 4));
+    if (acked > seat.acked && acked <= match.sim.getTick())
+        seat.acked = acked;
+
+    std::uint16_t seq = static_cast<std::uint16_t>(getLE(data + 14, 2));
+    if (seq != static_cast<std::uint16_t>(seat.last_seq + 1))
+        return;
+    seat.last_seq = seq;
+    std::uint8_t bits = data[16];
+    match.pending.start = match.pending.start || (bits & server_key_start);
+    match.pending.flap[player] = match.pending.flap[player] || (bits & server_key_flap);
+    match.pending.restart = match.pending.restart || (bits & server_key_restart);
+}
+
+/**
+ * @brief Frees the seats of silent clients and closes empty matches
+ */
+void MatchServer::expire()
+{
+    for (std::size_t i = live.size(); i-- > 0;)
+    {
+        Match& match = *matches[live[i]];
+        bool empty = true;
+        for (Seat& seat : match.seats)
+        {
+            if (seat.taken && tick - seat.last_heard > static_cast<std::uint64_t>(config.client_timeout))
+            {
+                seat.taken = false;
+                clients--;
+            }
+            empty = empty && !seat.taken;
+        }
+        if (empty)
+        {
+            removeKey(match.key);
+            free_slots.push_back(live[i]);
+            live[i] = live.back();
+            live.pop_back();
+        }
+    }
+}
@@ -0,0 +1,306 @@
+/**
+ * @file MatchServer.h
+ * @brief Header file for the MatchServer class in Flappy Bird 2-player game
+ *
+ * This file defines a headless server that referees many independent
+ * matches at once: clients join a match by key, send their keys, and
+ * receive the match state as compact deltas. It runs on an epoll event
+ * loop and steps the matches on a WorkStealingPool.
+ *
+ * The server talks to sockets directly through Linux system calls
+ * (epoll, timerfd, recvmmsg, sendmmsg), since SFML sockets do not expose
+ * their descriptors; it builds on Linux only.
+ */
+
+#pragma once
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+#include "Simulation.h"
+#include "WireState.h"
+#include "WorkStealingPool.h"
+
+/// Server packet types, the third byte of every packet after the 'F', 'S' magic
+constexpr std::uint8_t server_join = 1;       ///< Client asks for a seat: match key
+constexpr std::uint8_t server_welcome = 2;    ///< Seat granted: match key, slot, player, token
+constexpr std::uint8_t server_full = 3;       ///< No seat left in the match or on the server: match key
+constexpr std::uint8_t server_input = 4;      ///< Client keys and acknowledgement of the newest state
+constexpr std::uint8_t server_state = 5;      ///< State delta for one client
+
+/// Key bits of a server_input packet
+constexpr std::uint8_t server_key_start = 1 << 0;     ///< Enter pressed
+constexpr std::uint8_t server_key_flap = 1 << 1;      ///< Own bird's flap key pressed
+constexpr std::uint8_t server_key_restart = 1 << 2;   ///< R pressed
+
+/**
+ * @struct ServerConfig
+ * @brief Port, capacity and pacing of a MatchServer
+ */
+struct ServerConfig
+{
+    unsigned short port = 7100;                      ///< UDP port clients send to
+    unsigned threads = 1;                            ///< Workers stepping matches (0 = one per hardware thread)
+    std::size_t max_matches = 1024;                  ///< Matches allocated up front (at most MatchServer::max_slots)
+    int send_interval = 2;                           ///< Ticks between state packets (2 = 60 per second)
+    int client_timeout = 10 * Simulation::tick_rate; ///< Ticks of silence before a client loses its seat
+};
+
+/**
+ * @struct ServerStats
+ * @brief Running totals of a MatchServer's work
+ */
+struct ServerStats
+{
+    std::uint64_t ticks = 0;                         ///< Server ticks run
+    std::uint64_t match_ticks = 0;                   ///< Match steps over all matches
+    std::uint64_t packets_in = 0;                    ///< Packets received
+    std::uint64_t packets_out = 0;                   ///< Packets sent
+    std::uint64_t bytes_out = 0;                     ///< Payload bytes sent
+    std::chrono::nanoseconds tick_time{0};           ///< Time spent stepping matches and sending states
+};
+
+/**
+ * @class MatchServer
+ * @brief Authoritative host of many two-player matches over one UDP socket
+ *
+ * A client joins with a match key (a cabinet number, say); the first two
+ * clients with the same key share a match, flying bird 0 and bird 1. The
+ * server owns every Simulation: clients only send keys and draw what
+ * they are sent.
+ *
+ * Every tick (a timerfd at the simulation tick rate) all open matches
+ * step in parallel. Every send_interval ticks each client gets the
+ * match's WireState as a delta against the newest state it acknowledged,
+ * or against an empty state if that one is too old; each packet carries
+ * a checksum of the full state. Keys are numbered and resent until
+ * acknowledged, so lost packets in either direction cost only latency.
+ *
+ * Every match, its Simulation, its history of sent states and its
+ * place in the key table are allocated when the server is created, and
+ * the tick loop deals matches to the workers without queuing anything,
+ * so joining, playing and leaving allocate nothing. Matches whose
+ * clients all went silent are closed.
+ */
+class MatchServer
+{
+public:
+    static constexpr long max_slots = 65536;         ///< Most matches; slots go over the wire as 16 bits
+    static constexpr int history = 32;               ///< Sent states kept per match as delta bases
+    static constexpr std::size_t max_packet = 14 + WireState::max_delta;  ///< Largest state packet
+    static constexpr int batch = 64;                 ///< Packets per recvmmsg/sendmmsg call
+    static constexpr int socket_buffer = 4 << 20;    ///< Socket buffer bytes asked of the kernel
+    static constexpr std::uint32_t no_slot = ~0u;    ///< Slot of an empty key table cell
+
+private:
+    /**
+     * @struct Seat
+     * @brief One client's place in a match
+     */
+    struct Seat
+    {
+        sockaddr_in address;                         ///< Where the client's packets come from
+        std::uint32_t token;                         ///< Random value the client must echo
+        std::uint16_t last_seq;                      ///< Number of the last key packet applied
+        std::uint32_t acked;                         ///< Newest state tick the client has
+        std::uint64_t last_heard;                    ///< Server tick of the client's last packet
+        bool taken;                                  ///< True while a client holds the seat
+    };
+
+    /**
+     * @struct Match
+     * @brief A match slot
+     */
+    struct Match
+    {
+        Simulation sim;                              ///< Match rules and state
+        SimInput pending;                            ///< Keys for the next step
+        Seat seats[2];                               ///< Clients flying bird 0 and bird 1
+        std::uint32_t key;                           ///< Key clients joined with
+        WireState sent[history];                     ///< Recently sent states, by tick / send_interval
+    };
+
+    /**
+     * @struct KeyEntry
+     * @brief One cell of the match key table
+     */
+    struct KeyEntry
+    {
+        std::uint32_t key;                           ///< Match key
+        std::uint32_t slot;                          ///< Slot of the match, or no_slot if the cell is empty
+    };
+
+    /**
+     * @struct Outbox
+     * @brief One worker's packets waiting for a sendmmsg call
+     */
+    struct Outbox
+    {
+        mmsghdr headers[batch];                      ///< Message headers
+        iovec vectors[batch];                        ///< One buffer per message
+        sockaddr_in addresses[batch];                ///< Destination of each message
+        std::uint8_t buffers[batch][max_packet];     ///< Packet bytes
+        int count = 0;                               ///< Messages waiting
+        std::uint64_t packets = 0;                   ///< Packets sent by this worker
+        std::uint64_t bytes = 0;                     ///< Bytes sent by this worker
+    };
+
+    ServerConfig config;                             ///< Port, capacity and pacing
+    int socket_fd;                                   ///< UDP socket
+    int epoll_fd;                                    ///< Event loop
+    int timer_fd;                                    ///< Tick timer
+    std::vector<std::unique_ptr<Match>> matches;     ///< Every match slot
+    std::vector<std::uint32_t> free_slots;           ///< Slots not in use
+    std::vector<std::uint32_t> live;                 ///< Slots in use
+    std::vector<KeyEntry> keys;                      ///< Slot of each open match key, linear probing, at most half full
+    std::size_t key_mask;                            ///< keys.size() - 1 (a power of two minus one)
+    std::size_t clients;                             ///< Seats taken over all matches
+    WorkStealingPool pool;                           ///< Workers stepping matches
+    std::vector<std::unique_ptr<Outbox>> outboxes;   ///< One per worker
+    std::mt19937_64 random;                          ///< Seeds and tokens
+    std::uint64_t tick;                              ///< Server ticks run
+    ServerStats stats;                               ///< Running totals
+
+    /**
+     * @brief Steps every open match once and sends due states
+     */
+    void runTick();
+
+    /**
+     * @brief Steps one match and queues its state for each client when due
+     * @param match Match to step
+     * @param outbox Outbox of the calling worker
+     */
+    void stepMatch(Match& match, Outbox& outbox);
+
+    /**
+     * @brief Queues a packet in a worker's outbox, sending the batch when full
+     * @param outbox Outbox of the calling worker
+     * @param address Destination
+     * @return Buffer of max_packet bytes to fill; set its size in the last vector
+     */
+    std::uint8_t* queue(Outbox& outbox, const sockaddr_in& address);
+
+    /**
+     * @brief Sends every queued packet of an outbox
+     * @param outbox Outbox to empty
+     */
+    void flush(Outbox& outbox);
+
+    /**
+     * @brief Reads and handles every waiting packet
+     */
+    void receive();
+
+    /**
+     * @brief Handles one packet
+     * @param data Packet bytes
+     * @param size Packet size in bytes
+     * @param sender Where it came from
+     */
+    void handle(const std::uint8_t* data, std::size_t size, const sockaddr_in& sender);
+
+    /**
+     * @brief Gets the key table cell where a key's probe starts
+     * @param key Match key
+     * @return Cell index
+     */
+    std::size_t getHome(std::uint32_t key) const;
+
+    /**
+     * @brief Looks up the match opened with a key
+     * @param key Match key
+     * @return Slot of the match, or no_slot if no open match has the key
+     */
+    std::uint32_t findKey(std::uint32_t key) const;
+
+    /**
+     * @brief Adds a key to the key table
+     * @param key Match key, not in the table
+     * @param slot Slot of the match
+     */
+    void addKey(std::uint32_t key, std::uint32_t slot);
+
+    /**
+     * @brief Removes a key from the key table
+     * @param key Match key
+     */
+    void removeKey(std::uint32_t key);
+
+    /**
+     * @brief Seats a client in the match with a key, opening the match if needed
+     * @param key Match key
+     * @param sender Client address
+     */
+    void join(std::uint32_t key, const sockaddr_in& sender);
+
+    /**
+     * @brief Applies a client's keys and acknowledgement
+     * @param data Packet bytes (at least 17)
+     * @param sender Client address
+     */
+    void applyInput(const std::uint8_t* data, const sockaddr_in& sender);
+
+    /**
+     * @brief Frees the seats of silent clients and closes empty matches
+     */
+    void expire();
+
+public:
+    /**
+     * @brief Constructor - allocates every match slot
+     * @param server_config Port, capacity and pacing
+     */
+    explicit MatchServer(const ServerConfig& server_config = ServerConfig());
+
+    /**
+     * @brief Destructor - closes the socket and event loop
+     */
+    ~MatchServer();
+
+    MatchServer(const MatchServer&) = delete;
+    MatchServer& operator=(const MatchServer&) = delete;
+
+    /**
+     * @brief Binds the socket and starts the tick timer
+     * @return True if the server is ready
+     */
+    bool open();
+
+    /**
+     * @brief Waits for the next event and handles it
+     * @param timeout_ms Most milliseconds to wait
+     *
+     * Call in a loop. Ticks missed while the process was stalled are
+     * caught up, up to a quarter second's worth.
+     */
+    void update(int timeout_ms = 100);
+
+    /**
+     * @brief Gets the port clients send to
+     * @return Bound UDP port (0 before open())
+     */
+    unsigned short getPort() const;
+
+    /**
+     * @brief Gets the number of open matches
+     * @return Matches with at least one client
+     */
+    std::size_t getMatchCount() const { return live.size(); }
+
+    /**
+     * @brief Gets the number of connected clients
+     * @return Seats taken over all matches
+     */
+    std::size_t getClientCount() const { return clients; }
+
+    /**
+     * @brief Gets the running totals
+     * @return Counters since open()
+     */
+    const ServerStats& getStats() const { return stats; }
+};
@@ -0,0 +1,209 @@
+/**
+ * @file NetLoopback.cpp
+ * @brief Command-line loopback test of online play with rollback
+ *
+ * Runs a host and a guest NetPeer in one process, each with its own
+ * Simulation flown by a bot, and puts a LatencyProxy between them. Time
+ * is simulated - every loop iteration is one tick - so a minute of play
+ * with the chosen delay, jitter and loss runs in well under a second and
+ * plays out the same on any machine. Both peers' checkpoint hashes must
+ * agree for the whole match, and at least one must have been compared.
+ *
+ * Command line options:
+ *   --seconds <s>         Simulated seconds of play (default 60)
+ *   --delay <ms>          One-way delay added by the proxy (default 40)
+ *   --jitter <ms>         Extra random one-way delay (default 10)
+ *   --loss <p>            Chance of the proxy dropping a packet (default 0.02)
+ *   --input-delay <n>     Ticks between a key press and its tick (default 2)
+ *   --seed <n>            Pipe course and random seed (default 1)
+ *
+ * Exits with 0 if the peers stayed in sync, 1 on bad arguments or a desync.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "Bot.h"
+#include "LatencyProxy.h"
+#include "NetPeer.h"
+#include "Simulation.h"
+
+/**
+ * @struct LoopbackPlayer
+ * @brief One side of the loopback match
+ */
+struct LoopbackPlayer
+{
+    const char* name;         ///< Label in the report
+    NetPeer peer;             ///< Connection to the other side
+    Simulation sim;           ///< This side's copy of the match
+    Bot bot;                  ///< Flies this side's bird
+    bool started = false;     ///< True once the handshake completed and the match began
+
+    /**
+     * @brief Constructor - creates an unconnected side
+     * @param label Label in the report
+     * @param delay Ticks between a key press and its tick
+     * @param player Bird this side flies (0 or 1)
+     * @param seed Seed of the bot's aim jitter
+     */
+    LoopbackPlayer(const char* label, int delay, int player, std::uint64_t seed) :
+    name(label),
+    peer(delay),
+    bot(player, seed, 20.f)
+    {
+    }
+};
+
+/**
+ * @brief Plays one tick for one side, or moves its handshake along
+ * @param side Side to update
+ * @param keys_down True to let the bot press keys, false to idle
+ */
+static void updatePlayer(LoopbackPlayer& side, bool keys_down)
+{
+    if (!side.started)
+    {
+        if (side.peer.poll())
+        {
+            side.peer.start(side.sim);
+            side.started = true;
+        }
+        return;
+    }
+
+    // Start or restart every half second when needed, like an impatient player
+    SimInput keys;
+    if (keys_down)
+    {
+        bool half_second = side.sim.getTick() % (Simulation::tick_rate / 2) == 0;
+        keys.start = !side.sim.isRunning() && !side.sim.isOver() && half_second;
+        keys.restart = side.sim.isOver() && half_second;
+        keys.flap[0] = side.sim.isRunning() && side.bot.shouldFlap(side.sim);
+    }
+    side.peer.update(keys);
+}
+
+/**
+ * @brief Prints one side's rollback counters
+ * @param side Side to report
+ */
+static void report(const LoopbackPlayer& side)
+{
+    const RollbackSession* session = side.peer.getSession();
+    if (!session)
+    {
+        std::cout << std::setw(6) << side.name << " | never connected\n";
+        return;
+    }
+    const RollbackStats& stats = session->getStats();
+    std::cout << std::setw(6) << side.name << " |"
+              << std::setw(7) << side.sim.getTick()
+              << std::setw(10) << session->getConfirmedTick() << " |"
+              << std::setw(10) << stats.rollbacks
+              << std::setw(8) << stats.resimulated
+              << std::setw(7) << stats.max_depth << " |"
+              << std::setw(7) << stats.stalls
+              << std::setw(6) << stats.waits << " |"
+              << std::setw(7) << stats.checks << "\n";
+}
+
+/**
+ * @brief Main function - loopback test entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
+ * @return 0 if the peers stayed in sync, 1 on bad arguments or a desync
+ */
+int main(int argc, char* argv[])
+{
+    ProxyConfig proxy_config;
+    float seconds = 60.f;
+    int input_delay = 2;
+    std::uint64_t seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--seconds") seconds = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--delay") proxy_config.delay_ms = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--jitter") proxy_config.jitter_ms = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--loss") proxy_config.loss = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--input-delay") input_delay = std::atoi(value.c_str());
+        else if (arg == "--seed") seed = std::strtoull(value.c_str(), nullptr, 10);
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    // Guest -> proxy -> host, all on this machine
+    LoopbackPlayer host("host", input_delay, 0, seed);
+    LoopbackPlayer guest("guest", input_delay, 1, seed + 1);
+    LatencyProxy proxy(proxy_config, static_cast<std::uint32_t>(seed));
+    if (!host.peer.host(0, seed, false) ||
+        !proxy.open(0, IpAddress::LocalHost, host.peer.getLocalPort()) ||
+        !guest.peer.join(IpAddress::LocalHost, proxy.getLocalPort(), false))
+    {
+        std::cerr << "Could not bind loopback sockets" << std::endl;
+        return 1;
+    }
+
+    typedef std::chrono::steady_clock steady_clock;
+    const steady_clock::duration tick_length = std::chrono::duration_cast<steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / Simulation::tick_rate));
+    steady_clock::time_point now;   // Simulated clock, from the epoch
+
+    // Play, then idle for two seconds so the last presses get confirmed and checked
+    const long play_ticks = static_cast<long>(seconds * Simulation::tick_rate);
+    const long total_ticks = play_ticks + 2 * Simulation::tick_rate;
+    auto started = steady_clock::now();
+    for (long i = 0; i < total_ticks; i++)
+    {
+        now += tick_length;
+        proxy.pump(now);
+        updatePlayer(host, i < play_ticks);
+        updatePlayer(guest, i < play_ticks);
+    }
+    double ms = std::chrono::duration<double, std::milli>(steady_clock::now() - started).count();
+
+    std::cout << "  side |   tick confirmed | rollbacks  resim  depth | stalls waits | checks\n";
+    report(host);
+    report(guest);
+    std::cout << "proxy: " << proxy.getForwarded() << " packets forwarded, " << proxy.getDropped() << " dropped; "
+              << std::fixed << std::setprecision(0) << ms << " ms wall time\n";
+
+    const RollbackSession* host_session = host.peer.getSession();
+    const RollbackSession* guest_session = guest.peer.getSession();
+    if (!host_session || !guest_session)
+    {
+        std::cout << "FAILED: peers never connected\n";
+        return 1;
+    }
+
+    std::uint64_t desync = host_session->getDesyncTick() ? host_session->getDesyncTick() : guest_session->getDesyncTick();
+    if (desync != 0)
+    {
+        std::cout << "FAILED: desync at tick " << desync << "\n";
+        return 1;
+    }
+    std::uint64_t checks = std::min(host_session->getStats().checks, guest_session->getStats().checks);
+    if (checks == 0)
+    {
+        std::cout << "FAILED: no checkpoint was compared\n";
+        return 1;
+    }
+    std::cout << "in sync: " << checks << " checkpoints compared\n";
+    return 0;
+}
@@ -0,0 +1,193 @@
+/**
+ * @file NetPeer.cpp
+ * @brief Implementation of the UDP peer for online Flappy Bird matches
+ *
+ * This file contains the handshake and the per-tick packet exchange.
+ * Handshake packets:
+ *   - hello:   "FB", net_packet_hello, 1 byte flags (1 = has collision masks)
+ *   - welcome: "FB", net_packet_welcome, 1 byte flags (1 = pixel-exact collisions),
+ *              8 bytes little-endian pipe course seed
+ */
+
+#include "NetPeer.h"
+#include "ByteOrder.h"
+
+/**
+ * @brief Constructor - creates an unconnected peer
+ * @param delay Ticks between a key press and the tick it applies to
+ */
+NetPeer::NetPeer(int delay) :
+remote_port(0),
+hosting(false),
+connected(false),
+local_pixel(false),
+pixel_collision(false),
+seed(0),
+input_delay(delay),
+hello_wait(0),
+pending(0)
+{
+    socket.setBlocking(false);
+}
+
+/**
+ * @brief Waits for a guest on a port
+ * @param port UDP port to listen on (0 = any free port)
+ * @param match_seed Pipe course seed to hand the guest
+ * @param pixel True if this peer has collision masks
+ * @return True if the port could be bound
+ */
+bool NetPeer::host(unsigned short port, std::uint64_t match_seed, bool pixel)
+{
+    hosting = true;
+    connected = false;
+    seed = match_seed;
+    local_pixel = pixel;
+    return socket.bind(port) == Socket::Done;
+}
+
+/**
+ * @brief Starts joining a host
+ * @param address Host address
+ * @param port Host port
+ * @param pixel True if this peer has collision masks
+ * @return True if a local port could be bound
+ */
+bool NetPeer::join(const IpAddress& address, unsigned short port, bool pixel)
+{
+    hosting = false;
+    connected = false;
+    remote_address = address;
+    remote_port = port;
+    local_pixel = pixel;
+    hello_wait = 0;
+    return socket.bind(Socket::AnyPort) == Socket::Done;
+}
+
+/**
+ * @brief Sends a packet to the other peer
+ * @param data Packet bytes
+ * @param size Packet size in bytes
+ *
+ * A full send buffer or an unreachable peer just loses the packet; the
+ * next one repeats everything that matters.
+ */
+void NetPeer::send(const std::uint8_t* data, std::size_t size)
+{
+    socket.send(data, size, remote_address, remote_port);
+}
+
+/**
+ * @brief Sends the host's welcome with the match settings
+ */
+void NetPeer::sendWelcome()
+{
+    std::uint8_t packet[12] = { 'F', 'B', net_packet_welcome, static_cast<std::uint8_t>(pixel_collision ? 1 : 0) };
+    putLE(packet + 4, seed, 8);
+    send(packet, sizeof(packet));
+}
+
+/**
+ * @brief Reads and handles every waiting packet
+ *
+ * The host pairs with the first guest to say hello and answers every
+ * later hello from it, since a welcome can be lost. Packets from any
+ * other sender are ignored once paired.
+ */
+void NetPeer::receive()
+{
+    std::uint8_t packet[512];
+    std::size_t size;
+    IpAddress sender;
+    unsigned short sender_port;
+
+    while (socket.receive(packet, sizeof(packet), size, sender, sender_port) == Socket::Done)
+    {
+        if (size < 3 || packet[0] != 'F' || packet[1] != 'B')
+            continue;
+        bool from_peer = sender == remote_address && sender_port == remote_port;
+
+        if (packet[2] == net_packet_hello && hosting && size >= 4 && (from_peer || !connected))
+        {
+            if (!connected)
+            {
+                remote_address = sender;
+                remote_port = sender_port;
+                pixel_collision = local_pixel && (packet[3] & 1);
+                connected = true;
+            }
+            sendWelcome();
+        }
+        else if (packet[2] == net_packet_welcome && !hosting && !connected && from_peer && size >= 12)
+        {
+            pixel_collision = (packet[3] & 1) != 0;
+            seed = getLE(packet + 4, 8);
+            connected = true;
+        }
+        else if (packet[2] == net_packet_input && session && from_peer)
+        {
+            session->readPacket(packet, size);
+        }
+    }
+}
+
+/**
+ * @brief Advances the handshake; call regularly until it returns true
+ * @return True once paired with the other peer
+ */
+bool NetPeer::poll()
+{
+    if (!connected && !hosting && --hello_wait <= 0)
+    {
+        std::uint8_t hello[4] = { 'F', 'B', net_packet_hello, static_cast<std::uint8_t>(local_pixel ? 1 : 0) };
+        send(hello, sizeof(hello));
+        hello_wait = hello_interval;
+    }
+    receive();
+    return connected;
+}
+
+/**
+ * @brief Starts the match on a Simulation with the agreed settings
+ * @param sim Simulation to reset and play (kept, not copied); its masks must follow usesPixelCollision()
+ */
+void NetPeer::start(Simulation& sim)
+{
+    sim.reset(seed);
+    session = std::make_unique<RollbackSession>(sim, getLocalPlayer(), input_delay);
+    pending = 0;
+}
+
+/**
+ * @brief Plays one tick's worth of the match
+ * @param keys Keys pressed since the last call (either flap key flaps this peer's bird)
+ * @return True if the simulation stepped a tick
+ *
+ * Keys pressed while the schedule is full (the other peer is behind)
+ * are kept and go out with the next free tick. While this peer runs
+ * ahead it sometimes skips a tick to let the other catch up. An input
+ * packet is sent on every call, stepped or not.
+ */
+bool NetPeer::update(const SimInput& keys)
+{
+    receive();
+
+    if (keys.start)
+        pending |= net_start;
+    if (keys.flap[0] || keys.flap[1])
+        pending |= net_flap;
+    if (keys.restart)
+        pending |= net_restart;
+
+    bool stepped = false;
+    if (!session->shouldWait())
+    {
+        if (session->addLocalInput(pending))
+            pending = 0;
+        stepped = session->advance();
+    }
+
+    std::uint8_t packet[RollbackSession::max_packet];
+    send(packet, session->writePacket(packet));
+    return stepped;
+}
@@ -0,0 +1,150 @@
+/**
+ * @file NetPeer.h
+ * @brief Header file for the NetPeer class in Flappy Bird 2-player game
+ *
+ * This file defines one end of an online match: a non-blocking UDP
+ * socket, the handshake that pairs a host with a guest and agrees on
+ * the match settings, and the RollbackSession that plays the match
+ * once they are paired.
+ */
+
+#pragma once
+#include <SFML/Network.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "RollbackSession.h"
+#include "Simulation.h"
+
+using namespace sf;
+
+/**
+ * @class NetPeer
+ * @brief Connects two game instances over UDP and keeps their matches in step
+ *
+ * The host binds a known port and waits; the guest sends hello packets
+ * to it until a welcome comes back. The welcome carries the pipe course
+ * seed and whether both sides can use pixel-exact collisions, so both
+ * Simulations start identical. The host flies bird 0 and the guest bird
+ * 1; Enter and R are shared.
+ *
+ * After the handshake, update() is called once per simulation tick: it
+ * reads every waiting packet, schedules this peer's keys, advances the
+ * RollbackSession and sends one input packet. Nothing blocks, so a slow
+ * or silent peer only ever stalls the match, never the caller.
+ */
+class NetPeer
+{
+private:
+    UdpSocket socket;                               ///< Non-blocking socket for every packet
+    IpAddress remote_address;                       ///< Other peer (or the proxy in front of it)
+    unsigned short remote_port;                     ///< Port of the other peer
+    bool hosting;                                   ///< True for the host (bird 0)
+    bool connected;                                 ///< True once the handshake completed
+    bool local_pixel;                               ///< This peer has collision masks
+    bool pixel_collision;                           ///< Both peers use pixel-exact collisions
+    std::uint64_t seed;                             ///< Pipe course of the match
+    int input_delay;                                ///< Ticks between a key press and its tick
+    int hello_wait;                                 ///< Polls until the guest repeats its hello
+    std::uint8_t pending;                           ///< Keys pressed but not yet scheduled
+    std::unique_ptr<RollbackSession> session;       ///< Match in progress (after start())
+
+    /**
+     * @brief Sends a packet to the other peer
+     * @param data Packet bytes
+     * @param size Packet size in bytes
+     */
+    void send(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * @brief Sends the host's welcome with the match settings
+     */
+    void sendWelcome();
+
+    /**
+     * @brief Reads and handles every waiting packet
+     */
+    void receive();
+
+public:
+    static constexpr int hello_interval = 12;       ///< Polls between hello packets (0.1 s at tick rate)
+
+    /**
+     * @brief Constructor - creates an unconnected peer
+     * @param delay Ticks between a key press and the tick it applies to
+     */
+    explicit NetPeer(int delay = 2);
+
+    /**
+     * @brief Waits for a guest on a port
+     * @param port UDP port to listen on (0 = any free port)
+     * @param match_seed Pipe course seed to hand the guest
+     * @param pixel True if this peer has collision masks
+     * @return True if the port could be bound
+     */
+    bool host(unsigned short port, std::uint64_t match_seed, bool pixel);
+
+    /**
+     * @brief Starts joining a host
+     * @param address Host address
+     * @param port Host port
+     * @param pixel True if this peer has collision masks
+     * @return True if a local port could be bound
+     */
+    bool join(const IpAddress& address, unsigned short port, bool pixel);
+
+    /**
+     * @brief Advances the handshake; call regularly until it returns true
+     * @return True once paired with the other peer
+     */
+    bool poll();
+
+    /**
+     * @brief Starts the match on a Simulation with the agreed settings
+     * @param sim Simulation to reset and play (kept, not copied); its masks must follow usesPixelCollision()
+     */
+    void start(Simulation& sim);
+
+    /**
+     * @brief Plays one tick's worth of the match
+     * @param keys Keys pressed since the last call (either flap key flaps this peer's bird)
+     * @return True if the simulation stepped a tick
+     */
+    bool update(const SimInput& keys);
+
+    /**
+     * @brief Checks whether the handshake completed
+     * @return True once paired
+     */
+    bool isConnected() const { return connected; }
+
+    /**
+     * @brief Gets the bird flown by this peer
+     * @return 0 for the host, 1 for the guest
+     */
+    int getLocalPlayer() const { return hosting ? 0 : 1; }
+
+    /**
+     * @brief Gets the pipe course of the match
+     * @return Seed chosen by the host
+     */
+    std::uint64_t getSeed() const { return seed; }
+
+    /**
+     * @brief Checks whether the match uses pixel-exact collisions
+     * @return True if both peers have collision masks
+     */
+    bool usesPixelCollision() const { return pixel_collision; }
+
+    /**
+     * @brief Gets the port this peer is bound to
+     * @return Local UDP port
+     */
+    unsigned short getLocalPort() const { return socket.getLocalPort(); }
+
+    /**
+     * @brief Gets the match in progress
+     * @return Session, or nullptr before start()
+     */
+    const RollbackSession* getSession() const { return session.get(); }
+};
@@ -0,0 +1,88 @@
+/**
+ * @file NetProxy.cpp
+ * @brief Command-line network condition simulator for online matches
+ *
+ * Runs a LatencyProxy in real time, so two game windows on one machine
+ * can play an online match over a bad connection: the host listens on
+ * its port, the proxy forwards to it, and the guest joins the proxy.
+ *
+ * Command line options:
+ *   --listen <port>       Port the guest joins (default 7001)
+ *   --target <ip:port>    Host to forward to (default 127.0.0.1:7000)
+ *   --delay <ms>          One-way delay (default 40)
+ *   --jitter <ms>         Extra random one-way delay (default 10)
+ *   --loss <p>            Chance of dropping a packet (default 0.02)
+ *   --seed <n>            Random seed (default 1)
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include "LatencyProxy.h"
+
+/**
+ * @brief Main function - proxy entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
+ * @return 1 on bad arguments or if the port could not be bound; runs until killed otherwise
+ */
+int main(int argc, char* argv[])
+{
+    ProxyConfig config;
+    int listen_port = 7001;
+    std::string target = "127.0.0.1:7000";
+    std::uint32_t seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--listen") listen_port = std::atoi(value.c_str());
+        else if (arg == "--target") target = value;
+        else if (arg == "--delay") config.delay_ms = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--jitter") config.jitter_ms = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--loss") config.loss = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--seed") seed = static_cast<std::uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::size_t colon = target.rfind(':');
+    int target_port = colon == std::string::npos ? 0 : std::atoi(target.c_str() + colon + 1);
+    IpAddress target_address(target.substr(0, colon));
+    if (target_port <= 0 || target_port > 65535 || target_address == IpAddress::None ||
+        listen_port <= 0 || listen_port > 65535)
+    {
+        std::cerr << "--listen takes a port and --target takes <address>:<port>" << std::endl;
+        return 1;
+    }
+
+    LatencyProxy proxy(config, seed);
+    if (!proxy.open(static_cast<unsigned short>(listen_port), target_address, static_cast<unsigned short>(target_port)))
+    {
+        std::cerr << "Could not listen on UDP port " << listen_port << std::endl;
+        return 1;
+    }
+    std::cout << "Forwarding port " << listen_port << " to " << target << " with "
+              << config.delay_ms << " ms delay, " << config.jitter_ms << " ms jitter, "
+              << config.loss * 100.f << "% loss" << std::endl;
+
+    // Half-millisecond polling keeps the added delay accurate to well under a tick
+    while (true)
+    {
+        proxy.pump(std::chrono::steady_clock::now());
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+}
@@ -0,0 +1,38 @@
+/**
+ * @file PipeStream.cpp
+ * @brief Implementation of the PipeStream class for Flappy Bird 2-player game
+ *
+ * This file contains the counter-based hash used to derive pipe heights
+ * from a seed and a pipe index.
+ */
+
+#include "PipeStream.h"
+#include "SplitMix64.h"
+
+/**
+ * @brief Constructor - creates a pipe course
+ * @param seed Seed identifying the course
+ * @param min_height Lowest pipe height (inclusive)
+ * @param max_height Highest pipe height (inclusive)
+ */
+PipeStream::PipeStream(std::uint64_t seed, int min_height, int max_height) :
+seed(seed),
+min_height(min_height),
+max_height(max_height)
+{
+}
+
+/**
+ * @brief Gets the height of a pipe in the course
+ * @param index Zero-based pipe index
+ * @return Pipe height in the range [min_height, max_height]
+ *
+ * Hashes the seed and index together, then maps the top 32 bits onto
+ * the height range with a multiply-shift instead of a division.
+ */
+int PipeStream::getHeight(std::uint64_t index) const
+{
+    std::uint64_t hash = splitMix64Finish(seed + (index + 1) * splitmix64_gamma);
+    std::uint64_t range = static_cast<std::uint64_t>(max_height - min_height + 1);
+    return min_height + static_cast<int>(((hash >> 32) * range) >> 32);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file PipeStream.h
+ * @brief Header file for the PipeStream class in Flappy Bird 2-player game
+ *
+ * This file defines the PipeStream class which produces the sequence of
+ * pipe heights for a match from a single seed. Any pipe in the course
+ * can be computed directly from its index.
+ */
+
+#pragma once
+#include <cstdint>
+
+/**
+ * @class PipeStream
+ * @brief Seeded, random-access generator of pipe heights
+ *
+ * Each height is a hash of the seed and the pipe index (counter-based
+ * generation), so there is no generator state to advance: pipe N costs
+ * the same as pipe 0, and the same seed always yields the same course.
+ */
+class PipeStream
+{
+private:
+    std::uint64_t seed;     ///< Seed identifying the pipe course
+    int min_height;         ///< Lowest pipe height (inclusive)
+    int max_height;         ///< Highest pipe height (inclusive)
+
+public:
+    /**
+     * @brief Constructor - creates a pipe course
+     * @param seed Seed identifying the course
+     * @param min_height Lowest pipe height (inclusive)
+     * @param max_height Highest pipe height (inclusive)
+     */
+    explicit PipeStream(std::uint64_t seed = 0, int min_height = 250, int max_height = 550);
+
+    /**
+     * @brief Switches to another pipe course
+     * @param new_seed Seed identifying the course
+     */
+    void setSeed(std::uint64_t new_seed) { seed = new_seed; }
+
+    /**
+     * @brief Gets the seed identifying the current course
+     * @return Course seed
+     */
+    std::uint64_t getSeed() const { return seed; }
+
+    /**
+     * @brief Gets the height of a pipe in the course
+     * @param index Zero-based pipe index
+     * @return Pipe height in the range [min_height, max_height]
+     */
+    int getHeight(std::uint64_t index) const;
+};
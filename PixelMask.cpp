@@ -0,0 +1,121 @@
+/**
+ * @file PixelMask.cpp
+ * @brief Implementation of the PixelMask class for Flappy Bird 2-player game
+ */
+
+#include "PixelMask.h"
+#include <algorithm>
+
+PixelMask::PixelMask() :
+width(0),
+height(0),
+row_words(0)
+{
+}
+
+/**
+ * @brief Builds the mask by sampling an RGBA image region
+ * @param pixels First pixel of the region (RGBA, 8 bits per channel)
+ * @param stride Pixels per row of the whole image
+ * @param source_width Width of the region in pixels
+ * @param source_height Height of the region in pixels
+ * @param mask_width Width of the mask (the sprite's on-screen width)
+ * @param mask_height Height of the mask (the sprite's on-screen height)
+ * @param min_alpha Alpha at or above which a pixel counts as solid
+ *
+ * Sprites are drawn stretched to their collision box, so the mask is
+ * sampled at the box size: each mask pixel takes the source pixel under
+ * its centre, which is what nearest-neighbour drawing would show there.
+ */
+void PixelMask::build(const std::uint8_t* pixels, int stride, int source_width, int source_height,
+                      int mask_width, int mask_height, std::uint8_t min_alpha)
+{
+    width = mask_width;
+    height = mask_height;
+    row_words = (mask_width + 63) / 64;
+    bits.assign(static_cast<std::size_t>(row_words) * mask_height, 0);
+
+    for (int y = 0; y < mask_height; y++)
+    {
+        int source_y = std::min(source_height - 1, (2 * y + 1) * source_height / (2 * mask_height));
+        const std::uint8_t* row = pixels + static_cast<std::size_t>(source_y) * stride * 4;
+        std::uint64_t* out = &bits[static_cast<std::size_t>(y) * row_words];
+        for (int x = 0; x < mask_width; x++)
+        {
+            int source_x = std::min(source_width - 1, (2 * x + 1) * source_width / (2 * mask_width));
+            if (row[source_x * 4 + 3] >= min_alpha)
+                out[x / 64] |= std::uint64_t(1) << (x % 64);
+        }
+    }
+}
+
+/**
+ * @brief Checks whether a pixel is solid
+ * @param x Column
+ * @param y Row
+ * @return True if the pixel is inside the mask and opaque
+ */
+bool PixelMask::get(int x, int y) const
+{
+    if (x < 0 || y < 0 || x >= width || y >= height)
+        return false;
+    return (bits[static_cast<std::size_t>(y) * row_words + x / 64] >> (x % 64)) & 1;
+}
+
+/**
+ * @brief Gets 64 columns of a row starting at any column
+ * @param row Row index, in [0, height)
+ * @param column First column; columns outside the mask read as clear
+ * @return Bit i holds column (column + i)
+ */
+std::uint64_t PixelMask::getBits(int row, int column) const
+{
+    const std::uint64_t* words = &bits[static_cast<std::size_t>(row) * row_words];
+    if (column <= -64 || column >= width)
+        return 0;
+    if (column < 0)
+        return words[0] << -column;
+
+    int word = column / 64;
+    int shift = column % 64;
+    std::uint64_t value = words[word] >> shift;
+    if (shift && word + 1 < row_words)
+        value |= words[word + 1] << (64 - shift);
+    return value;
+}
+
+/**
+ * @brief Checks whether two placed masks share a solid pixel
+ * @param a First mask
+ * @param ax Left edge of the first mask
+ * @param ay Top edge of the first mask
+ * @param b Second mask
+ * @param bx Left edge of the second mask
+ * @param by Top edge of the second mask
+ * @return True if any pixel is solid in both
+ *
+ * Only the rows and columns where the two masks overlap are visited,
+ * 64 columns per AND.
+ */
+bool PixelMask::overlaps(const PixelMask& a, int ax, int ay, const PixelMask& b, int bx, int by)
+{
+    int left = std::max(ax, bx);
+    int right = std::min(ax + a.width, bx + b.width);
+    int top = std::max(ay, by);
+    int bottom = std::min(ay + a.height, by + b.height);
+    if (left >= right || top >= bottom)
+        return false;
+
+    for (int y = top; y < bottom; y++)
+    {
+        for (int x = left; x < right; x += 64)
+        {
+            std::uint64_t both = a.getBits(y - ay, x - ax) & b.getBits(y - by, x - bx);
+            if (right - x < 64)
+                both &= (std::uint64_t(1) << (right - x)) - 1;
+            if (both)
+                return true;
+        }
+    }
+    return false;
+}
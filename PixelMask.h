@@ -0,0 +1,93 @@
+/**
+ * @file PixelMask.h
+ * @brief Header file for the PixelMask class in Flappy Bird 2-player game
+ *
+ * This file defines bit-packed opacity masks of the gameplay sprites, so
+ * collisions can ignore the transparent corners of the bird and pipe art.
+ * Masks are plain data with no SFML dependency, so the headless
+ * Simulation can collide with them.
+ */
+
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class PixelMask
+ * @brief One bit per on-screen pixel, set where a sprite is opaque
+ *
+ * Each row is stored as whole 64-bit words, column c in bit (c % 64) of
+ * word (c / 64). Two masks are tested by AND-ing 64 columns of each
+ * overlapping row at a time, so a bird against a pipe is a few dozen
+ * word operations.
+ */
+class PixelMask
+{
+private:
+    int width;                          ///< Width in pixels
+    int height;                         ///< Height in pixels
+    int row_words;                      ///< 64-bit words per row
+    std::vector<std::uint64_t> bits;    ///< Rows, top first
+
+    /**
+     * @brief Gets 64 columns of a row starting at any column
+     * @param row Row index, in [0, height)
+     * @param column First column; columns outside the mask read as clear
+     * @return Bit i holds column (column + i)
+     */
+    std::uint64_t getBits(int row, int column) const;
+
+public:
+    PixelMask();
+
+    /**
+     * @brief Builds the mask by sampling an RGBA image region
+     * @param pixels First pixel of the region (RGBA, 8 bits per channel)
+     * @param stride Pixels per row of the whole image
+     * @param source_width Width of the region in pixels
+     * @param source_height Height of the region in pixels
+     * @param mask_width Width of the mask (the sprite's on-screen width)
+     * @param mask_height Height of the mask (the sprite's on-screen height)
+     * @param min_alpha Alpha at or above which a pixel counts as solid
+     */
+    void build(const std::uint8_t* pixels, int stride, int source_width, int source_height,
+               int mask_width, int mask_height, std::uint8_t min_alpha = 128);
+
+    /**
+     * @brief Checks whether the mask has been built
+     * @return True if the mask has pixels
+     */
+    bool empty() const { return bits.empty(); }
+
+    /**
+     * @brief Gets the mask width
+     * @return Width in pixels
+     */
+    int getWidth() const { return width; }
+
+    /**
+     * @brief Gets the mask height
+     * @return Height in pixels
+     */
+    int getHeight() const { return height; }
+
+    /**
+     * @brief Checks whether a pixel is solid
+     * @param x Column
+     * @param y Row
+     * @return True if the pixel is inside the mask and opaque
+     */
+    bool get(int x, int y) const;
+
+    /**
+     * @brief Checks whether two placed masks share a solid pixel
+     * @param a First mask
+     * @param ax Left edge of the first mask
+     * @param ay Top edge of the first mask
+     * @param b Second mask
+     * @param bx Left edge of the second mask
+     * @param by Top edge of the second mask
+     * @return True if any pixel is solid in both
+     */
+    static bool overlaps(const PixelMask& a, int ax, int ay, const PixelMask& b, int bx, int by);
+};
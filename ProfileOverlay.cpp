@@ -0,0 +1,116 @@
+/**
+ * @file ProfileOverlay.cpp
+ * @brief Implementation of the on-screen profiler overlay for Flappy Bird 2-player game
+ */
+
+#include "ProfileOverlay.h"
+#include <algorithm>
+#include <cstdio>
+
+static const float panel_left = 10.f;       ///< Left edge of the panel
+static const float panel_top = 60.f;        ///< Top edge of the panel (below the scores)
+static const float panel_width = 290.f;     ///< Width of the panel
+static const float panel_height = 235.f;    ///< Height of the panel
+static const float bar_width = 8.f;         ///< Width of one histogram bar
+static const float bars_height = 50.f;      ///< Height of the tallest histogram bar
+
+/**
+ * @brief Constructor - lays out an empty panel
+ */
+ProfileOverlay::ProfileOverlay() :
+panel(Vector2f(panel_width, panel_height)),
+bars(Quads, buckets * 4)
+{
+    panel.setPosition(panel_left, panel_top);
+    panel.setFillColor(Color(0, 0, 0, 170));
+
+    text.setCharacterSize(13);
+    text.setFillColor(Color::White);
+    text.setPosition(panel_left + 6.f, panel_top + 4.f);
+
+    for (int i = 0; i < buckets; i++)
+        counts[i] = 0;
+    buffer[0] = '\0';
+}
+
+/**
+ * @brief Sets the font of the statistics text and reserves text storage
+ * @param font Font (must outlive the overlay)
+ *
+ * Lays out a full-length text of every printable character once, so the
+ * string, the text's vertices and the font's glyph cache already hold
+ * everything later refreshes need.
+ */
+void ProfileOverlay::setFont(const Font& font)
+{
+    text.setFont(font);
+
+    string.clear();
+    for (int i = 0; i < max_text - 1; i++)
+        string += String(static_cast<char>(' ' + i % 95));
+    text.setString(string);
+    text.getLocalBounds();
+    text.setString(String());
+}
+
+/**
+ * @brief Rebuilds the statistics and histogram from a profiler
+ * @param profiler Profiler to summarize
+ *
+ * Bars are scaled to the busiest bucket; bars past the 60 fps budget
+ * (16 ms) are drawn red.
+ */
+void ProfileOverlay::refresh(Profiler& profiler)
+{
+    int length = std::snprintf(buffer, max_text, "phase        p50     p99     max\n");
+    for (int i = 0; i < Profiler::phase_count && length < max_text; i++)
+    {
+        ProfilePhase phase = static_cast<ProfilePhase>(i);
+        PhaseStats stats = profiler.getStats(phase);
+        length += std::snprintf(buffer + length, max_text - length, "%-10s %6.2f  %6.2f  %6.2f\n",
+                                Profiler::getName(phase), stats.p50, stats.p99, stats.max);
+    }
+    if (AllocationTracker::isEnabled() && length < max_text)
+    {
+        length += std::snprintf(buffer + length, max_text - length, "allocations  last %u  max %u\n",
+                                static_cast<unsigned>(profiler.getLastFrameAllocations().allocations),
+                                profiler.getMaxFrameAllocations());
+    }
+    if (length < max_text)
+        std::snprintf(buffer + length, max_text - length, "%d frames, ms per frame", profiler.getFrameCount());
+
+    // Single characters fit sf::String's small buffer, so appending them
+    // reuses the storage reserved in setFont()
+    string.clear();
+    for (const char* c = buffer; *c; c++)
+        string += String(*c);
+    text.setString(string);
+
+    profiler.getHistogram(ProfilePhase::Frame, 1.f, counts, buckets);
+    int tallest = std::max(1, *std::max_element(counts, counts + buckets));
+    float bottom = panel_top + panel_height - 6.f;
+    for (int i = 0; i < buckets; i++)
+    {
+        float left = panel_left + 6.f + i * bar_width;
+        float top = bottom - bars_height * counts[i] / tallest;
+        Color color = i < 16 ? Color::Green : Color::Red;
+
+        Vertex* quad = &bars[i * 4];
+        quad[0] = Vertex(Vector2f(left, top), color);
+        quad[1] = Vertex(Vector2f(left + bar_width - 1.f, top), color);
+        quad[2] = Vertex(Vector2f(left + bar_width - 1.f, bottom), color);
+        quad[3] = Vertex(Vector2f(left, bottom), color);
+    }
+}
+
+/**
+ * @brief Draws the panel, statistics and histogram
+ * @param target Render target
+ * @param states Render states
+ */
+void ProfileOverlay::draw(RenderTarget& target, RenderStates states) const
+{
+    target.draw(panel, states);
+    target.draw(text, states);
+    target.draw(bars, states);
+}
@@ -0,0 +1,62 @@
+/**
+ * @file ProfileOverlay.h
+ * @brief Header file for the on-screen profiler overlay in Flappy Bird 2-player game
+ *
+ * This file defines ProfileOverlay, which shows a Profiler's per-phase
+ * p50/p99/max timings and a histogram of recent frame times.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include "Profiler.h"
+
+using namespace sf;
+
+/**
+ * @class ProfileOverlay
+ * @brief Panel with per-phase frame timings and a frame time histogram
+ *
+ * The panel only changes when refresh() is called, so the caller decides
+ * how often to pay for recomputing percentiles and rebuilding the text.
+ * Refreshing does not allocate: the text is formatted into fixed buffers
+ * whose capacity is reserved when the font is set.
+ */
+class ProfileOverlay : public Drawable
+{
+public:
+    static const int buckets = 34;             ///< Histogram buckets (1 ms each; the last takes slower frames)
+    static const int max_text = 512;           ///< Longest statistics text, in characters
+
+private:
+    RectangleShape panel;                      ///< Translucent background
+    Text text;                                 ///< Per-phase statistics
+    char buffer[max_text];                     ///< Statistics formatted as bytes
+    String string;                             ///< Statistics converted for the Text (capacity kept)
+    VertexArray bars;                          ///< Histogram bars, one quad per bucket
+    int counts[buckets];                       ///< Frames per histogram bucket
+
+    /**
+     * @brief Draws the panel, statistics and histogram
+     * @param target Render target
+     * @param states Render states
+     */
+    void draw(RenderTarget& target, RenderStates states) const override;
+
+public:
+    /**
+     * @brief Constructor - lays out an empty panel
+     */
+    ProfileOverlay();
+
+    /**
+     * @brief Sets the font of the statistics text and reserves text storage
+     * @param font Font (must outlive the overlay)
+     */
+    void setFont(const Font& font);
+
+    /**
+     * @brief Rebuilds the statistics and histogram from a profiler
+     * @param profiler Profiler to summarize
+     */
+    void refresh(Profiler& profiler);
+};
@@ -0,0 +1,196 @@
+/**
+ * @file Profiler.cpp
+ * @brief Implementation of the frame profiler for Flappy Bird 2-player game
+ */
+
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+
+static thread_local Profiler* current_profiler = nullptr;   ///< Profiler timers on this thread report to
+
+static const char* const phase_names[Profiler::phase_count] =
+{
+    "events", "update", "collision", "score", "draw", "display", "frame"
+};
+
+Profiler::Profiler() :
+scratch(history),
+allocations(history, 0),
+allocated_bytes(history, 0),
+frame_start(AllocationTracker::getCounts()),
+frames(0)
+{
+    for (int i = 0; i < phase_count; i++)
+    {
+        current[i] = 0;
+        samples[i].assign(history, 0.f);
+    }
+}
+
+/**
+ * @brief Closes the current frame and stores it in the history
+ * @param frame_time Total time of the frame
+ *
+ * The Frame phase is taken from frame_time rather than from timers.
+ */
+void Profiler::endFrame(std::chrono::nanoseconds frame_time)
+{
+    current[static_cast<int>(ProfilePhase::Frame)] = frame_time.count();
+
+    int slot = static_cast<int>(frames % history);
+    for (int i = 0; i < phase_count; i++)
+    {
+        samples[i][slot] = current[i] / 1e6f;
+        current[i] = 0;
+    }
+
+    AllocationTracker::Counts now = AllocationTracker::getCounts();
+    allocations[slot] = static_cast<std::uint32_t>(now.allocations - frame_start.allocations);
+    allocated_bytes[slot] = static_cast<std::uint32_t>(now.bytes - frame_start.bytes);
+    frame_start = now;
+    frames++;
+}
+
+/**
+ * @brief Gets the heap allocations made during the last closed frame
+ * @return Allocations and bytes (zero unless tracking allocations)
+ */
+AllocationTracker::Counts Profiler::getLastFrameAllocations() const
+{
+    AllocationTracker::Counts counts = { 0, 0 };
+    if (frames > 0)
+    {
+        int slot = static_cast<int>((frames - 1) % history);
+        counts.allocations = allocations[slot];
+        counts.bytes = allocated_bytes[slot];
+    }
+    return counts;
+}
+
+/**
+ * @brief Gets the most heap allocations made by any frame in the history
+ * @return Allocation count of the worst frame
+ */
+std::uint32_t Profiler::getMaxFrameAllocations() const
+{
+    return *std::max_element(allocations.begin(), allocations.begin() + std::max(1, getFrameCount()));
+}
+
+/**
+ * @brief Gets how many frames are in the history
+ * @return Number of stored frames, at most history
+ */
+int Profiler::getFrameCount() const
+{
+    return static_cast<int>(std::min<std::uint64_t>(frames, history));
+}
+
+/**
+ * @brief Computes p50, p99 and max of a phase over the history
+ * @param phase Phase to summarize
+ * @return Statistics in milliseconds (all zero with no frames)
+ */
+PhaseStats Profiler::getStats(ProfilePhase phase)
+{
+    PhaseStats stats = { 0.f, 0.f, 0.f };
+    int count = getFrameCount();
+    if (count == 0)
+        return stats;
+
+    const std::vector<float>& source = samples[static_cast<int>(phase)];
+    std::copy(source.begin(), source.begin() + count, scratch.begin());
+    std::vector<float>::iterator end = scratch.begin() + count;
+
+    std::nth_element(scratch.begin(), scratch.begin() + count / 2, end);
+    stats.p50 = scratch[count / 2];
+    int p99 = std::min(count - 1, count * 99 / 100);
+    std::nth_element(scratch.begin(), scratch.begin() + p99, end);
+    stats.p99 = scratch[p99];
+    stats.max = *std::max_element(scratch.begin() + p99, end);
+    return stats;
+}
+
+/**
+ * @brief Buckets a phase's history into a histogram
+ * @param phase Phase to bucket
+ * @param bucket_ms Width of each bucket in milliseconds
+ * @param counts Output counts, one per bucket; the last bucket also takes slower frames
+ * @param buckets Number of buckets
+ */
+void Profiler::getHistogram(ProfilePhase phase, float bucket_ms, int* counts, int buckets) const
+{
+    std::fill(counts, counts + buckets, 0);
+
+    const std::vector<float>& source = samples[static_cast<int>(phase)];
+    int count = getFrameCount();
+    for (int i = 0; i < count; i++)
+    {
+        int bucket = static_cast<int>(source[i] / bucket_ms);
+        counts[std::min(bucket, buckets - 1)]++;
+    }
+}
+
+/**
+ * @brief Writes the history as CSV, one row per frame, oldest first
+ * @param path File to write
+ * @return True if the file could be written
+ *
+ * Columns are the frame number followed by each phase in milliseconds,
+ * then the frame's heap allocations and bytes when tracking allocations.
+ */
+bool Profiler::writeCsv(const std::string& path) const
+{
+    std::ofstream file(path);
+    if (!file)
+        return false;
+
+    file << "frame";
+    for (int i = 0; i < phase_count; i++)
+        file << ',' << phase_names[i] << "_ms";
+    if (AllocationTracker::isEnabled())
+        file << ",allocations,allocated_bytes";
+    file << '\n';
+
+    int count = getFrameCount();
+    std::uint64_t first = frames - count;
+    for (std::uint64_t frame = first; frame < frames; frame++)
+    {
+        int slot = static_cast<int>(frame % history);
+        file << frame;
+        for (int i = 0; i < phase_count; i++)
+            file << ',' << samples[i][slot];
+        if (AllocationTracker::isEnabled())
+            file << ',' << allocations[slot] << ',' << allocated_bytes[slot];
+        file << '\n';
+    }
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Gets the name of a phase as used in the overlay and CSV
+ * @param phase Phase
+ * @return Lower-case name
+ */
+const char* Profiler::getName(ProfilePhase phase)
+{
+    return phase_names[static_cast<int>(phase)];
+}
+
+/**
+ * @brief Gets the profiler timers on this thread report to
+ * @return Profiler, or nullptr if timing is off on this thread
+ */
+Profiler* Profiler::getCurrent()
+{
+    return current_profiler;
+}
+
+/**
+ * @brief Sets the profiler timers on this thread report to
+ * @param profiler Profiler, or nullptr to turn timing off
+ */
+void Profiler::setCurrent(Profiler* profiler)
+{
+    current_profiler = profiler;
+}
@@ -0,0 +1,209 @@
+/**
+ * @file Profiler.h
+ * @brief Header file for the built-in frame profiler in Flappy Bird 2-player game
+ *
+ * This file defines Profiler, which keeps a rolling history of how long
+ * each phase of a frame took, and ProfileScope, the scoped timer that
+ * feeds it. Neither depends on SFML, so the headless Simulation can be
+ * instrumented too.
+ */
+
+#pragma once
+#include "AllocationTracker.h"
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Phases of a frame timed by the profiler
+ *
+ * Collision and Score run inside Update, so they are also counted there.
+ */
+enum class ProfilePhase
+{
+    Events,     ///< Polling window events
+    Update,     ///< Stepping the simulation (ticks finished during the frame)
+    Collision,  ///< Simulation collision checks
+    Score,      ///< Simulation score checks
+    Draw,       ///< Building and submitting the frame
+    Display,    ///< Presenting the frame (includes the frame limiter's wait)
+    Frame,      ///< Whole frame, from one frame start to the next
+    Count       ///< Number of phases
+};
+
+/**
+ * @struct PhaseStats
+ * @brief Summary of one phase over the profiler's history, in milliseconds
+ */
+struct PhaseStats
+{
+    float p50;   ///< Median
+    float p99;   ///< 99th percentile
+    float max;   ///< Slowest frame
+};
+
+/**
+ * @class Profiler
+ * @brief Rolling per-phase frame timings with percentiles and CSV export
+ *
+ * Scoped timers add their time to the current frame; endFrame() moves the
+ * frame's totals into a fixed-size history, overwriting the oldest frame.
+ * In builds tracking allocations, each frame also stores the heap
+ * allocations the calling thread made during it. Nothing allocates after
+ * construction.
+ *
+ * Timers find the profiler through a per-thread pointer set with
+ * setCurrent(). Threads that never set one (batch runner workers, for
+ * example) skip timing entirely.
+ */
+class Profiler
+{
+public:
+    static const int history = 3600;   ///< Frames kept (one minute at 60 fps)
+    static const int phase_count = static_cast<int>(ProfilePhase::Count);
+
+private:
+    std::int64_t current[phase_count];          ///< Nanoseconds spent in each phase this frame
+    std::vector<float> samples[phase_count];    ///< Per-phase milliseconds, one slot per frame
+    std::vector<float> scratch;                 ///< Working copy used for percentiles
+    std::vector<std::uint32_t> allocations;     ///< Heap allocations per frame
+    std::vector<std::uint32_t> allocated_bytes; ///< Bytes allocated per frame
+    AllocationTracker::Counts frame_start;      ///< Allocation totals when the current frame began
+    std::uint64_t frames;                       ///< Frames recorded so far
+
+public:
+    Profiler();
+
+    /**
+     * @brief Adds time spent in a phase during the current frame
+     * @param phase Phase to charge
+     * @param time Elapsed time
+     */
+    void add(ProfilePhase phase, std::chrono::nanoseconds time)
+    {
+        current[static_cast<int>(phase)] += time.count();
+    }
+
+    /**
+     * @brief Closes the current frame and stores it in the history
+     * @param frame_time Total time of the frame
+     */
+    void endFrame(std::chrono::nanoseconds frame_time);
+
+    /**
+     * @brief Gets the heap allocations made during the last closed frame
+     * @return Allocations and bytes (zero unless tracking allocations)
+     */
+    AllocationTracker::Counts getLastFrameAllocations() const;
+
+    /**
+     * @brief Gets the most heap allocations made by any frame in the history
+     * @return Allocation count of the worst frame
+     */
+    std::uint32_t getMaxFrameAllocations() const;
+
+    /**
+     * @brief Gets the time charged to a phase since the last endFrame()
+     * @param phase Phase
+     * @return Time so far in the current frame
+     */
+    std::chrono::nanoseconds getPending(ProfilePhase phase) const
+    {
+        return std::chrono::nanoseconds(current[static_cast<int>(phase)]);
+    }
+
+    /**
+     * @brief Gets how many frames are in the history
+     * @return Number of stored frames, at most history
+     */
+    int getFrameCount() const;
+
+    /**
+     * @brief Gets how many frames have been recorded in total
+     * @return Frames since construction
+     */
+    std::uint64_t getTotalFrames() const { return frames; }
+
+    /**
+     * @brief Computes p50, p99 and max of a phase over the history
+     * @param phase Phase to summarize
+     * @return Statistics in milliseconds (all zero with no frames)
+     */
+    PhaseStats getStats(ProfilePhase phase);
+
+    /**
+     * @brief Buckets a phase's history into a histogram
+     * @param phase Phase to bucket
+     * @param bucket_ms Width of each bucket in milliseconds
+     * @param counts Output counts, one per bucket; the last bucket also takes slower frames
+     * @param buckets Number of buckets
+     */
+    void getHistogram(ProfilePhase phase, float bucket_ms, int* counts, int buckets) const;
+
+    /**
+     * @brief Writes the history as CSV, one row per frame, oldest first
+     * @param path File to write
+     * @return True if the file could be written
+     */
+    bool writeCsv(const std::string& path) const;
+
+    /**
+     * @brief Gets the name of a phase as used in the overlay and CSV
+     * @param phase Phase
+     * @return Lower-case name
+     */
+    static const char* getName(ProfilePhase phase);
+
+    /**
+     * @brief Gets the profiler timers on this thread report to
+     * @return Profiler, or nullptr if timing is off on this thread
+     */
+    static Profiler* getCurrent();
+
+    /**
+     * @brief Sets the profiler timers on this thread report to
+     * @param profiler Profiler, or nullptr to turn timing off
+     */
+    static void setCurrent(Profiler* profiler);
+};
+
+/**
+ * @class ProfileScope
+ * @brief Times the enclosing scope and charges it to a phase
+ *
+ * Costs two clock reads when the thread has a profiler and a single
+ * pointer check when it does not.
+ */
+class ProfileScope
+{
+private:
+    Profiler* profiler;                                ///< Profiler to report to (may be null)
+    ProfilePhase phase;                                ///< Phase being timed
+    std::chrono::steady_clock::time_point start;       ///< When the scope was entered
+
+public:
+    /**
+     * @brief Starts timing
+     * @param phase Phase to charge
+     */
+    explicit ProfileScope(ProfilePhase phase) :
+    profiler(Profiler::getCurrent()),
+    phase(phase)
+    {
+        if (profiler)
+            start = std::chrono::steady_clock::now();
+    }
+
+    /**
+     * @brief Stops timing and reports the elapsed time
+     */
+    ~ProfileScope()
+    {
+        if (profiler)
+            profiler->add(phase, std::chrono::steady_clock::now() - start);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+};
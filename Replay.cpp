@@ -0,0 +1,286 @@
+/**
+ * @file Replay.cpp
+ * @brief Implementation of replay recording and playback for Flappy Bird 2-player game
+ *
+ * This file contains the binary encoding of replay headers and the
+ * variable-length input event log, including optional per-tick state
+ * digests.
+ */
+
+#include "Replay.h"
+#include "ByteOrder.h"
+
+static const char replay_magic[4] = { 'F', 'B', 'R', 'P' };
+static const std::uint8_t replay_version = 1;            ///< Format of replays with inputs only
+static const std::uint8_t replay_hashes_version = 2;     ///< Format of replays that also hold state digests
+
+/**
+ * @brief Writes an unsigned integer as LEB128 (7 bits per byte)
+ * @param out Stream to write to
+ * @param value Value to write
+ */
+static void writeVarint(std::ostream& out, std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        out.put(static_cast<char>((value & 0x7f) | 0x80));
+        value >>= 7;
+    }
+    out.put(static_cast<char>(value));
+}
+
+/**
+ * @brief Reads an unsigned LEB128 integer
+ * @param in Stream to read from
+ * @param value Receives the value read
+ * @return True if a complete value was read
+ */
+static bool readVarint(std::istream& in, std::uint64_t& value)
+{
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        int byte = in.get();
+        if (byte == std::char_traits<char>::eof())
+            return false;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+ReplayWriter::ReplayWriter() :
+last_tick(0)
+{
+}
+
+ReplayWriter::~ReplayWriter()
+{
+    if (file.is_open())
+        close(last_tick);
+}
+
+/**
+ * @brief Starts a new replay file and writes its header
+ * @param path File to write
+ * @param seed Pipe course seed of the match
+ * @param flags Header flag bits describing the match rules
+ * @return True if the file could be opened
+ */
+bool ReplayWriter::open(const std::string& path, std::uint64_t seed, std::uint8_t flags)
+{
+    if (file.is_open())
+        close(last_tick);
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file)
+        return false;
+
+    // Replays without digests keep the old version, so older builds still play them
+    file.write(replay_magic, sizeof(replay_magic));
+    file.put(static_cast<char>(flags & replay_state_hashes ? replay_hashes_version : replay_version));
+    file.put(static_cast<char>(flags));
+    writeLE(file, Simulation::tick_rate, 2);
+    writeLE(file, seed, 8);
+    last_tick = 0;
+    return true;
+}
+
+/**
+ * @brief Records the inputs applied at a tick
+ * @param tick Simulation tick the input applies to
+ * @param input Inputs applied at that tick
+ *
+ * Ticks without input are not stored; they are implied by the tick
+ * delta of the next event, which keeps a match to a few KB.
+ */
+void ReplayWriter::record(std::uint64_t tick, const SimInput& input)
+{
+    std::uint8_t bits = 0;
+    if (input.start) bits |= replay_start;
+    if (input.flap[0]) bits |= replay_flap1;
+    if (input.flap[1]) bits |= replay_flap2;
+    if (input.restart) bits |= replay_restart;
+
+    if (bits && file.is_open())
+        writeEvent(tick, bits);
+}
+
+/**
+ * @brief Records the state reached by a tick (only in files opened with replay_state_hashes)
+ * @param tick Simulation tick whose input was just applied
+ * @param hash Simulation state after the tick
+ *
+ * Adds 4 + StateField::Count bytes plus the event header per tick.
+ */
+void ReplayWriter::recordHash(std::uint64_t tick, const StateHash& hash)
+{
+    if (!file.is_open())
+        return;
+
+    StateDigest digest = hash.getDigest();
+    writeEvent(tick, replay_hash);
+    writeLE(file, digest.combined, 4);
+    file.write(reinterpret_cast<const char*>(digest.fields), sizeof(digest.fields));
+}
+
+/**
+ * @brief Writes one event (tick delta and input byte)
+ * @param tick Simulation tick the input applies to
+ * @param bits Input byte
+ */
+void ReplayWriter::writeEvent(std::uint64_t tick, std::uint8_t bits)
+{
+    writeVarint(file, tick - last_tick);
+    file.put(static_cast<char>(bits));
+    last_tick = tick;
+}
+
+/**
+ * @brief Writes the end marker and closes the file
+ * @param end_tick Number of ticks simulated in the match
+ */
+void ReplayWriter::close(std::uint64_t end_tick)
+{
+    if (!file.is_open())
+        return;
+    writeEvent(end_tick < last_tick ? last_tick : end_tick, replay_end);
+    file.close();
+}
+
+ReplayReader::ReplayReader() :
+seed(0),
+flags(0),
+next_tick(0),
+next_bits(0),
+next_digest(),
+finished(true)
+{
+}
+
+/**
+ * @brief Opens a replay file and reads its header
+ * @param path File to read
+ * @return True if the file is a valid replay for this simulation
+ *
+ * Replays recorded at a different tick rate are rejected, since they
+ * would not reproduce the same match.
+ */
+bool ReplayReader::open(const std::string& path)
+{
+    file.open(path, std::ios::binary);
+    if (!file)
+        return false;
+
+    char magic[4];
+    file.read(magic, sizeof(magic));
+    int version = file.get();
+    flags = static_cast<std::uint8_t>(file.get());
+    std::uint64_t tick_rate = readLE(file, 2);
+    seed = readLE(file, 8);
+
+    if (!file || std::char_traits<char>::compare(magic, replay_magic, 4) != 0 ||
+        (version != replay_version && version != replay_hashes_version) || tick_rate != Simulation::tick_rate)
+    {
+        file.close();
+        return false;
+    }
+
+    next_tick = 0;
+    finished = false;
+    readEvent();
+    return true;
+}
+
+/**
+ * @brief Reads the next event from the file
+ *
+ * A truncated file (e.g. the game crashed while recording) simply
+ * ends the replay at the last complete event.
+ */
+void ReplayReader::readEvent()
+{
+    std::uint64_t delta;
+    int bits;
+    if (!readVarint(file, delta) || (bits = file.get()) == std::char_traits<char>::eof())
+    {
+        finished = true;
+        return;
+    }
+
+    next_tick += delta;
+    next_bits = static_cast<std::uint8_t>(bits);
+    if (next_bits & replay_end)
+        finished = true;
+    else if (next_bits & replay_hash)
+    {
+        next_digest.combined = static_cast<std::uint32_t>(readLE(file, 4));
+        file.read(reinterpret_cast<char*>(next_digest.fields), sizeof(next_digest.fields));
+        if (!file)
+            finished = true;
+    }
+}
+
+/**
+ * @brief Drops digest events of ticks before a given tick
+ * @param tick Simulation tick about to be read
+ *
+ * Lets callers that never ask for digests play a replay that has them.
+ */
+void ReplayReader::skipDigests(std::uint64_t tick)
+{
+    while (!finished && next_tick < tick && (next_bits & replay_hash))
+        readEvent();
+}
+
+/**
+ * @brief Gets the inputs recorded for a tick
+ * @param tick Simulation tick (must not decrease between calls)
+ * @return Recorded inputs, or empty input if none were recorded
+ */
+SimInput ReplayReader::read(std::uint64_t tick)
+{
+    SimInput input;
+    skipDigests(tick);
+    if (finished || tick != next_tick || (next_bits & replay_hash))
+        return input;
+
+    input.start = (next_bits & replay_start) != 0;
+    input.flap[0] = (next_bits & replay_flap1) != 0;
+    input.flap[1] = (next_bits & replay_flap2) != 0;
+    input.restart = (next_bits & replay_restart) != 0;
+    readEvent();
+    return input;
+}
+
+/**
+ * @brief Gets the state digest recorded for a tick
+ * @param tick Simulation tick (call after read() for the same tick)
+ * @param digest Receives the recorded digest
+ * @return True if one was recorded
+ */
+bool ReplayReader::readHash(std::uint64_t tick, StateDigest& digest)
+{
+    skipDigests(tick);
+    if (finished || tick != next_tick || !(next_bits & replay_hash))
+        return false;
+
+    digest = next_digest;
+    readEvent();
+    return true;
+}
+
+/**
+ * @brief Checks whether playback has reached the end of the recording
+ * @param tick Current simulation tick
+ * @return True once every recorded tick has been played
+ *
+ * Digests of earlier ticks that nobody read are skipped first, so they
+ * cannot hide the end marker behind them.
+ */
+bool ReplayReader::isFinished(std::uint64_t tick)
+{
+    skipDigests(tick);
+    return finished && tick >= next_tick;
+}
@@ -0,0 +1,171 @@
+/**
+ * @file Replay.h
+ * @brief Header file for replay recording and playback in Flappy Bird 2-player game
+ *
+ * This file defines ReplayWriter and ReplayReader, which store a match as
+ * its pipe course seed plus a tick-stamped log of player inputs. Since the
+ * Simulation is deterministic, replaying the log reproduces the match exactly.
+ *
+ * File layout (all integers little-endian):
+ *   - 4 bytes  magic "FBRP"
+ *   - 1 byte   format version (2 if the file holds state digests, else 1)
+ *   - 1 byte   flags (replay_pixel_collision, replay_state_hashes)
+ *   - 2 bytes  simulation tick rate
+ *   - 8 bytes  pipe course seed
+ *   - events:  LEB128 tick delta since the previous event, then 1 input byte
+ *   - digests: LEB128 tick delta, replay_hash, then a StateDigest (4-byte
+ *              whole-state hash, one byte per StateField) of the state after
+ *              that tick's input was applied; one per tick, after its input
+ *   - end:     LEB128 tick delta to the last simulated tick, then replay_end
+ */
+
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include "Simulation.h"
+#include "StateHash.h"
+
+// Input byte bits
+constexpr std::uint8_t replay_start = 1 << 0;    ///< Enter pressed
+constexpr std::uint8_t replay_flap1 = 1 << 1;    ///< Space pressed (Player 1 flap)
+constexpr std::uint8_t replay_flap2 = 1 << 2;    ///< Up pressed (Player 2 flap)
+constexpr std::uint8_t replay_restart = 1 << 3;  ///< R pressed
+constexpr std::uint8_t replay_hash = 1 << 6;     ///< Event carries a StateDigest instead of input
+constexpr std::uint8_t replay_end = 1 << 7;      ///< Marks the end of the log
+
+// Header flag bits
+constexpr std::uint8_t replay_pixel_collision = 1 << 0;  ///< Match used pixel-exact collisions
+constexpr std::uint8_t replay_state_hashes = 1 << 1;     ///< Every tick's StateDigest is recorded
+
+/**
+ * @class ReplayWriter
+ * @brief Streams a match's input log to disk as it is played
+ */
+class ReplayWriter
+{
+private:
+    std::ofstream file;          ///< Output replay file
+    std::uint64_t last_tick;     ///< Tick of the previously written event
+
+    /**
+     * @brief Writes one event (tick delta and input byte)
+     * @param tick Simulation tick the input applies to
+     * @param bits Input byte
+     */
+    void writeEvent(std::uint64_t tick, std::uint8_t bits);
+
+public:
+    ReplayWriter();
+
+    /**
+     * @brief Closes the replay, writing the end marker
+     */
+    ~ReplayWriter();
+
+    /**
+     * @brief Starts a new replay file and writes its header
+     * @param path File to write
+     * @param seed Pipe course seed of the match
+     * @param flags Header flag bits describing the match rules
+     * @return True if the file could be opened
+     */
+    bool open(const std::string& path, std::uint64_t seed, std::uint8_t flags = 0);
+
+    /**
+     * @brief Records the inputs applied at a tick (nothing is written for empty input)
+     * @param tick Simulation tick the input applies to
+     * @param input Inputs applied at that tick
+     */
+    void record(std::uint64_t tick, const SimInput& input);
+
+    /**
+     * @brief Records the state reached by a tick (only in files opened with replay_state_hashes)
+     * @param tick Simulation tick whose input was just applied
+     * @param hash Simulation state after the tick
+     */
+    void recordHash(std::uint64_t tick, const StateHash& hash);
+
+    /**
+     * @brief Writes the end marker and closes the file
+     * @param end_tick Number of ticks simulated in the match
+     */
+    void close(std::uint64_t end_tick);
+
+    /**
+     * @brief Checks whether a replay is being written
+     * @return True between open() and close()
+     */
+    bool isOpen() const { return file.is_open(); }
+};
+
+/**
+ * @class ReplayReader
+ * @brief Streams a recorded input log back, one tick at a time
+ */
+class ReplayReader
+{
+private:
+    std::ifstream file;          ///< Input replay file
+    std::uint64_t seed;          ///< Pipe course seed of the match
+    std::uint8_t flags;          ///< Header flag bits
+    std::uint64_t next_tick;     ///< Tick of the next pending event
+    std::uint8_t next_bits;      ///< Input byte of the next pending event
+    StateDigest next_digest;     ///< Digest carried by the next pending event, if it is a replay_hash event
+    bool finished;               ///< True once the end marker or end of file was read
+
+    /**
+     * @brief Reads the next event from the file
+     */
+    void readEvent();
+
+    /**
+     * @brief Drops digest events of ticks before a given tick
+     * @param tick Simulation tick about to be read
+     */
+    void skipDigests(std::uint64_t tick);
+
+public:
+    ReplayReader();
+
+    /**
+     * @brief Opens a replay file and reads its header
+     * @param path File to read
+     * @return True if the file is a valid replay for this simulation
+     */
+    bool open(const std::string& path);
+
+    /**
+     * @brief Gets the pipe course seed of the recorded match
+     * @return Seed to pass to Simulation::reset
+     */
+    std::uint64_t getSeed() const { return seed; }
+
+    /**
+     * @brief Gets the header flags of the recorded match
+     * @return Flag bits (replay_pixel_collision, replay_state_hashes)
+     */
+    std::uint8_t getFlags() const { return flags; }
+
+    /**
+     * @brief Gets the inputs recorded for a tick
+     * @param tick Simulation tick (must not decrease between calls)
+     * @return Recorded inputs, or empty input if none were recorded
+     */
+    SimInput read(std::uint64_t tick);
+
+    /**
+     * @brief Gets the state digest recorded for a tick
+     * @param tick Simulation tick (call after read() for the same tick)
+     * @param digest Receives the recorded digest
+     * @return True if one was recorded
+     */
+    bool readHash(std::uint64_t tick, StateDigest& digest);
+
+    /**
+     * @brief Checks whether playback has reached the end of the recording
+     * @param tick Current simulation tick
+     * @return True once every recorded tick has been played
+     */
+    bool isFinished(std::uint64_t tick);
+};
@@ -0,0 +1,39 @@
+/**
+ * @file ResourceCache.cpp
+ * @brief Implementation of the game-wide asset caches for Flappy Bird 2-player game
+ */
+
+#include "ResourceCache.h"
+
+/**
+ * @brief Gets a shared texture
+ * @param path Image file path
+ * @return Shared texture handle
+ */
+std::shared_ptr<Texture> Resources::texture(const std::string& path)
+{
+    static ResourceCache<Texture> textures;
+    return textures.get(path);
+}
+
+/**
+ * @brief Gets a shared font
+ * @param path Font file path
+ * @return Shared font handle
+ */
+std::shared_ptr<Font> Resources::font(const std::string& path)
+{
+    static ResourceCache<Font> fonts;
+    return fonts.get(path);
+}
+
+/**
+ * @brief Gets a shared decoded sound
+ * @param path Sound file path
+ * @return Shared sound buffer handle
+ */
+std::shared_ptr<SoundBuffer> Resources::sound(const std::string& path)
+{
+    static ResourceCache<SoundBuffer> sounds;
+    return sounds.get(path);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file ResourceCache.h
+ * @brief Header file for the shared asset cache in Flappy Bird 2-player game
+ *
+ * This file defines ResourceCache, which loads each asset file once and
+ * hands out reference-counted handles to it, and Resources, which holds
+ * the game-wide caches for textures, fonts and sounds.
+ */
+
+#pragma once
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+using namespace sf;
+
+/**
+ * @class ResourceCache
+ * @brief Path-keyed cache of loaded assets with reference-counted handles
+ * @tparam Resource Any SFML type with loadFromFile(const std::string&)
+ *
+ * The cache only keeps weak references: an asset stays loaded while any
+ * handle to it is alive and is freed with the last one. Asking for the
+ * same path again while it is alive returns the existing asset without
+ * touching the disk or the GPU.
+ */
+template <typename Resource>
+class ResourceCache
+{
+private:
+    std::mutex lock;                                                 ///< Guards entries
+    std::unordered_map<std::string, std::weak_ptr<Resource>> entries;  ///< Loaded assets by path
+
+public:
+    /**
+     * @brief Gets a handle to an asset, loading it on first use
+     * @param path Asset file path
+     * @return Shared handle (an empty resource if the file failed to load)
+     */
+    std::shared_ptr<Resource> get(const std::string& path)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+
+        std::weak_ptr<Resource>& entry = entries[path];
+        std::shared_ptr<Resource> resource = entry.lock();
+        if (!resource)
+        {
+            resource = std::make_shared<Resource>();
+            resource->loadFromFile(path);  // SFML reports failures itself
+            entry = resource;
+        }
+        return resource;
+    }
+};
+
+/**
+ * @class Resources
+ * @brief Game-wide asset caches
+ *
+ * Every class that needs a texture or font asks here instead of loading
+ * its own copy, so entities sharing an asset share one decode and one
+ * GPU upload.
+ */
+class Resources
+{
+public:
+    /**
+     * @brief Gets a shared texture
+     * @param path Image file path
+     * @return Shared texture handle
+     */
+    static std::shared_ptr<Texture> texture(const std::string& path);
+
+    /**
+     * @brief Gets a shared font
+     * @param path Font file path
+     * @return Shared font handle
+     */
+    static std::shared_ptr<Font> font(const std::string& path);
+
+    /**
+     * @brief Gets a shared decoded sound
+     * @param path Sound file path
+     * @return Shared sound buffer handle
+     */
+    static std::shared_ptr<SoundBuffer> sound(const std::string& path);
+};
@@ -0,0 +1,168 @@
+/**
+ * @file RingBuffer.h
+ * @brief Header file for the RingBuffer class template in Flappy Bird 2-player game
+ *
+ * This file defines a fixed-capacity circular buffer used as the pipe
+ * pool: pipes are spawned at the back and retired from the front in O(1),
+ * constructed in place, with no heap traffic during play.
+ */
+
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+
+/**
+ * @class RingBuffer
+ * @brief Fixed-capacity FIFO with in-place construction and random access
+ * @tparam T Element type
+ * @tparam Capacity Maximum number of elements (must be a power of two)
+ *
+ * Storage is embedded in the object, so a RingBuffer never allocates.
+ * Index 0 is always the oldest element (the front).
+ */
+template <typename T, std::size_t Capacity>
+class RingBuffer
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "RingBuffer capacity must be a power of two");
+
+private:
+    alignas(T) unsigned char storage[sizeof(T) * Capacity];  ///< Raw element slots
+    std::size_t head;                                        ///< Slot of the front element
+    std::size_t count;                                       ///< Number of live elements
+
+    /**
+     * @brief Gets the element stored in a physical slot
+     * @param slot Slot index (any value; wrapped to the capacity)
+     * @return Pointer to the slot
+     */
+    T* slot(std::size_t slot) { return reinterpret_cast<T*>(storage) + (slot & (Capacity - 1)); }
+    const T* slot(std::size_t slot) const { return reinterpret_cast<const T*>(storage) + (slot & (Capacity - 1)); }
+
+public:
+    /**
+     * @class Iterator
+     * @brief Random-access iterator from front to back
+     */
+    template <typename Owner, typename Value>
+    class Iterator
+    {
+    private:
+        Owner* ring;             ///< Buffer being iterated
+        std::size_t index;       ///< Logical index (0 = front)
+
+    public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Value value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value* pointer;
+        typedef Value& reference;
+
+        Iterator(Owner* ring, std::size_t index) : ring(ring), index(index) {}
+
+        Value& operator*() const { return (*ring)[index]; }
+        Value* operator->() const { return &(*ring)[index]; }
+        Value& operator[](difference_type n) const { return (*ring)[index + n]; }
+        Iterator& operator++() { ++index; return *this; }
+        Iterator operator++(int) { Iterator old = *this; ++index; return old; }
+        Iterator& operator--() { --index; return *this; }
+        Iterator operator--(int) { Iterator old = *this; --index; return old; }
+        Iterator& operator+=(difference_type n) { index += n; return *this; }
+        Iterator& operator-=(difference_type n) { index -= n; return *this; }
+        Iterator operator+(difference_type n) const { return Iterator(ring, index + n); }
+        Iterator operator-(difference_type n) const { return Iterator(ring, index - n); }
+        difference_type operator-(const Iterator& other) const
+        {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+        }
+        bool operator==(const Iterator& other) const { return index == other.index; }
+        bool operator!=(const Iterator& other) const { return index != other.index; }
+        bool operator<(const Iterator& other) const { return index < other.index; }
+    };
+
+    typedef Iterator<RingBuffer, T> iterator;
+    typedef Iterator<const RingBuffer, const T> const_iterator;
+
+    RingBuffer() : head(0), count(0) {}
+
+    RingBuffer(const RingBuffer& other) : head(0), count(0)
+    {
+        for (const T& item : other)
+            push_back(item);
+    }
+
+    RingBuffer& operator=(const RingBuffer& other)
+    {
+        if (this != &other)
+        {
+            clear();
+            for (const T& item : other)
+                push_back(item);
+        }
+        return *this;
+    }
+
+    ~RingBuffer() { clear(); }
+
+    /**
+     * @brief Constructs a new element in place at the back
+     * @param args Constructor arguments for T
+     * @return Reference to the new element
+     */
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        assert(count < Capacity && "RingBuffer overflow");
+        T* item = new (slot(head + count)) T{ std::forward<Args>(args)... };
+        count++;
+        return *item;
+    }
+
+    /**
+     * @brief Copies an element to the back
+     * @param item Element to add
+     */
+    void push_back(const T& item) { emplace_back(item); }
+
+    /**
+     * @brief Retires the front (oldest) element
+     */
+    void pop_front()
+    {
+        assert(count > 0 && "RingBuffer underflow");
+        slot(head)->~T();
+        head = (head + 1) & (Capacity - 1);
+        count--;
+    }
+
+    /**
+     * @brief Removes every element
+     */
+    void clear()
+    {
+        while (count > 0)
+            pop_front();
+        head = 0;
+    }
+
+    T& operator[](std::size_t index) { return *slot(head + index); }
+    const T& operator[](std::size_t index) const { return *slot(head + index); }
+
+    T& front() { return *slot(head); }
+    const T& front() const { return *slot(head); }
+    T& back() { return *slot(head + count - 1); }
+    const T& back() const { return *slot(head + count - 1); }
+
+    std::size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == Capacity; }
+    static constexpr std::size_t capacity() { return Capacity; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, count); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, count); }
+};
@@ -0,0 +1,343 @@
+/**
+ * @file RollbackSession.cpp
+ * @brief Implementation of rollback netcode for Flappy Bird 2-player game
+ *
+ * This file contains input scheduling and prediction, state saving and
+ * resimulation, and the encoding of input packets:
+ *   - 2 bytes  magic "FB", 1 byte net_packet_input
+ *   - 1 byte   signed frame advantage of the sender
+ *   - 4 bytes  remote inputs received (acknowledges the receiver's inputs)
+ *   - 4 bytes  sender's tick
+ *   - 4 bytes  newest confirmed checkpoint tick (0 = none), 4 bytes its hash
+ *   - 4 bytes  tick of the first input, 1 byte input count, one byte per input
+ * Ticks are sent as their low 32 bits, little-endian.
+ */
+
+#include "RollbackSession.h"
+#include "ByteOrder.h"
+#include <algorithm>
+#include <cstring>
+
+static const std::uint64_t no_tick = ~static_cast<std::uint64_t>(0);
+static const std::size_t input_header = 25;   ///< Bytes before the inputs of an input packet
+
+/**
+ * @brief Constructor - starts a session at the Simulation's current (freshly reset) state
+ * @param simulation Match to play (kept, not copied)
+ * @param player Bird flown by this peer (0 or 1)
+ * @param delay Ticks between a key press and the tick it applies to
+ *
+ * The first input_delay ticks have no local keys; they are scheduled as
+ * empty inputs right away.
+ */
+RollbackSession::RollbackSession(Simulation& simulation, int player, int delay) :
+sim(simulation),
+local_player(player),
+input_delay(std::max(0, std::min(delay, max_rollback))),
+local_end(0),
+remote_end(0),
+acked(0),
+first_wrong(no_tick),
+confirmed(0),
+desync_tick(0),
+remote_tick(0),
+remote_advantage(0),
+last_wait(0)
+{
+    std::memset(local_inputs, 0, sizeof(local_inputs));
+    std::memset(remote_inputs, 0, sizeof(remote_inputs));
+    std::memset(used_inputs, 0, sizeof(used_inputs));
+    std::memset(hashes, 0, sizeof(hashes));
+    local_end = static_cast<std::uint64_t>(input_delay);
+}
+
+/**
+ * @brief Combines both players' bits into Simulation input
+ * @param player0 Bits of the peer flying bird 0
+ * @param player1 Bits of the peer flying bird 1
+ * @return Input with either peer's start and restart, and each peer's own flap
+ */
+SimInput RollbackSession::combine(std::uint8_t player0, std::uint8_t player1)
+{
+    SimInput input;
+    input.start = ((player0 | player1) & net_start) != 0;
+    input.flap[0] = (player0 & net_flap) != 0;
+    input.flap[1] = (player1 & net_flap) != 0;
+    input.restart = ((player0 | player1) & net_restart) != 0;
+    return input;
+}
+
+/**
+ * @brief Schedules this peer's keys for the next free tick
+ * @param bits net_start, net_flap and net_restart bits pressed since the last accepted input
+ * @return True if accepted; false while the schedule is input_delay ticks ahead (keep the bits)
+ *
+ * Also refuses while the other peer has not acknowledged a whole input
+ * ring's worth of inputs, since those still have to be resent.
+ */
+bool RollbackSession::addLocalInput(std::uint8_t bits)
+{
+    if (local_end > sim.getTick() + static_cast<std::uint64_t>(input_delay))
+        return false;
+    if (local_end - acked >= static_cast<std::uint64_t>(input_slots))
+        return false;
+    local_inputs[local_end % input_slots] = bits;
+    local_end++;
+    return true;
+}
+
+/**
+ * @brief Saves the state before the next tick, with its hash
+ */
+void RollbackSession::saveState()
+{
+    std::uint64_t tick = sim.getTick();
+    sim.saveState(states[tick % state_slots]);
+
+    StateHash hash;
+    sim.hashState(hash);
+    hashes[tick % state_slots] = static_cast<std::uint32_t>(hash.combined());
+}
+
+/**
+ * @brief Steps the simulation one tick with the inputs known for it
+ *
+ * Remote inputs not received yet are predicted as no keys; the input
+ * actually used is remembered so a late arrival can be checked against it.
+ */
+void RollbackSession::stepTick()
+{
+    std::uint64_t tick = sim.getTick();
+    std::uint8_t local = local_inputs[tick % input_slots];
+    std::uint8_t remote = tick < remote_end ? remote_inputs[tick % input_slots] : 0;
+    used_inputs[tick % input_slots] = remote;
+
+    saveState();
+    sim.step(local_player == 0 ? combine(local, remote) : combine(remote, local));
+}
+
+/**
+ * @brief Restores the state before the first mispredicted tick and steps back to the present
+ */
+void RollbackSession::rollback()
+{
+    std::uint64_t present = sim.getTick();
+    int depth = static_cast<int>(present - first_wrong);
+
+    sim.loadState(states[first_wrong % state_slots]);
+    while (sim.getTick() < present)
+        stepTick();
+
+    stats.rollbacks++;
+    stats.resimulated += static_cast<std::uint64_t>(depth);
+    stats.max_depth = std::max(stats.max_depth, depth);
+    first_wrong = no_tick;
+}
+
+/**
+ * @brief Corrects any misprediction, then steps one tick if possible
+ * @return True if a tick was stepped; false while waiting for the other peer
+ *
+ * A tick can be stepped once it has a local input and is at most
+ * max_rollback ticks past the last remote input.
+ */
+bool RollbackSession::advance()
+{
+    if (first_wrong < sim.getTick())
+        rollback();
+    first_wrong = no_tick;
+
+    std::uint64_t tick = sim.getTick();
+    bool stepped = tick < local_end && tick < remote_end + max_rollback;
+    if (stepped)
+        stepTick();
+    else
+        stats.stalls++;
+
+    confirm();
+    return stepped;
+}
+
+/**
+ * @brief Checks whether this peer should skip a tick so the other can catch up
+ * @return True if this peer runs ahead by two or more ticks (at most every few ticks)
+ *
+ * Each peer measures how far it is ahead of the tick in the other's
+ * newest packet. Both measurements include the one-way latency, so half
+ * their difference is how far ahead this peer really is.
+ */
+bool RollbackSession::shouldWait()
+{
+    std::uint64_t tick = sim.getTick();
+    if (remote_tick == 0 || tick < last_wait + max_rollback)
+        return false;
+
+    int local_advantage = static_cast<int>(static_cast<std::int64_t>(tick) - static_cast<std::int64_t>(remote_tick));
+    if ((local_advantage - remote_advantage) / 2 < 2)
+        return false;
+
+    last_wait = tick;
+    stats.waits++;
+    return true;
+}
+
+/**
+ * @brief Records the hashes of newly confirmed checkpoints
+ *
+ * The state before tick t is confirmed once every tick before it was
+ * stepped with real inputs from both peers.
+ */
+void RollbackSession::confirm()
+{
+    std::uint64_t tick = sim.getTick();
+    std::uint64_t now_confirmed = std::min(remote_end, tick);
+
+    for (std::uint64_t t = confirmed + 1; t <= now_confirmed; t++)
+    {
+        if (t % check_interval != 0)
+            continue;
+
+        std::uint32_t hash;
+        if (t == tick)
+        {
+            StateHash state_hash;
+            sim.hashState(state_hash);
+            hash = static_cast<std::uint32_t>(state_hash.combined());
+        }
+        else
+        {
+            hash = hashes[t % state_slots];
+        }
+
+        Checkpoint& check = local_checks[(t / check_interval) % check_slots];
+        check.tick = t;
+        check.hash = hash;
+        compare(t);
+    }
+    confirmed = std::max(confirmed, now_confirmed);
+}
+
+/**
+ * @brief Compares own and remote hashes of a checkpoint, if both are known
+ * @param tick Checkpoint tick
+ *
+ * Called once when each side's hash arrives, so a checkpoint is counted
+ * once, by whichever hash comes second.
+ */
+void RollbackSession::compare(std::uint64_t tick)
+{
+    const Checkpoint& local = local_checks[(tick / check_interval) % check_slots];
+    const Checkpoint& remote = remote_checks[(tick / check_interval) % check_slots];
+    if (local.tick != tick || remote.tick != tick)
+        return;
+    if (local.hash == remote.hash)
+        stats.checks++;
+    else if (desync_tick == 0)
+        desync_tick = tick;
+}
+
+/**
+ * @brief Gets the hash of the newest own checkpoint
+ * @param tick Receives the checkpoint tick (0 if none yet)
+ * @return Hash of the confirmed state before that tick
+ */
+std::uint32_t RollbackSession::getCheckpoint(std::uint64_t& tick) const
+{
+    tick = confirmed / check_interval * check_interval;
+    const Checkpoint& check = local_checks[(tick / check_interval) % check_slots];
+    if (tick == 0 || check.tick != tick)
+    {
+        tick = 0;
+        return 0;
+    }
+    return check.hash;
+}
+
+/**
+ * @brief Builds the next packet for the other peer
+ * @param buffer At least max_packet bytes
+ * @return Packet size in bytes
+ *
+ * Holds every local input from the first unacknowledged one, up to
+ * max_resend of them.
+ */
+std::size_t RollbackSession::writePacket(std::uint8_t* buffer) const
+{
+    std::uint64_t tick = sim.getTick();
+    std::uint64_t check_tick;
+    std::uint32_t check_hash = getCheckpoint(check_tick);
+    int advantage = static_cast<int>(static_cast<std::int64_t>(tick) - static_cast<std::int64_t>(remote_tick));
+    std::size_t count = static_cast<std::size_t>(std::min<std::uint64_t>(local_end - acked, max_resend));
+
+    buffer[0] = 'F';
+    buffer[1] = 'B';
+    buffer[2] = net_packet_input;
+    buffer[3] = static_cast<std::uint8_t>(static_cast<std::int8_t>(std::max(-127, std::min(127, advantage))));
+    putLE(buffer + 4, static_cast<std::uint32_t>(remote_end), 4);
+    putLE(buffer + 8, static_cast<std::uint32_t>(tick), 4);
+    putLE(buffer + 12, static_cast<std::uint32_t>(check_tick), 4);
+    putLE(buffer + 16, check_hash, 4);
+    putLE(buffer + 20, static_cast<std::uint32_t>(acked), 4);
+    buffer[24] = static_cast<std::uint8_t>(count);
+    for (std::size_t i = 0; i < count; i++)
+        buffer[input_header + i] = local_inputs[(acked + i) % input_slots];
+    return input_header + count;
+}
+
+/**
+ * @brief Applies a packet from the other peer
+ * @param data Packet bytes
+ * @param size Packet size in bytes
+ * @return True if it was a valid input packet
+ *
+ * Inputs already received are skipped and a gap (an older packet
+ * arriving late) ends the read; the next packet resends from our
+ * acknowledgement anyway. An input that changes an already simulated
+ * tick marks the tick for rollback on the next advance().
+ */
+bool RollbackSession::readPacket(const std::uint8_t* data, std::size_t size)
+{
+    if (size < input_header || data[0] != 'F' || data[1] != 'B' || data[2] != net_packet_input)
+        return false;
+    std::size_t count = data[24];
+    if (size < input_header + count)
+        return false;
+
+    std::uint64_t ack = getLE(data + 4, 4);
+    if (ack > acked && ack <= local_end)
+        acked = ack;
+
+    std::uint64_t sent_tick = getLE(data + 8, 4);
+    if (sent_tick >= remote_tick)
+    {
+        remote_tick = sent_tick;
+        remote_advantage = static_cast<std::int8_t>(data[3]);
+    }
+
+    std::uint64_t check_tick = getLE(data + 12, 4);
+    Checkpoint& check = remote_checks[(check_tick / check_interval) % check_slots];
+    if (check_tick != 0 && check_tick % check_interval == 0 && check.tick != check_tick)
+    {
+        check.tick = check_tick;
+        check.hash = static_cast<std::uint32_t>(getLE(data + 16, 4));
+        compare(check_tick);
+    }
+
+    std::uint64_t start = getLE(data + 20, 4);
+    std::uint64_t tick = sim.getTick();
+    for (std::size_t i = 0; i < count; i++)
+    {
+        std::uint64_t t = start + i;
+        if (t < remote_end)
+            continue;
+        if (t > remote_end || t >= tick + input_slots - state_slots)
+            break;
+
+        std::uint8_t bits = data[input_header + i];
+        remote_inputs[t % input_slots] = bits;
+        if (t < tick && used_inputs[t % input_slots] != bits)
+            first_wrong = std::min(first_wrong, t);
+        remote_end++;
+    }
+    return true;
+}
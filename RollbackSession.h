@@ -0,0 +1,221 @@
+/**
+ * @file RollbackSession.h
+ * @brief Header file for the RollbackSession class in Flappy Bird 2-player game
+ *
+ * This file defines the rollback logic of an online match: each peer
+ * steps its own Simulation without waiting for the other, predicts the
+ * inputs it has not received yet, and when the real ones arrive and
+ * differ, restores the state saved before the first wrong tick and
+ * simulates forward again. The class only builds and reads packets;
+ * NetPeer moves them over a socket.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Simulation.h"
+
+/// Input bits of one player for one tick, as sent to the other peer
+constexpr std::uint8_t net_start = 1 << 0;     ///< Enter pressed
+constexpr std::uint8_t net_flap = 1 << 1;      ///< Own bird's flap key pressed
+constexpr std::uint8_t net_restart = 1 << 2;   ///< R pressed
+
+/// Packet types, the third byte of every packet after the 'F', 'B' magic
+constexpr std::uint8_t net_packet_input = 1;     ///< Inputs, acknowledgement and checkpoint (RollbackSession)
+constexpr std::uint8_t net_packet_hello = 2;     ///< Guest asks to join (NetPeer)
+constexpr std::uint8_t net_packet_welcome = 3;   ///< Host accepts and sends the match settings (NetPeer)
+
+/**
+ * @struct RollbackStats
+ * @brief Counters describing how much rolling back a match needed
+ */
+struct RollbackStats
+{
+    std::uint64_t rollbacks = 0;          ///< Times a wrong prediction was corrected
+    std::uint64_t resimulated = 0;        ///< Ticks stepped again while correcting
+    int max_depth = 0;                    ///< Most ticks rolled back at once
+    std::uint64_t stalls = 0;             ///< Calls to advance() that had to wait for the other peer
+    std::uint64_t waits = 0;              ///< Ticks skipped to let a slower peer catch up
+    std::uint64_t checks = 0;             ///< Checkpoints both peers hashed alike
+};
+
+/**
+ * @class RollbackSession
+ * @brief GGPO-style input prediction and rollback for a two-player Simulation
+ *
+ * Local inputs are scheduled input_delay ticks ahead, which hides that
+ * much latency without any rollback. Remote inputs that have not arrived
+ * are predicted as "no keys": every game key is a one-tick press, so the
+ * prediction is right on almost every tick and only presses cost a
+ * rollback.
+ *
+ * The state before each tick is saved (a SimState copy) along with its
+ * hash, in rings covering the last state_slots ticks. Once a remote
+ * input for an already simulated tick differs from what was predicted,
+ * the next advance() restores the state before that tick and steps
+ * forward again with the corrected inputs. A peer never runs more than
+ * max_rollback ticks past the last remote input it has, so a correction
+ * never reaches further back than the saved states.
+ *
+ * Every input packet resends all local inputs the other peer has not
+ * acknowledged, so lost packets need no retransmission logic. Packets
+ * also carry the hash of the newest confirmed checkpoint (every
+ * check_interval ticks); two peers whose hashes differ have desynced.
+ * The tick and frame advantage in each packet let the peer that runs
+ * ahead wait a tick now and then instead of rolling back all the time.
+ */
+class RollbackSession
+{
+public:
+    static constexpr int max_rollback = 8;          ///< Most ticks simulated past the last remote input
+    static constexpr int state_slots = 16;          ///< Saved states and hashes (more than max_rollback)
+    static constexpr int input_slots = 128;         ///< Remembered inputs per player
+    static constexpr int max_resend = 64;           ///< Most inputs sent in one packet
+    static constexpr int check_interval = 30;       ///< Ticks between desync checkpoints
+    static constexpr int check_slots = 16;          ///< Remembered checkpoints per peer
+    static constexpr std::size_t max_packet = 32 + max_resend;  ///< Largest packet built
+
+private:
+    /**
+     * @struct Checkpoint
+     * @brief Hash of the confirmed state before a checkpoint tick
+     */
+    struct Checkpoint
+    {
+        std::uint64_t tick = 0;       ///< Checkpoint tick (0 = none yet)
+        std::uint32_t hash = 0;       ///< Low bits of StateHash::combined()
+    };
+
+    Simulation& sim;                                 ///< Match being played
+    int local_player;                                ///< Bird flown by this peer (0 or 1)
+    int input_delay;                                 ///< Ticks between a key press and its tick
+
+    std::uint8_t local_inputs[input_slots];          ///< This peer's inputs by tick
+    std::uint8_t remote_inputs[input_slots];         ///< Received inputs of the other peer by tick
+    std::uint8_t used_inputs[input_slots];           ///< Remote input each simulated tick was stepped with
+    std::uint64_t local_end;                         ///< Ticks with a local input
+    std::uint64_t remote_end;                        ///< Ticks with a received remote input (contiguous)
+    std::uint64_t acked;                             ///< Local inputs the other peer has acknowledged
+    std::uint64_t first_wrong;                       ///< Earliest tick stepped with a wrong prediction (UINT64_MAX = none)
+
+    SimState states[state_slots];                    ///< State before each recent tick
+    std::uint32_t hashes[state_slots];               ///< Hash of each saved state
+    std::uint64_t confirmed;                         ///< Ticks whose state can no longer change
+    Checkpoint local_checks[check_slots];            ///< Own hashes of recent checkpoints
+    Checkpoint remote_checks[check_slots];           ///< The other peer's hashes of recent checkpoints
+    std::uint64_t desync_tick;                       ///< First checkpoint the peers disagree on (0 = none)
+
+    std::uint64_t remote_tick;                       ///< Other peer's tick in its newest packet
+    int remote_advantage;                            ///< Ticks the other peer said it was ahead
+    std::uint64_t last_wait;                         ///< Tick of the last wait for the other peer
+
+    RollbackStats stats;                             ///< Rollback counters
+
+    /**
+     * @brief Saves the state before the next tick, with its hash
+     */
+    void saveState();
+
+    /**
+     * @brief Steps the simulation one tick with the inputs known for it
+     */
+    void stepTick();
+
+    /**
+     * @brief Restores the state before the first mispredicted tick and steps back to the present
+     */
+    void rollback();
+
+    /**
+     * @brief Records the hashes of newly confirmed checkpoints
+     */
+    void confirm();
+
+    /**
+     * @brief Compares own and remote hashes of a checkpoint, if both are known
+     * @param tick Checkpoint tick
+     */
+    void compare(std::uint64_t tick);
+
+public:
+    /**
+     * @brief Constructor - starts a session at the Simulation's current (freshly reset) state
+     * @param simulation Match to play (kept, not copied)
+     * @param player Bird flown by this peer (0 or 1)
+     * @param delay Ticks between a key press and the tick it applies to
+     */
+    RollbackSession(Simulation& simulation, int player, int delay = 2);
+
+    /**
+     * @brief Schedules this peer's keys for the next free tick
+     * @param bits net_start, net_flap and net_restart bits pressed since the last accepted input
+     * @return True if accepted; false while the schedule is input_delay ticks ahead (keep the bits)
+     */
+    bool addLocalInput(std::uint8_t bits);
+
+    /**
+     * @brief Corrects any misprediction, then steps one tick if possible
+     * @return True if a tick was stepped; false while waiting for the other peer
+     */
+    bool advance();
+
+    /**
+     * @brief Checks whether this peer should skip a tick so the other can catch up
+     * @return True if this peer runs ahead by two or more ticks (at most every few ticks)
+     */
+    bool shouldWait();
+
+    /**
+     * @brief Builds the next packet for the other peer
+     * @param buffer At least max_packet bytes
+     * @return Packet size in bytes
+     */
+    std::size_t writePacket(std::uint8_t* buffer) const;
+
+    /**
+     * @brief Applies a packet from the other peer
+     * @param data Packet bytes
+     * @param size Packet size in bytes
+     * @return True if it was a valid input packet
+     */
+    bool readPacket(const std::uint8_t* data, std::size_t size);
+
+    /**
+     * @brief Combines both players' bits into Simulation input
+     * @param player0 Bits of the peer flying bird 0
+     * @param player1 Bits of the peer flying bird 1
+     * @return Input with either peer's start and restart, and each peer's own flap
+     */
+    static SimInput combine(std::uint8_t player0, std::uint8_t player1);
+
+    /**
+     * @brief Gets the bird flown by this peer
+     * @return Player index (0 or 1)
+     */
+    int getLocalPlayer() const { return local_player; }
+
+    /**
+     * @brief Gets the number of ticks whose state can no longer change
+     * @return Ticks stepped with both peers' real inputs
+     */
+    std::uint64_t getConfirmedTick() const { return confirmed; }
+
+    /**
+     * @brief Gets the first checkpoint where the peers' states differed
+     * @return Checkpoint tick, or 0 while they agree
+     */
+    std::uint64_t getDesyncTick() const { return desync_tick; }
+
+    /**
+     * @brief Gets the hash of the newest own checkpoint
+     * @param tick Receives the checkpoint tick (0 if none yet)
+     * @return Hash of the confirmed state before that tick
+     */
+    std::uint32_t getCheckpoint(std::uint64_t& tick) const;
+
+    /**
+     * @brief Gets the rollback counters
+     * @return Counters since the session started
+     */
+    const RollbackStats& getStats() const { return stats; }
+};
@@ -0,0 +1,103 @@
+/**
+ * @file Rollout.cpp
+ * @brief Implementation of the RolloutModel class for Flappy Bird 2-player game
+ */
+
+#include "Rollout.h"
+#include "Globals.h"
+
+/**
+ * @brief Constructor - copies the rules of a match
+ * @param sim Match to model
+ * @param player Bird the model is for (0 or 1)
+ * @param margin Pixels the gap is shrunk by on each side
+ */
+RolloutModel::RolloutModel(const Simulation& sim, int player, float margin) :
+gravity(static_cast<float>(sim.getConfig().gravity)),
+flap_speed(static_cast<float>(sim.getConfig().birdflapspeed)),
+pipe_step(sim.getConfig().pipe_move_speed * Simulation::tick_dt),
+gap(static_cast<float>(sim.getConfig().pipe_distance)),
+bird_x(sim.getBird(player).x),
+margin(margin),
+spawn_time(sim.getPipeSpawnTime()),
+stream(sim.getPipeStream())
+{
+}
+
+/**
+ * @brief Copies one bird's current situation out of a match
+ * @param sim Match to copy (the same one the model was made from)
+ * @param player Bird to copy (0 or 1)
+ * @param state State to overwrite
+ *
+ * Pipes the bird has already passed are left out; if more pipes are
+ * ahead than a state can hold, the farthest ones are dropped.
+ */
+void RolloutModel::capture(const Simulation& sim, int player, RolloutState& state) const
+{
+    BirdState bird = sim.getBird(player);
+    state.y = bird.y;
+    state.velocity = bird.velocity;
+    state.alive = bird.active;
+    state.pipe_counter = sim.getPipeCounter();
+    state.pipe_index = sim.getNextPipeIndex();
+    state.first_pipe = 0;
+    state.pipe_end = 0;
+
+    for (const PipeState& pipe : sim.getPipes())
+    {
+        if (pipe.x + pipe_width <= bird_x || state.pipe_end == RolloutState::max_pipes)
+            continue;
+        RolloutPipe& kept = state.pipes[state.pipe_end++];
+        kept.x = pipe.x;
+        kept.gap_top = pipe.y_pos - pipe.gap;
+        kept.gap_bottom = pipe.y_pos;
+    }
+}
+
+/**
+ * @brief Advances a state by one tick
+ * @param state State to advance (left unchanged once the bird is dead)
+ * @param flap True to flap this tick
+ */
+void RolloutModel::step(RolloutState& state, bool flap) const
+{
+    if (!state.alive)
+        return;
+
+    if (flap)
+        state.velocity = -flap_speed;
+
+    // Spawn new pipes on the simulation's schedule
+    if (state.pipe_counter > spawn_time)
+    {
+        if (state.pipe_end < RolloutState::max_pipes)
+        {
+            RolloutPipe& pipe = state.pipes[state.pipe_end++];
+            float y_pos = static_cast<float>(stream.getHeight(state.pipe_index));
+            pipe.x = static_cast<float>(window_width);
+            pipe.gap_top = y_pos - gap;
+            pipe.gap_bottom = y_pos;
+        }
+        state.pipe_index++;
+        state.pipe_counter = 0;
+    }
+    state.pipe_counter++;
+
+    for (int i = state.first_pipe; i < state.pipe_end; i++)
+        state.pipes[i].x -= pipe_step;
+    while (state.first_pipe < state.pipe_end && state.pipes[state.first_pipe].x + pipe_width <= bird_x)
+        state.first_pipe++;
+
+    // Pipes are in spawn order, so the ones level with the bird come first
+    float top = state.y, bottom = state.y + bird_height;
+    bool hit = state.y >= Simulation::ground_line;
+    for (int i = state.first_pipe; i < state.pipe_end && state.pipes[i].x < bird_x + bird_width; i++)
+        hit = hit || top < state.pipes[i].gap_top + margin || bottom > state.pipes[i].gap_bottom - margin;
+    state.alive = !hit;
+
+    state.velocity += gravity * Simulation::tick_dt;
+    state.y += state.velocity * Simulation::tick_dt;
+    if (state.y < 0.f)
+        state.y = 0.f;
+}
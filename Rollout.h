@@ -0,0 +1,96 @@
+/**
+ * @file Rollout.h
+ * @brief Header file for the RolloutModel class in Flappy Bird 2-player game
+ *
+ * This file defines a compact copy of one bird's view of a match and a
+ * stripped-down copy of the game rules that steps it, for bots that try
+ * out many possible futures before choosing an input.
+ */
+
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include "PipeStream.h"
+#include "Simulation.h"
+
+/**
+ * @struct RolloutPipe
+ * @brief One pipe pair reduced to its left edge and gap
+ */
+struct RolloutPipe
+{
+    float x;                 ///< Left edge of both pipe segments
+    float gap_top;           ///< Bottom edge of the upper segment
+    float gap_bottom;        ///< Top edge of the lower segment
+};
+
+/**
+ * @struct RolloutState
+ * @brief Everything that decides whether one bird survives the next ticks
+ *
+ * Plain data of fixed size, so a rollout starts from a copy of the root
+ * state with no allocation. Only pipes the bird has not yet passed are
+ * kept, in the order they spawned.
+ */
+struct RolloutState
+{
+    static constexpr int max_pipes = 8;   ///< Pipes tracked at once (later spawns are dropped)
+
+    float y;                 ///< Top edge of the bird's collision box
+    float velocity;          ///< Vertical velocity of the bird (pixels per second)
+    bool alive;              ///< False once the bird has hit a pipe or the ground
+    std::int32_t pipe_counter;     ///< Ticks since the last pipe spawned
+    std::uint64_t pipe_index;      ///< Course index of the next pipe to spawn
+    std::int32_t first_pipe;       ///< First pipe the bird has not passed
+    std::int32_t pipe_end;         ///< One past the last spawned pipe
+    RolloutPipe pipes[max_pipes];  ///< Pipes in spawn order
+};
+
+static_assert(std::is_trivially_copyable<RolloutState>::value, "RolloutState must copy as plain bytes");
+
+/**
+ * @class RolloutModel
+ * @brief The match rules as they affect one bird, on RolloutState
+ *
+ * Follows Simulation's order within a tick: flap, spawn and move pipes,
+ * test collisions, then apply gravity. Collisions are box tests at the
+ * end of each tick, with the gap shrunk by a safety margin so the bot
+ * keeps clear of the cases the simulation's swept and pixel-exact tests
+ * could decide differently.
+ */
+class RolloutModel
+{
+private:
+    float gravity;           ///< Gravitational acceleration (pixels per second squared)
+    float flap_speed;        ///< Upward velocity applied by a flap (pixels per second)
+    float pipe_step;         ///< Distance pipes move per tick
+    float gap;               ///< Vertical gap between pipe segments
+    float bird_x;            ///< Left edge of the bird's collision box (never changes)
+    float margin;            ///< Pixels the gap is shrunk by on each side
+    std::int32_t spawn_time; ///< Ticks between pipe spawns
+    PipeStream stream;       ///< Pipe course of the match
+
+public:
+    /**
+     * @brief Constructor - copies the rules of a match
+     * @param sim Match to model
+     * @param player Bird the model is for (0 or 1)
+     * @param margin Pixels the gap is shrunk by on each side
+     */
+    RolloutModel(const Simulation& sim, int player, float margin = 3.f);
+
+    /**
+     * @brief Copies one bird's current situation out of a match
+     * @param sim Match to copy (the same one the model was made from)
+     * @param player Bird to copy (0 or 1)
+     * @param state State to overwrite
+     */
+    void capture(const Simulation& sim, int player, RolloutState& state) const;
+
+    /**
+     * @brief Advances a state by one tick
+     * @param state State to advance (left unchanged once the bird is dead)
+     * @param flap True to flap this tick
+     */
+    void step(RolloutState& state, bool flap) const;
+};
@@ -0,0 +1,182 @@
+/**
+ * @file Server.cpp
+ * @brief Command-line headless match server
+ *
+ * Hosts many two-player matches with the MatchServer class until
+ * interrupted, printing its load every few seconds.
+ *
+ * Command line options:
+ *   --port <n>            UDP port (default 7100)
+ *   --threads <n>         Workers stepping matches, 0 = one per hardware thread (default 1)
+ *   --max-matches <n>     Matches allocated up front, at most 65536 (default 1024)
+ *   --send-rate <hz>      State packets per second to each client, at most 120 (default 60)
+ *   --stats <s>           Seconds between load reports, 0 = none (default 5)
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "AllocationTracker.h"
+#include "MatchServer.h"
+
+static std::atomic<bool> stop_requested(false);   ///< Set by SIGINT and SIGTERM
+
+/**
+ * @brief Signal handler - asks the main loop to stop
+ * @param signal Signal number (unused)
+ */
+static void requestStop(int)
+{
+    stop_requested = true;
+}
+
+/**
+ * @brief Parses a whole argument as an integer in a range
+ * @param text Argument
+ * @param min Smallest value accepted
+ * @param max Largest value accepted
+ * @param value Receives the value
+ * @return True if text is a number between min and max
+ */
+static bool parseInteger(const std::string& text, long min, long max, long& value)
+{
+    char* end = nullptr;
+    errno = 0;
+    value = std::strtol(text.c_str(), &end, 10);
+    return end != text.c_str() && *end == '\0' && errno == 0 && value >= min && value <= max;
+}
+
+/**
+ * @brief Main function - server entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
+ * @return 0 on a clean stop, 1 on bad arguments or if the port could not be opened
+ */
+int main(int argc, char* argv[])
+{
+    ServerConfig config;
+    float stats_seconds = 5.f;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        long number = 0;
+        if (arg == "--port")
+        {
+            if (!parseInteger(value, 1, 65535, number))
+            {
+                std::cerr << "--port takes a port between 1 and 65535" << std::endl;
+                return 1;
+            }
+            config.port = static_cast<unsigned short>(number);
+        }
+        else if (arg == "--threads")
+        {
+            if (!parseInteger(value, 0, 256, number))
+            {
+                std::cerr << "--threads takes a count between 0 and 256" << std::endl;
+                return 1;
+            }
+            config.threads = static_cast<unsigned>(number);
+        }
+        else if (arg == "--max-matches")
+        {
+            if (!parseInteger(value, 1, MatchServer::max_slots, number))
+            {
+                std::cerr << "--max-matches takes a count between 1 and " << MatchServer::max_slots << std::endl;
+                return 1;
+            }
+            config.max_matches = static_cast<std::size_t>(number);
+        }
+        else if (arg == "--send-rate")
+        {
+            if (!parseInteger(value, 1, Simulation::tick_rate, number))
+            {
+                std::cerr << "--send-rate takes a rate between 1 and " << Simulation::tick_rate << " Hz" << std::endl;
+                return 1;
+            }
+            config.send_interval = Simulation::tick_rate / static_cast<int>(number);
+        }
+        else if (arg == "--stats")
+        {
+            char* end = nullptr;
+            stats_seconds = std::strtof(value.c_str(), &end);
+            if (end == value.c_str() || *end != '\0' || !(stats_seconds >= 0.f))
+            {
+                std::cerr << "--stats takes a number of seconds, 0 or more" << std::endl;
+                return 1;
+            }
+        }
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::uint64_t bytes_before = AllocationTracker::getCounts().bytes;
+    MatchServer server(config);
+    std::uint64_t bytes_allocated = AllocationTracker::getCounts().bytes - bytes_before;
+    if (!server.open())
+    {
+        std::cerr << "Could not open UDP port " << config.port << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+    std::cout << "Serving up to " << config.max_matches << " matches on UDP port " << server.getPort()
+              << " (" << sizeof(MatchServer) << " + " << config.max_matches << " match slots";
+    if (AllocationTracker::isEnabled())
+        std::cout << ", " << bytes_allocated / std::max<std::size_t>(1, config.max_matches) << " bytes each";
+    std::cout << ")" << std::endl;
+
+    typedef std::chrono::steady_clock steady_clock;
+    auto last_report = steady_clock::now();
+    ServerStats last = server.getStats();
+    while (!stop_requested)
+    {
+        server.update();
+
+        auto now = steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - last_report).count();
+        if (stats_seconds <= 0.f || elapsed < stats_seconds)
+            continue;
+
+        // Load since the last report
+        const ServerStats& stats = server.getStats();
+        std::uint64_t ticks = stats.ticks - last.ticks;
+        std::uint64_t match_ticks = stats.match_ticks - last.match_ticks;
+        std::uint64_t packets_out = stats.packets_out - last.packets_out;
+        std::uint64_t bytes_out = stats.bytes_out - last.bytes_out;
+        double tick_us = std::chrono::duration<double, std::micro>(stats.tick_time - last.tick_time).count();
+        std::cout << std::fixed << std::setprecision(1)
+                  << server.getMatchCount() << " matches, " << server.getClientCount() << " clients | "
+                  << ticks / elapsed << " ticks/s, "
+                  << (ticks ? tick_us / ticks : 0.0) << " us/tick, "
+                  << (match_ticks ? 1000.0 * tick_us / match_ticks : 0.0) << " ns/match-tick | "
+                  << (stats.packets_in - last.packets_in) / elapsed << " in/s, "
+                  << packets_out / elapsed << " out/s, "
+                  << (packets_out ? static_cast<double>(bytes_out) / packets_out : 0.0) << " B/packet"
+                  << std::endl;
+        last = stats;
+        last_report = now;
+    }
+
+    std::cout << "Stopped after " << server.getStats().ticks << " ticks" << std::endl;
+    return 0;
+}
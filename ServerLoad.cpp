@@ -0,0 +1,314 @@
+/**
+ * @file ServerLoad.cpp
+ * @brief Command-line load test of a match server
+ *
+ * Connects two bot clients per match to a running flappy_server and
+ * plays for a while in real time. Each client decodes every state delta
+ * against the state it acknowledged and checks the result against the
+ * packet's checksum, flies its bird from the decoded state, and resends
+ * its key presses until the server confirms them.
+ *
+ * Command line options:
+ *   --server <ip:port>    Server to load (default 127.0.0.1:7100)
+ *   --matches <n>         Matches to play, two clients each (default 100)
+ *   --seconds <s>         Seconds of play (default 20)
+ *   --first-key <n>       Match key of the first match (default 1)
+ *
+ * Exits with 0 if every state decoded correctly, 1 on bad arguments,
+ * socket errors or a bad state.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SFML/Network.hpp>
+#include "ByteOrder.h"
+#include "Globals.h"
+#include "MatchServer.h"
+
+using namespace sf;
+
+/**
+ * @struct LoadClient
+ * @brief One bot player connected to the server
+ */
+struct LoadClient
+{
+    static constexpr int kept = 32;            ///< Decoded states kept as delta bases
+
+    UdpSocket socket;                          ///< This client's own port
+    std::uint32_t key = 0;                     ///< Match key to join
+    bool welcomed = false;                     ///< True once the server granted a seat
+    std::uint16_t slot = 0;                    ///< Match slot from the welcome
+    int player = 0;                            ///< Bird this client flies
+    std::uint32_t token = 0;                   ///< Token from the welcome
+    WireState states[kept];                    ///< Recently decoded states
+    int next_state = 0;                        ///< Ring position of the next decoded state
+    std::uint32_t newest = 0;                  ///< Tick of the newest decoded state (0 = none)
+    std::uint16_t seq = 0;                     ///< Number of the last key packet sent
+    std::uint16_t confirmed = 0;               ///< Number of the last key packet the server applied
+    std::uint8_t bits = 0;                     ///< Keys of packet seq
+    std::uint64_t received = 0;                ///< State packets received
+    std::uint64_t bytes = 0;                   ///< Bytes of state packets received
+    std::uint64_t mismatches = 0;              ///< States whose checksum did not match
+    std::uint64_t missing = 0;                 ///< Deltas against a state this client did not keep
+
+    /**
+     * @brief Finds a kept state
+     * @param tick Tick of the state
+     * @return The state, or nullptr if it is not kept
+     */
+    const WireState* find(std::uint32_t tick) const
+    {
+        for (const WireState& state : states)
+        {
+            if (state.getTick() == tick)
+                return &state;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Gets the newest decoded state
+     * @return The state (empty before the first one)
+     */
+    const WireState& current() const
+    {
+        return states[(next_state + kept - 1) % kept];
+    }
+};
+
+/**
+ * @brief Handles every packet waiting for a client
+ * @param client Client to update
+ */
+static void receive(LoadClient& client)
+{
+    std::uint8_t packet[MatchServer::max_packet + 16];
+    std::size_t size = 0;
+    IpAddress sender;
+    unsigned short sender_port = 0;
+    while (client.socket.receive(packet, sizeof(packet), size, sender, sender_port) == Socket::Done)
+    {
+        if (size < 3 || packet[0] != 'F' || packet[1] != 'S')
+            continue;
+
+        if (packet[2] == server_welcome && size >= 14 && getLE(packet + 3, 4) == client.key)
+        {
+            client.welcomed = true;
+            client.slot = static_cast<std::uint16_t>(getLE(packet + 7, 2));
+            client.player = packet[9];
+            client.token = static_cast<std::uint32_t>(getLE(packet + 10, 4));
+        }
+        else if (packet[2] == server_state && size >= 14 && client.welcomed)
+        {
+            client.received++;
+            client.bytes += size;
+            client.confirmed = static_cast<std::uint16_t>(getLE(packet + 4, 2));
+
+            std::uint32_t base_tick = static_cast<std::uint32_t>(getLE(packet + 6, 4));
+            static const WireState empty_state;
+            const WireState* base = base_tick == 0 ? &empty_state : client.find(base_tick);
+            if (!base)
+            {
+                client.missing++;
+                continue;
+            }
+            WireState state;
+            if (WireState::decodeDelta(*base, packet + 14, size - 14, state) == 0 || state.checksum() != getLE(packet + 10, 4))
+            {
+                client.mismatches++;
+                continue;
+            }
+            if (state.getTick() <= client.newest)
+                continue;   // Reordered
+            client.states[client.next_state] = state;
+            client.next_state = (client.next_state + 1) % LoadClient::kept;
+            client.newest = state.getTick();
+        }
+    }
+}
+
+/**
+ * @brief Picks the keys a client presses on its newest state
+ * @param client Client to decide for
+ * @return server_key_* bits, 0 for none
+ *
+ * Flaps when the bird sinks below the middle of the next gap. Player 1
+ * starts and restarts the match.
+ */
+static std::uint8_t decide(const LoadClient& client)
+{
+    const WireState& state = client.current();
+    if (client.newest == 0)
+        return 0;
+    std::uint16_t run = state.words[WireState::RunFlags];
+    if (!(run & WireState::run_running))
+    {
+        if (client.player != 0)
+            return 0;
+        return (run & WireState::run_over) ? server_key_restart : server_key_start;
+    }
+    if (!(state.getBirdFlags(client.player) & WireState::bird_active) || state.getBirdVelocity(client.player) < 0.f)
+        return 0;
+
+    float target = ground_top / 2.f;
+    for (int pipe = 0; pipe < state.getPipeCount(); pipe++)
+    {
+        if (state.getPipeX(pipe) + pipe_width > Simulation::start_x)
+        {
+            target = state.getPipeGapBottom(pipe) - 60.f;
+            break;
+        }
+    }
+    return state.getBirdY(client.player) + bird_height > target ? server_key_flap : 0;
+}
+
+/**
+ * @brief Sends a client's join or input packet
+ * @param client Client sending
+ * @param address Server address
+ * @param port Server port
+ *
+ * The last key packet is resent until the server confirms it; a new
+ * press waits until then.
+ */
+static void send(LoadClient& client, const IpAddress& address, unsigned short port)
+{
+    std::uint8_t packet[17] = { 'F', 'S', server_join };
+    if (!client.welcomed)
+    {
+        putLE(packet + 3, client.key, 4);
+        client.socket.send(packet, 7, address, port);
+        return;
+    }
+
+    if (client.confirmed == client.seq)
+    {
+        std::uint8_t keys = decide(client);
+        if (keys)
+        {
+            client.seq++;
+            client.bits = keys;
+        }
+    }
+    packet[2] = server_input;
+    putLE(packet + 3, client.slot, 2);
+    packet[5] = static_cast<std::uint8_t>(client.player);
+    putLE(packet + 6, client.token, 4);
+    putLE(packet + 10, client.newest, 4);
+    putLE(packet + 14, client.seq, 2);
+    packet[16] = client.bits;
+    client.socket.send(packet, sizeof(packet), address, port);
+}
+
+/**
+ * @brief Main function - load test entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
+ * @return 0 if every state decoded correctly, 1 otherwise
+ */
+int main(int argc, char* argv[])
+{
+    std::string server = "127.0.0.1:7100";
+    int matches = 100;
+    float seconds = 20.f;
+    std::uint32_t first_key = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+        {
+            std::cerr << "Missing value for " << arg << std::endl;
+            return 1;
+        }
+        std::string value = argv[++i];
+
+        if (arg == "--server") server = value;
+        else if (arg == "--matches") matches = std::atoi(value.c_str());
+        else if (arg == "--seconds") seconds = static_cast<float>(std::atof(value.c_str()));
+        else if (arg == "--first-key") first_key = static_cast<std::uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::size_t colon = server.rfind(':');
+    int port = colon == std::string::npos ? 0 : std::atoi(server.c_str() + colon + 1);
+    IpAddress address(server.substr(0, colon));
+    if (port <= 0 || port > 65535 || address == IpAddress::None)
+    {
+        std::cerr << "--server takes <address>:<port>" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::unique_ptr<LoadClient>> clients;
+    for (int i = 0; i < 2 * matches; i++)
+    {
+        std::unique_ptr<LoadClient> client(new LoadClient());
+        client->key = first_key + static_cast<std::uint32_t>(i / 2);
+        if (client->socket.bind(Socket::AnyPort) != Socket::Done)
+        {
+            std::cerr << "Could not bind client socket " << i << std::endl;
+            return 1;
+        }
+        client->socket.setBlocking(false);
+        clients.push_back(std::move(client));
+    }
+
+    // Send at the server's default state rate; joins are retried every half second
+    typedef std::chrono::steady_clock steady_clock;
+    const auto interval = std::chrono::microseconds(1000000 / 60);
+    const long rounds = static_cast<long>(seconds * 60);
+    auto next = steady_clock::now();
+    for (long round = 0; round < rounds; round++)
+    {
+        for (std::unique_ptr<LoadClient>& client : clients)
+        {
+            receive(*client);
+            if (client->welcomed || round % 30 == 0)
+                send(*client, address, static_cast<unsigned short>(port));
+        }
+        next += interval;
+        std::this_thread::sleep_until(next);
+    }
+    for (std::unique_ptr<LoadClient>& client : clients)
+        receive(*client);
+
+    int welcomed = 0;
+    int best_score = 0;
+    std::uint64_t received = 0, bytes = 0, mismatches = 0, missing = 0, presses = 0;
+    for (const std::unique_ptr<LoadClient>& client : clients)
+    {
+        welcomed += client->welcomed;
+        received += client->received;
+        bytes += client->bytes;
+        mismatches += client->mismatches;
+        missing += client->missing;
+        presses += client->confirmed;
+        best_score = std::max(best_score, client->current().getScore(client->player));
+    }
+
+    std::cout << welcomed << "/" << clients.size() << " clients seated, "
+              << received << " states (" << std::fixed << std::setprecision(1)
+              << (received ? static_cast<double>(bytes) / received : 0.0) << " B each, "
+              << received / std::max(1.f, seconds) / std::max<std::size_t>(1, clients.size()) << "/s per client), "
+              << presses << " key presses confirmed, best score " << best_score << "\n"
+              << mismatches << " checksum mismatches, " << missing << " missing bases\n";
+    if (welcomed < static_cast<int>(clients.size()) || received == 0 || mismatches != 0 || missing != 0)
+    {
+        std::cout << "FAILED\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,431 @@
+/**
+ * @file Simulation.cpp
+ * @brief Implementation of the headless Simulation class for Flappy Bird 2-player game
+ *
+ * This file contains the game rules - bird physics, pipe spawning,
+ * collision detection and scoring - operating on plain data only.
+ */
+
+#include "Simulation.h"
+#include "Globals.h"
+#include "Profiler.h"
+#include <cmath>
+
+/**
+ * @brief Constructor - initializes physics constants and a fresh match
+ * @param seed Seed identifying the pipe course
+ * @param config Gameplay parameters (defaults match the shipped game)
+ */
+Simulation::Simulation(std::uint64_t seed, const SimConfig& config) :
+gravity(config.gravity),
+birdflapspeed(config.birdflapspeed),
+pipe_distance(config.pipe_distance),
+pipe_move_speed(config.pipe_move_speed),
+ground_move_speed(config.ground_move_speed),
+colliders(2 * PipePool::capacity()),
+masks(nullptr)
+{
+    birds.resize(2);
+    colliders.reserveBirds(2);   // Nothing allocates once constructed
+    reset(seed);
+}
+
+/**
+ * @brief Starts a fresh match with a new pipe course
+ * @param seed Seed identifying the pipe course
+ */
+void Simulation::reset(std::uint64_t seed)
+{
+    pipe_stream.setSeed(seed);
+    tick = 0;
+    ground_offset = 0.f;
+    prev_ground_offset = 0.f;
+
+    // Hashed and saved, and restart() keeps them, so clear them here for
+    // a reused Simulation to match a fresh one
+    for (int player = 0; player < 2; player++)
+    {
+        flap_counts[player] = 0;
+        birds.animation[player] = 0;
+        birds.animation_switch[player] = 0;
+        birds.frame[player] = 0;
+    }
+    restart();
+}
+
+/**
+ * @brief Resets match state for a new round
+ *
+ * Resets bird positions, collision flags, scores, and pipe state.
+ * The pipe course starts again from its first pipe, so a rematch
+ * is flown on exactly the same course.
+ */
+void Simulation::restart()
+{
+    birds.place(0, start_x, player1_start_y);
+    birds.place(1, start_x, player2_start_y);
+
+    enter_pressed = false;
+    start_monitoring = false;
+    pipe_spawn_time = pipe_spawn_interval;
+    pipe_counter = pipe_spawn_time + 1;
+    pipes.clear();
+    pipe_index = 0;
+    scores[0] = 0;
+    scores[1] = 0;
+}
+
+/**
+ * @brief Advances the match by one fixed tick
+ * @param input Player inputs collected since the previous tick
+ *
+ * Applies inputs with the same rules the event loop used to apply
+ * them, then runs one tick of gameplay if the match is running.
+ */
+void Simulation::step(const SimInput& input)
+{
+    // Remember positions so the renderer can interpolate between ticks
+    birds.savePositions();
+    for (PipeState& pipe : pipes)
+        pipe.prev_x = pipe.x;
+    prev_ground_offset = ground_offset;
+
+    if (birds.active[0] || birds.active[1])
+    {
+        if (input.start && !enter_pressed)
+        {
+            enter_pressed = true;
+            birds.setFlying(true);
+        }
+        if (enter_pressed)
+        {
+            std::uint8_t flaps[2] = { input.flap[0], input.flap[1] };
+            birds.flap(flaps, static_cast<float>(birdflapspeed));
+            for (int player = 0; player < 2; player++)
+                flap_counts[player] += flaps[player] & birds.active[player];
+        }
+    }
+
+    // Restart is only possible once someone has collided
+    if (input.restart && (!birds.active[0] || !birds.active[1]))
+    {
+        restart();
+    }
+
+    if (enter_pressed)
+    {
+        doProcessing();
+    }
+
+    tick++;
+}
+
+/**
+ * @brief Processes one tick of active gameplay
+ *
+ * Handles ground movement, pipe spawning, collision detection,
+ * score tracking and bird physics.
+ */
+void Simulation::doProcessing()
+{
+    moveGround();
+
+    // Spawn new pipes at regular intervals
+    if (pipe_counter > pipe_spawn_time)
+    {
+        // With extremely slow pipes the pool can fill up; drop the oldest
+        if (pipes.full())
+            pipes.pop_front();
+        pipes.emplace_back(static_cast<float>(window_width),
+                           static_cast<float>(window_width),
+                           static_cast<float>(pipe_stream.getHeight(pipe_index++)),
+                           static_cast<float>(pipe_distance));
+        pipe_counter = 0;
+    }
+    pipe_counter++;
+
+    // Update existing pipes
+    for (PipeState& pipe : pipes)
+        pipe.x -= pipe_move_speed * tick_dt;
+
+    // Pipes all move at the same speed, so off-screen ones are always at the front
+    while (!pipes.empty() && pipes.front().x + pipe_width < 0)
+        pipes.pop_front();
+
+    checkCollisions();
+    checkScore();
+
+    // Birds stop once they sink below the ground line
+    birds.integrate(static_cast<float>(gravity), tick_dt, floor_y);
+}
+
+/**
+ * @brief Scrolls the ground tiles by one tick
+ */
+void Simulation::moveGround()
+{
+    ground_offset = std::fmod(ground_offset + ground_move_speed * tick_dt, ground_width);
+}
+
+/**
+ * @brief Copies the drawable match state
+ * @param snapshot Snapshot to overwrite (reusing it does not allocate)
+ */
+void Simulation::getSnapshot(SimSnapshot& snapshot) const
+{
+    snapshot.tick = tick;
+    for (int player = 0; player < 2; player++)
+    {
+        snapshot.birds[player] = birds.get(player);
+        snapshot.scores[player] = scores[player];
+        snapshot.flaps[player] = flap_counts[player];
+    }
+    snapshot.pipes = pipes;
+    snapshot.ground_offset = ground_offset;
+    snapshot.prev_ground_offset = prev_ground_offset;
+    snapshot.running = enter_pressed;
+    snapshot.over = isOver();
+}
+
+/**
+ * @brief Hashes every piece of state carried to the next tick
+ * @param hash Receives one hash per StateField
+ *
+ * Covers everything step() reads back, floats bit for bit, so two
+ * Simulations with equal hashes continue identically. Gameplay
+ * parameters and collision masks are settings rather than state and
+ * are left out. Costs a few dozen multiplies per tick.
+ */
+void Simulation::hashState(StateHash& hash) const
+{
+    std::uint64_t* fields = hash.fields;
+    for (int i = 0; i < StateHash::field_count; i++)
+        fields[i] = static_cast<std::uint64_t>(i + 1);  // Distinct starting points, so equal fields don't hash alike
+
+    std::uint64_t& tick_hash = fields[static_cast<int>(StateField::Tick)];
+    tick_hash = StateHash::mix(tick_hash, tick);
+
+    for (int player = 0; player < 2; player++)
+    {
+        std::uint64_t& position = fields[static_cast<int>(player ? StateField::Bird2Position : StateField::Bird1Position)];
+        position = StateHash::mix(position, birds.x[player]);
+        position = StateHash::mix(position, birds.y[player]);
+        position = StateHash::mix(position, birds.prev_y[player]);
+        position = StateHash::mix(position, birds.checked_y[player]);
+
+        std::uint64_t& velocity = fields[static_cast<int>(player ? StateField::Bird2Velocity : StateField::Bird1Velocity)];
+        velocity = StateHash::mix(velocity, birds.velocity[player]);
+
+        std::uint64_t& status = fields[static_cast<int>(player ? StateField::Bird2Status : StateField::Bird1Status)];
+        status = StateHash::mix(status, static_cast<std::uint64_t>(birds.animation[player]));
+        status = StateHash::mix(status, static_cast<std::uint64_t>(birds.animation_switch[player]));
+        status = StateHash::mix(status, static_cast<std::uint64_t>(birds.frame[player]));
+        status = StateHash::mix(status, static_cast<std::uint64_t>(birds.flying[player]));
+        status = StateHash::mix(status, static_cast<std::uint64_t>(birds.active[player]));
+        status = StateHash::mix(status, static_cast<std::uint64_t>(birds.collided[player]));
+        status = StateHash::mix(status, static_cast<std::uint64_t>(flap_counts[player]));
+    }
+
+    std::uint64_t& pipe_hash = fields[static_cast<int>(StateField::Pipes)];
+    pipe_hash = StateHash::mix(pipe_hash, static_cast<std::uint64_t>(pipes.size()));
+    for (const PipeState& pipe : pipes)
+    {
+        pipe_hash = StateHash::mix(pipe_hash, pipe.x);
+        pipe_hash = StateHash::mix(pipe_hash, pipe.prev_x);
+        pipe_hash = StateHash::mix(pipe_hash, pipe.y_pos);
+        pipe_hash = StateHash::mix(pipe_hash, pipe.gap);
+    }
+
+    std::uint64_t& timer = fields[static_cast<int>(StateField::PipeTimer)];
+    timer = StateHash::mix(timer, static_cast<std::uint64_t>(pipe_counter));
+    timer = StateHash::mix(timer, static_cast<std::uint64_t>(pipe_spawn_time));
+    timer = StateHash::mix(timer, pipe_stream.getSeed());
+    timer = StateHash::mix(timer, pipe_index);
+
+    std::uint64_t& score_hash = fields[static_cast<int>(StateField::Scores)];
+    score_hash = StateHash::mix(score_hash, static_cast<std::uint64_t>(scores[0]));
+    score_hash = StateHash::mix(score_hash, static_cast<std::uint64_t>(scores[1]));
+
+    std::uint64_t& flags = fields[static_cast<int>(StateField::RunFlags)];
+    flags = StateHash::mix(flags, static_cast<std::uint64_t>(enter_pressed));
+    flags = StateHash::mix(flags, static_cast<std::uint64_t>(start_monitoring));
+
+    std::uint64_t& ground = fields[static_cast<int>(StateField::Ground)];
+    ground = StateHash::mix(ground, ground_offset);
+    ground = StateHash::mix(ground, prev_ground_offset);
+}
+
+/**
+ * @brief Copies every piece of state carried to the next tick
+ * @param state State to overwrite (reusing it does not allocate)
+ *
+ * Covers the same state as hashState(), so a Simulation restored with
+ * loadState() steps and hashes exactly like the one that was saved.
+ */
+void Simulation::saveState(SimState& state) const
+{
+    state.tick = tick;
+    state.seed = pipe_stream.getSeed();
+    state.pipe_index = pipe_index;
+    for (int player = 0; player < 2; player++)
+    {
+        state.bird_x[player] = birds.x[player];
+        state.bird_y[player] = birds.y[player];
+        state.bird_prev_y[player] = birds.prev_y[player];
+        state.bird_checked_y[player] = birds.checked_y[player];
+        state.bird_velocity[player] = birds.velocity[player];
+        state.animation[player] = birds.animation[player];
+        state.animation_switch[player] = birds.animation_switch[player];
+        state.frame[player] = birds.frame[player];
+        state.flying[player] = birds.flying[player];
+        state.active[player] = birds.active[player];
+        state.collided[player] = birds.collided[player];
+        state.scores[player] = scores[player];
+        state.flap_counts[player] = flap_counts[player];
+    }
+    state.pipes = pipes;
+    state.pipe_counter = pipe_counter;
+    state.pipe_spawn_time = pipe_spawn_time;
+    state.ground_offset = ground_offset;
+    state.prev_ground_offset = prev_ground_offset;
+    state.enter_pressed = enter_pressed;
+    state.start_monitoring = start_monitoring;
+}
+
+/**
+ * @brief Puts the match back in a saved state
+ * @param state State taken by saveState() on a Simulation with the same settings
+ */
+void Simulation::loadState(const SimState& state)
+{
+    tick = state.tick;
+    pipe_stream.setSeed(state.seed);
+    pipe_index = state.pipe_index;
+    for (int player = 0; player < 2; player++)
+    {
+        birds.x[player] = state.bird_x[player];
+        birds.y[player] = state.bird_y[player];
+        birds.prev_y[player] = state.bird_prev_y[player];
+        birds.checked_y[player] = state.bird_checked_y[player];
+        birds.velocity[player] = state.bird_velocity[player];
+        birds.animation[player] = state.animation[player];
+        birds.animation_switch[player] = state.animation_switch[player];
+        birds.frame[player] = state.frame[player];
+        birds.flying[player] = state.flying[player];
+        birds.active[player] = state.active[player];
+        birds.collided[player] = state.collided[player];
+        scores[player] = state.scores[player];
+        flap_counts[player] = state.flap_counts[player];
+    }
+    pipes = state.pipes;
+    pipe_counter = state.pipe_counter;
+    pipe_spawn_time = state.pipe_spawn_time;
+    ground_offset = state.ground_offset;
+    prev_ground_offset = state.prev_ground_offset;
+    enter_pressed = state.enter_pressed;
+    start_monitoring = state.start_monitoring;
+}
+
+/**
+ * @brief Gets the gameplay parameters of the match
+ * @return Parameters the Simulation was created with
+ */
+SimConfig Simulation::getConfig() const
+{
+    return SimConfig{ gravity, birdflapspeed, pipe_distance, pipe_move_speed, ground_move_speed };
+}
+
+/**
+ * @brief Gets the ground scroll interpolated between the last two ticks
+ * @param alpha Fraction of a tick elapsed since the last step, in [0, 1]
+ * @return Offset in pixels, in the range [0, ground_width)
+ */
+float SimSnapshot::getGroundOffset(float alpha) const
+{
+    // The offset wraps around, so unwrap it before blending
+    float current = ground_offset;
+    if (current < prev_ground_offset)
+        current += ground_width;
+    return std::fmod(prev_ground_offset + (current - prev_ground_offset) * alpha, ground_width);
+}
+
+/**
+ * @brief Checks collision detection for every bird
+ *
+ * Detects collisions with every pipe segment and the ground, pixel by
+ * pixel when sprite masks are set. Pipe tests are swept over the motion
+ * of birds and pipes since the previous check, so no speed is fast
+ * enough to pass through a pipe between two ticks. The ground is a
+ * half-plane the birds cannot skip past. Stops the match and takes each
+ * colliding player out.
+ */
+void Simulation::checkCollisions()
+{
+    ProfileScope scope(ProfilePhase::Collision);
+    if (pipes.size() > 0)
+    {
+        colliders.clear();
+        for (const PipeState& pipe : pipes)
+        {
+            float dx = pipe.x - pipe.prev_x;
+            colliders.add({ pipe.x, pipe.y_pos - pipe.gap - pipe_height, pipe_width, pipe_height },
+                          masks ? &masks->pipe_upper : nullptr, dx);
+            colliders.add({ pipe.x, pipe.y_pos, pipe_width, pipe_height },
+                          masks ? &masks->pipe_lower : nullptr, dx);
+        }
+        colliders.build();
+
+        std::int32_t hits[2] = { 0, 0 };
+        colliders.collide(birds, hits, masks);
+        birds.hitGround(ground_line, hits);
+        birds.checked_y = birds.y;
+
+        for (int player = 0; player < 2; player++)
+        {
+            if (hits[player])
+            {
+                enter_pressed = false;
+                birds.active[player] = 0;
+                birds.collided[player] = 1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tracks and updates player scores when passing through pipes
+ *
+ * Uses a monitoring system to detect when birds pass through pipe gaps
+ * and increments the appropriate player's score.
+ */
+void Simulation::checkScore()
+{
+    ProfileScope scope(ProfilePhase::Score);
+    if (pipes.size() > 0)
+    {
+        const PipeState& pipe = pipes[0];
+        float pipe_right = pipe.x + pipe_width;
+
+        if (!start_monitoring)
+        {
+            // Start monitoring when birds enter the pipe gap
+            for (int player = 0; player < 2; player++)
+            {
+                if (birds.x[player] > pipe.x && birds.x[player] + bird_width < pipe_right)
+                    start_monitoring = true;
+            }
+        }
+        else
+        {
+            // Award points when birds exit the pipe gap
+            for (int player = 0; player < 2; player++)
+            {
+                if (birds.x[player] > pipe_right)
+                {
+                    scores[player]++;
+                    start_monitoring = false;
+                }
+            }
+        }
+    }
+}
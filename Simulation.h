@@ -0,0 +1,355 @@
+/**
+ * @file Simulation.h
+ * @brief Header file for the headless Simulation class in Flappy Bird 2-player game
+ *
+ * This file defines the Simulation class which owns every game rule
+ * (bird physics, pipe spawning, collisions and scoring) as plain data.
+ * It has no dependency on SFML graphics, so matches can be stepped
+ * without a window, faster than real time or in bulk.
+ *
+ * The simulation advances in fixed ticks of tick_dt seconds, so a match
+ * plays out identically regardless of the renderer's frame rate.
+ */
+
+#pragma once
+#include <cstdint>
+#include "BirdPool.h"
+#include "CollisionMasks.h"
+#include "CollisionWorld.h"
+#include "PipeStream.h"
+#include "RingBuffer.h"
+#include "StateHash.h"
+
+/**
+ * @struct BirdState
+ * @brief Plain-data state of one player's bird
+ */
+struct BirdState
+{
+    float x;                 ///< Left edge of the bird's collision box
+    float y;                 ///< Top edge of the bird's collision box
+    float prev_y;            ///< Value of y before the last tick (for render interpolation)
+    float velocity;          ///< Current vertical velocity of the bird (pixels per second)
+    int animation;           ///< Animation frame counter for wing flapping
+    int animation_switch;    ///< Wing position to show on the next animation step
+    int frame;               ///< Wing position currently shown (0 = down, 1 = up)
+    bool flying;             ///< Flag indicating whether bird physics are active
+    bool active;             ///< Flag indicating the player is still in the match
+    bool collided;           ///< Flag indicating the bird has hit a pipe or the ground
+};
+
+/**
+ * @struct PipeState
+ * @brief Plain-data state of one pipe pair
+ */
+struct PipeState
+{
+    float x;                 ///< Left edge of both pipe segments
+    float prev_x;            ///< Value of x before the last tick (for render interpolation)
+    float y_pos;             ///< Top edge of the lower pipe segment (bottom of the gap)
+    float gap;               ///< Vertical gap between upper and lower pipe segments
+};
+
+/// Pool of active pipes, oldest first (enough for the slowest sensible pipe speed)
+typedef RingBuffer<PipeState, 16> PipePool;
+
+/**
+ * @struct SimConfig
+ * @brief Tunable gameplay parameters of a match
+ */
+struct SimConfig
+{
+    int gravity = 840;               ///< Gravitational acceleration (pixels per second squared)
+    int birdflapspeed = 300;         ///< Upward velocity applied when a bird flaps (pixels per second)
+    int pipe_distance = 170;         ///< Vertical gap between upper and lower pipe segments
+    int pipe_move_speed = 400;       ///< Horizontal movement speed of pipes (pixels per second)
+    int ground_move_speed = 270;     ///< Horizontal movement speed of the ground (pixels per second)
+};
+
+/**
+ * @struct SimInput
+ * @brief Player inputs gathered for a single simulation step
+ */
+struct SimInput
+{
+    bool start = false;              ///< Enter pressed - start or resume the match
+    bool flap[2] = { false, false }; ///< Space (Player 1) and Up (Player 2) pressed
+    bool restart = false;            ///< R pressed - restart after a collision
+};
+
+/**
+ * @struct SimSnapshot
+ * @brief Copy of everything needed to draw a match, taken after a tick
+ *
+ * Holds no pointers into the Simulation, so it can be handed to another
+ * thread while the simulation keeps stepping.
+ */
+struct SimSnapshot
+{
+    std::uint64_t tick = 0;          ///< Ticks stepped when the snapshot was taken
+    BirdState birds[2] = {};         ///< Player 1 and Player 2 birds
+    PipePool pipes;                  ///< Active pipes, oldest first
+    int scores[2] = { 0, 0 };        ///< Player scores
+    std::uint32_t flaps[2] = { 0, 0 };  ///< Flaps applied per player so far (for sound cues)
+    float ground_offset = 0.f;       ///< Horizontal scroll of the ground tiles
+    float prev_ground_offset = 0.f;  ///< Value of ground_offset before the last tick
+    bool running = false;            ///< True while the match is running
+    bool over = false;               ///< True when both birds have collided
+
+    /**
+     * @brief Gets the ground scroll interpolated between the last two ticks
+     * @param alpha Fraction of a tick elapsed since the last step, in [0, 1]
+     * @return Offset in pixels, in the range [0, ground_width)
+     */
+    float getGroundOffset(float alpha) const;
+};
+
+/**
+ * @struct SimState
+ * @brief Everything a Simulation carries from one tick to the next, as one flat value
+ *
+ * About 400 bytes with no pointers, so saving and restoring a match is
+ * a plain copy. Rollback netcode keeps one per recent tick. Gameplay
+ * parameters and collision masks are settings, not state, and are not
+ * included; a state only makes sense in a Simulation with the same ones.
+ */
+struct SimState
+{
+    std::uint64_t tick = 0;                  ///< Ticks stepped since reset
+    std::uint64_t seed = 0;                  ///< Pipe course seed
+    std::uint64_t pipe_index = 0;            ///< Course index of the next pipe to spawn
+    float bird_x[2] = {};                    ///< Left edges of the collision boxes
+    float bird_y[2] = {};                    ///< Top edges of the collision boxes
+    float bird_prev_y[2] = {};               ///< Values of y before the last tick
+    float bird_checked_y[2] = {};            ///< Values of y at the last collision check
+    float bird_velocity[2] = {};             ///< Vertical velocities (pixels per second)
+    std::int32_t animation[2] = {};          ///< Animation frame counters
+    std::int32_t animation_switch[2] = {};   ///< Wing positions to show on the next animation step
+    std::int32_t frame[2] = {};              ///< Wing positions currently shown
+    std::int32_t flying[2] = {};             ///< 1 if bird physics are active
+    std::int32_t active[2] = {};             ///< 1 if the bird is still in the match
+    std::int32_t collided[2] = {};           ///< 1 if the bird has hit a pipe or the ground
+    PipePool pipes;                          ///< Active pipes, oldest first
+    std::int32_t pipe_counter = 0;           ///< Ticks since the last pipe spawned
+    std::int32_t pipe_spawn_time = 0;        ///< Ticks between pipe spawns
+    std::int32_t scores[2] = {};             ///< Player scores
+    std::uint32_t flap_counts[2] = {};       ///< Flaps applied per player
+    float ground_offset = 0.f;               ///< Horizontal scroll of the ground tiles
+    float prev_ground_offset = 0.f;          ///< Value of ground_offset before the last tick
+    bool enter_pressed = false;              ///< Match running flag
+    bool start_monitoring = false;           ///< Score monitoring flag
+};
+
+/**
+ * @class Simulation
+ * @brief Headless game engine holding bird and pipe state as plain data
+ *
+ * The Simulation class implements the complete match rules that used to
+ * live in Game and Bird. The windowed Game only feeds it inputs and draws
+ * the resulting state, so the same engine can run with no display at all.
+ */
+class Simulation
+{
+private:
+    // Physics constants
+    const int gravity;                          ///< Gravitational acceleration (pixels per second squared)
+    const int birdflapspeed;                    ///< Upward velocity applied when a bird flaps (pixels per second)
+    const int pipe_distance;                    ///< Vertical gap between upper and lower pipe segments
+    const int pipe_move_speed;                  ///< Horizontal movement speed of pipes (pixels per second)
+    const int ground_move_speed;                ///< Horizontal movement speed of the ground (pixels per second)
+
+    // Match state
+    std::uint64_t tick;                         ///< Number of ticks stepped since reset()
+    BirdPool birds;                             ///< Player 1 and Player 2 birds
+    PipePool pipes;                             ///< Active pipe obstacles, oldest first
+    CollisionWorld colliders;                   ///< Boxes of every pipe segment for this tick
+    const CollisionMasks* masks;                ///< Sprite masks for pixel-exact collisions, or nullptr for boxes
+    bool enter_pressed;                         ///< Flag indicating if the match is running
+    bool start_monitoring;                      ///< Flag for score monitoring through pipes
+    int pipe_counter, pipe_spawn_time;          ///< Timing variables for pipe spawning (in ticks)
+    int scores[2];                              ///< Player scores
+    std::uint32_t flap_counts[2];               ///< Flaps applied per player since the last reset()
+    float ground_offset;                        ///< Horizontal scroll of the ground tiles
+    float prev_ground_offset;                   ///< Value of ground_offset before the last tick
+
+    // Pipe height generation
+    PipeStream pipe_stream;                     ///< Seeded course of pipe heights
+    std::uint64_t pipe_index;                   ///< Index of the next pipe to spawn
+
+    /**
+     * @brief Resets match state for a rematch on the same pipe course
+     */
+    void restart();
+
+    /**
+     * @brief Processes one tick of active gameplay
+     */
+    void doProcessing();
+
+    /**
+     * @brief Scrolls the ground tiles by one tick
+     */
+    void moveGround();
+
+    /**
+     * @brief Checks collision detection for every bird
+     */
+    void checkCollisions();
+
+    /**
+     * @brief Updates player scores when passing through pipes
+     */
+    void checkScore();
+
+public:
+    static constexpr int tick_rate = 120;                 ///< Simulation ticks per second
+    static constexpr float tick_dt = 1.f / tick_rate;     ///< Duration of one tick in seconds
+    static constexpr int pipe_spawn_interval = 140;       ///< Ticks between pipe spawns (about 1.17 seconds)
+    static constexpr float ground_line = 540.f;           ///< Bird top edge at or below which it hits the ground
+    static constexpr float floor_y = 548.f;               ///< Bird top edge at or below which it stops moving
+    static constexpr float start_x = 100.f;               ///< Left edge of both birds
+    static constexpr float player1_start_y = 50.f;        ///< Top edge of Player 1 at the start of a match
+    static constexpr float player2_start_y = 150.f;       ///< Top edge of Player 2 at the start of a match
+
+    /**
+     * @brief Constructor - initializes physics constants and a fresh match
+     * @param seed Seed identifying the pipe course
+     * @param config Gameplay parameters (defaults match the shipped game)
+     */
+    explicit Simulation(std::uint64_t seed = 0, const SimConfig& config = SimConfig());
+
+    /**
+     * @brief Starts a fresh match with a new pipe course
+     * @param seed Seed identifying the pipe course
+     */
+    void reset(std::uint64_t seed);
+
+    /**
+     * @brief Switches between pixel-exact and bounding-box collisions
+     * @param sprite_masks Masks to collide with (kept, not copied), or nullptr for boxes
+     */
+    void setMasks(const CollisionMasks* sprite_masks) { masks = sprite_masks; }
+
+    /**
+     * @brief Checks whether collisions are pixel-exact
+     * @return True if sprite masks are set
+     */
+    bool hasMasks() const { return masks != nullptr; }
+
+    /**
+     * @brief Advances the match by one fixed tick
+     * @param input Player inputs collected since the previous tick
+     */
+    void step(const SimInput& input);
+
+    /**
+     * @brief Gets the number of ticks stepped since the last reset()
+     * @return Index of the next tick to be stepped
+     */
+    std::uint64_t getTick() const { return tick; }
+
+    /**
+     * @brief Gets a player's bird state
+     * @param player Player index (0 or 1)
+     * @return Snapshot of the bird
+     */
+    BirdState getBird(int player) const { return birds.get(player); }
+
+    /**
+     * @brief Gets every bird's state as parallel arrays
+     * @return Read-only bird pool
+     */
+    const BirdPool& getBirds() const { return birds; }
+
+    /**
+     * @brief Gets all active pipes, oldest first
+     * @return Read-only pipe list
+     */
+    const PipePool& getPipes() const { return pipes; }
+
+    /**
+     * @brief Gets a player's score
+     * @param player Player index (0 or 1)
+     * @return Number of pipes passed
+     */
+    int getScore(int player) const { return scores[player]; }
+
+    /**
+     * @brief Gets how many flaps a player's bird has made
+     * @param player Player index (0 or 1)
+     * @return Flaps applied since the last reset()
+     */
+    std::uint32_t getFlapCount(int player) const { return flap_counts[player]; }
+
+    /**
+     * @brief Checks whether the match is currently running
+     * @return True once Enter has been pressed and until a collision
+     */
+    bool isRunning() const { return enter_pressed; }
+
+    /**
+     * @brief Checks whether both players are out of the match
+     * @return True when both birds have collided
+     */
+    bool isOver() const { return !birds.active[0] && !birds.active[1]; }
+
+    /**
+     * @brief Gets the horizontal scroll of the ground tiles
+     * @return Offset in pixels, in the range [0, ground_width)
+     */
+    float getGroundOffset() const { return ground_offset; }
+
+    /**
+     * @brief Copies the drawable match state
+     * @param snapshot Snapshot to overwrite (reusing it does not allocate)
+     */
+    void getSnapshot(SimSnapshot& snapshot) const;
+
+    /**
+     * @brief Hashes every piece of state carried to the next tick
+     * @param hash Receives one hash per StateField
+     */
+    void hashState(StateHash& hash) const;
+
+    /**
+     * @brief Copies every piece of state carried to the next tick
+     * @param state State to overwrite (reusing it does not allocate)
+     */
+    void saveState(SimState& state) const;
+
+    /**
+     * @brief Puts the match back in a saved state
+     * @param state State taken by saveState() on a Simulation with the same settings
+     */
+    void loadState(const SimState& state);
+
+    /**
+     * @brief Gets the gameplay parameters of the match
+     * @return Parameters the Simulation was created with
+     */
+    SimConfig getConfig() const;
+
+    /**
+     * @brief Gets how many ticks have passed since the last pipe spawned
+     * @return Spawn counter (a pipe spawns on the tick it exceeds getPipeSpawnTime())
+     */
+    int getPipeCounter() const { return pipe_counter; }
+
+    /**
+     * @brief Gets the number of ticks between pipe spawns
+     * @return Spawn interval in ticks
+     */
+    int getPipeSpawnTime() const { return pipe_spawn_time; }
+
+    /**
+     * @brief Gets the course index of the next pipe to spawn
+     * @return Index to pass to PipeStream::getHeight()
+     */
+    std::uint64_t getNextPipeIndex() const { return pipe_index; }
+
+    /**
+     * @brief Gets the pipe course in use
+     * @return Pipe height generator for the current seed
+     */
+    const PipeStream& getPipeStream() const { return pipe_stream; }
+};
@@ -1,28 +1,329 @@
 /**
- * @file Source.cpp 
+ * @file Source.cpp
  * @brief Entry point for the Flappy Bird 2-player game
- * 
+ *
  * Creates the main game window and starts the game loop.
  * This file serves as the main entry point for the application.
+ *
+ * Command line options:
+ *   --record <file>   Record each match to <file> (default: last_match.fbr)
+ *   --hashes          Also record a digest of the simulation state every tick
+ *   --replay <file>   Play back a recorded match instead of playing
+ *   --fast            Replay as fast as possible instead of real time
+ *   --headless        Replay without opening a window
+ *   --verify          Replay without a window, checking every recorded state digest
+ *                     (exits with 2 and names the tick and field on the first mismatch)
+ *   --profile <file>  Write per-frame phase timings to <file> on exit (default: frame_profile.csv)
+ *   --bot <1|2>       Let the computer fly Player 1's or Player 2's bird
+ *   --host <port>     Host an online match on a UDP port and fly Player 1's bird
+ *   --join <ip:port>  Join an online match and fly Player 2's bird
+ *   --input-delay <n> Online: ticks between a key press and its tick (default 2)
  */
 
 #include <SFML/Graphics.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
 #include "Globals.h"
 #include "Game.h"
+#include "NetPeer.h"
+#include "Replay.h"
+#include "Simulation.h"
 
 using namespace sf;
 
+/**
+ * @brief Applies the collision rules a replay was recorded with
+ * @param replay Opened replay
+ * @param sim Simulation to play it on
+ * @param masks Masks to load if the replay used pixel-exact collisions
+ */
+static void useReplayMasks(const ReplayReader& replay, Simulation& sim, CollisionMasks& masks)
+{
+    if (replay.getFlags() & replay_pixel_collision)
+    {
+        if (masks.load())
+            sim.setMasks(&masks);
+        else
+            std::cerr << "Replay needs collision masks that could not be loaded; it may play out differently" << std::endl;
+    }
+}
+
+/**
+ * @brief Replays a recorded match without a window and prints the result
+ * @param path Replay file to read
+ * @param fast True to replay as fast as possible, false for real time
+ * @return 0 on success, 1 if the replay could not be loaded
+ */
+static int playReplayHeadless(const std::string& path, bool fast)
+{
+    ReplayReader replay;
+    if (!replay.open(path))
+    {
+        std::cerr << "Could not read replay file " << path << std::endl;
+        return 1;
+    }
+
+    Simulation sim(replay.getSeed());
+    CollisionMasks masks;
+    useReplayMasks(replay, sim, masks);
+
+    auto next_tick = std::chrono::steady_clock::now();
+    while (!replay.isFinished(sim.getTick()))
+    {
+        sim.step(replay.read(sim.getTick()));
+        if (!fast)
+        {
+            next_tick += std::chrono::microseconds(1000000 / Simulation::tick_rate);
+            std::this_thread::sleep_until(next_tick);
+        }
+    }
+
+    std::cout << "Ticks: " << sim.getTick() << "\n"
+              << "Player 1: " << sim.getScore(0) << (sim.getBird(0).active ? "" : " (out)") << "\n"
+              << "Player 2: " << sim.getScore(1) << (sim.getBird(1).active ? "" : " (out)") << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Replays a match recorded with --hashes and checks it tick by tick
+ * @param path Replay file to read
+ * @return 0 if every digest matched, 1 if the replay could not be used, 2 on a desync
+ *
+ * Meant for proving a change to the simulation bit-exact: record with
+ * the old build, verify with the new one.
+ */
+static int verifyReplay(const std::string& path)
+{
+    ReplayReader replay;
+    if (!replay.open(path))
+    {
+        std::cerr << "Could not read replay file " << path << std::endl;
+        return 1;
+    }
+    if (!(replay.getFlags() & replay_state_hashes))
+    {
+        std::cerr << path << " has no state digests; record it with --hashes" << std::endl;
+        return 1;
+    }
+
+    Simulation sim(replay.getSeed());
+    CollisionMasks masks;
+    useReplayMasks(replay, sim, masks);
+
+    std::uint64_t checked = 0;
+    StateHash hash;
+    StateDigest recorded;
+    while (!replay.isFinished(sim.getTick()))
+    {
+        std::uint64_t tick = sim.getTick();
+        sim.step(replay.read(tick));
+        if (!replay.readHash(tick, recorded))
+            continue;
+
+        sim.hashState(hash);
+        int field = hash.getDigest().findDifference(recorded);
+        if (field >= 0)
+        {
+            std::cout << "Desync at tick " << tick << ": "
+                      << (field < StateHash::field_count ? StateHash::getName(static_cast<StateField>(field)) : "state (field unknown)")
+                      << " differs from the recording" << std::endl;
+            return 2;
+        }
+        checked++;
+    }
+
+    std::cout << "Verified " << checked << " of " << sim.getTick() << " ticks bit-exact" << std::endl;
+    return 0;
+}
+
+/**
+ * @brief Hosts or joins an online match and waits for the other player
+ * @param host_port Port to host on, or 0 to join
+ * @param join_address Host to join as "address:port" (when not hosting)
+ * @param input_delay Ticks between a key press and its tick
+ * @return Connected peer, or nullptr on failure
+ *
+ * A host waits as long as it takes; a guest gives up after ten seconds
+ * without an answer.
+ */
+static std::unique_ptr<NetPeer> connectOnline(unsigned short host_port, const std::string& join_address, int input_delay)
+{
+    std::unique_ptr<NetPeer> peer = std::make_unique<NetPeer>(input_delay);
+    CollisionMasks masks;
+    bool pixel = masks.load();
+
+    if (host_port != 0)
+    {
+        std::random_device rd;
+        std::uint64_t seed = (static_cast<std::uint64_t>(rd()) << 32) | rd();
+        if (!peer->host(host_port, seed, pixel))
+        {
+            std::cerr << "Could not listen on UDP port " << host_port << std::endl;
+            return nullptr;
+        }
+        std::cout << "Waiting for Player 2 on port " << host_port << "..." << std::endl;
+    }
+    else
+    {
+        std::size_t colon = join_address.rfind(':');
+        int port = colon == std::string::npos ? 0 : std::atoi(join_address.c_str() + colon + 1);
+        IpAddress address(join_address.substr(0, colon));
+        if (port <= 0 || port > 65535 || address == IpAddress::None)
+        {
+            std::cerr << "--join takes <address>:<port>" << std::endl;
+            return nullptr;
+        }
+        if (!peer->join(address, static_cast<unsigned short>(port), pixel))
+        {
+            std::cerr << "Could not open a UDP socket" << std::endl;
+            return nullptr;
+        }
+        std::cout << "Joining " << join_address << "..." << std::endl;
+    }
+
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (!peer->poll())
+    {
+        if (host_port == 0 && std::chrono::steady_clock::now() > give_up)
+        {
+            std::cerr << "No answer from " << join_address << std::endl;
+            return nullptr;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(1000000 / Simulation::tick_rate));
+    }
+    std::cout << "Connected" << std::endl;
+    return peer;
+}
+
 /**
  * @brief Main function - program entry point
+ * @param argc Number of command line arguments
+ * @param argv Command line arguments (see file header for options)
  * @return 0 on successful execution
- * 
+ *
  * Creates the game window with dimensions from Globals.h and
  * initializes the main game loop.
  */
-int main()
+int main(int argc, char* argv[])
 {
+    std::string record_path = "last_match.fbr";
+    std::string replay_path;
+    std::string profile_path = "frame_profile.csv";
+    int bot_player = -1;
+    int host_port = 0;
+    std::string join_address;
+    int input_delay = 2;
+    bool fast = false;
+    bool headless = false;
+    bool hashes = false;
+    bool verify = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--record" && i + 1 < argc)
+            record_path = argv[++i];
+        else if (arg == "--replay" && i + 1 < argc)
+            replay_path = argv[++i];
+        else if (arg == "--profile" && i + 1 < argc)
+            profile_path = argv[++i];
+        else if (arg == "--bot" && i + 1 < argc)
+        {
+            bot_player = std::atoi(argv[++i]) - 1;
+            if (bot_player != 0 && bot_player != 1)
+            {
+                std::cerr << "--bot takes 1 or 2" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--host" && i + 1 < argc)
+        {
+            host_port = std::atoi(argv[++i]);
+            if (host_port <= 0 || host_port > 65535)
+            {
+                std::cerr << "--host takes a port between 1 and 65535" << std::endl;
+                return 1;
+            }
+        }
+        else if (arg == "--join" && i + 1 < argc)
+            join_address = argv[++i];
+        else if (arg == "--input-delay" && i + 1 < argc)
+            input_delay = std::atoi(argv[++i]);
+        else if (arg == "--fast")
+            fast = true;
+        else if (arg == "--headless")
+            headless = true;
+        else if (arg == "--hashes")
+            hashes = true;
+        else if (arg == "--verify")
+            verify = true;
+        else
+        {
+            std::cerr << "Unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    if (verify)
+    {
+        if (replay_path.empty())
+        {
+            std::cerr << "--verify requires --replay <file>" << std::endl;
+            return 1;
+        }
+        return verifyReplay(replay_path);
+    }
+
+    if (headless)
+    {
+        if (replay_path.empty())
+        {
+            std::cerr << "--headless requires --replay <file>" << std::endl;
+            return 1;
+        }
+        return playReplayHeadless(replay_path, fast);
+    }
+
+    // Pair up before opening the window, so waiting never freezes it
+    std::unique_ptr<NetPeer> peer;
+    if (host_port != 0 || !join_address.empty())
+    {
+        if (!replay_path.empty() || bot_player >= 0 || (host_port != 0 && !join_address.empty()))
+        {
+            std::cerr << "--host and --join cannot be combined with each other, --replay or --bot" << std::endl;
+            return 1;
+        }
+        peer = connectOnline(static_cast<unsigned short>(host_port), join_address, input_delay);
+        if (!peer)
+            return 1;
+    }
+
     RenderWindow win(VideoMode(window_width, window_height), "Flappy Bird");  // Fixed: string literal was split across lines
     Game game(win);
+    game.profileTo(profile_path);
+    if (peer)
+    {
+        game.playOnline(std::move(peer));
+    }
+    else if (!replay_path.empty())
+    {
+        if (!game.loadReplay(replay_path, fast))
+        {
+            std::cerr << "Could not read replay file " << replay_path << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        game.recordTo(record_path, hashes);
+        if (bot_player >= 0)
+            game.setBot(bot_player);
+    }
     game.startGameLoop();
     return 0;
 }
@@ -0,0 +1,34 @@
+/**
+ * @file SplitMix64.h
+ * @brief SplitMix64 generator and hash finalizer for Flappy Bird 2-player game
+ *
+ * This file defines the 64-bit mixing function behind the pipe course,
+ * state hashes and the bots' and trainer's private random generators.
+ */
+
+#pragma once
+#include <cstdint>
+
+constexpr std::uint64_t splitmix64_gamma = 0x9e3779b97f4a7c15ULL;   ///< Generator increment (golden ratio)
+
+/**
+ * @brief SplitMix64 finalizer - mixes a 64-bit value into a well-distributed hash
+ * @param x Value to mix
+ * @return Hashed value
+ */
+inline std::uint64_t splitMix64Finish(std::uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief Advances a SplitMix64 generator
+ * @param state Generator state, advanced in place
+ * @return 64 random bits
+ */
+inline std::uint64_t splitMix64Next(std::uint64_t& state)
+{
+    return splitMix64Finish(state += splitmix64_gamma);
+}
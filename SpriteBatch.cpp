@@ -0,0 +1,62 @@
+/**
+ * @file SpriteBatch.cpp
+ * @brief Implementation of the SpriteBatch class for Flappy Bird 2-player game
+ */
+
+#include "SpriteBatch.h"
+
+/**
+ * @brief Constructor - creates an empty batch
+ * @param texture Texture all quads sample from
+ */
+SpriteBatch::SpriteBatch(const Texture* texture) :
+vertices(Triangles),
+texture(texture)
+{
+}
+
+/**
+ * @brief Grows the vertex storage so the batch can hold some quads without allocating
+ * @param quads Number of quads
+ */
+void SpriteBatch::reserve(std::size_t quads)
+{
+    // VertexArray has no reserve(); resizing then clearing keeps the capacity
+    std::size_t count = vertices.getVertexCount();
+    if (count < quads * 6)
+    {
+        vertices.resize(quads * 6);
+        vertices.resize(count);
+    }
+}
+
+/**
+ * @brief Adds a textured quad
+ * @param dest Screen rectangle to fill
+ * @param source Texture rectangle to sample
+ */
+void SpriteBatch::add(const FloatRect& dest, const IntRect& source)
+{
+    float left = dest.left, top = dest.top;
+    float right = dest.left + dest.width, bottom = dest.top + dest.height;
+    float u0 = static_cast<float>(source.left), v0 = static_cast<float>(source.top);
+    float u1 = u0 + source.width, v1 = v0 + source.height;
+
+    vertices.append(Vertex(Vector2f(left, top), Vector2f(u0, v0)));
+    vertices.append(Vertex(Vector2f(right, top), Vector2f(u1, v0)));
+    vertices.append(Vertex(Vector2f(right, bottom), Vector2f(u1, v1)));
+    vertices.append(Vertex(Vector2f(left, top), Vector2f(u0, v0)));
+    vertices.append(Vertex(Vector2f(right, bottom), Vector2f(u1, v1)));
+    vertices.append(Vertex(Vector2f(left, bottom), Vector2f(u0, v1)));
+}
+
+/**
+ * @brief Draws every quad with one call
+ * @param target Render target
+ * @param states Render states (the batch texture is added)
+ */
+void SpriteBatch::draw(RenderTarget& target, RenderStates states) const
+{
+    states.texture = texture;
+    target.draw(vertices, states);
+}
@@ -0,0 +1,65 @@
+/**
+ * @file SpriteBatch.h
+ * @brief Header file for the SpriteBatch class in Flappy Bird 2-player game
+ *
+ * This file defines the SpriteBatch class which collects textured quads
+ * from one texture atlas into a single vertex array, drawn with one call.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+
+using namespace sf;
+
+/**
+ * @class SpriteBatch
+ * @brief Vertex array of textured quads drawn in a single draw call
+ *
+ * Quads are drawn in the order they were added. clear() keeps the vertex
+ * storage, so refilling the batch every frame does not allocate once it
+ * has reached its working size.
+ */
+class SpriteBatch : public Drawable
+{
+private:
+    VertexArray vertices;        ///< Two triangles per quad
+    const Texture* texture;      ///< Texture all quads sample from
+
+    /**
+     * @brief Draws every quad with one call
+     * @param target Render target
+     * @param states Render states (the batch texture is added)
+     */
+    void draw(RenderTarget& target, RenderStates states) const override;
+
+public:
+    /**
+     * @brief Constructor - creates an empty batch
+     * @param texture Texture all quads sample from
+     */
+    explicit SpriteBatch(const Texture* texture = nullptr);
+
+    /**
+     * @brief Sets the texture all quads sample from
+     * @param new_texture Atlas texture
+     */
+    void setTexture(const Texture& new_texture) { texture = &new_texture; }
+
+    /**
+     * @brief Grows the vertex storage so the batch can hold some quads without allocating
+     * @param quads Number of quads
+     */
+    void reserve(std::size_t quads);
+
+    /**
+     * @brief Removes every quad, keeping the storage
+     */
+    void clear() { vertices.clear(); }
+
+    /**
+     * @brief Adds a textured quad
+     * @param dest Screen rectangle to fill
+     * @param source Texture rectangle to sample
+     */
+    void add(const FloatRect& dest, const IntRect& source);
+};
@@ -0,0 +1,97 @@
+/**
+ * @file SpscQueue.h
+ * @brief Header file for the SpscQueue class template in Flappy Bird 2-player game
+ *
+ * This file defines a bounded lock-free queue for exactly one producer
+ * thread and one consumer thread, used to hand timestamped input events
+ * from the input thread to the game loop.
+ */
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+/**
+ * @class SpscQueue
+ * @brief Bounded single-producer/single-consumer lock-free FIFO
+ * @tparam T Element type (copied in and out)
+ * @tparam Capacity Number of slots (must be a power of two)
+ *
+ * The producer only writes tail and the consumer only writes head, so
+ * each side needs one acquire load of the other's index and one release
+ * store of its own. The indices live on separate cache lines so the two
+ * threads do not invalidate each other's line on every operation.
+ */
+template <typename T, std::size_t Capacity>
+class SpscQueue
+{
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscQueue capacity must be a power of two");
+
+private:
+    static constexpr std::size_t cache_line = 64;   ///< Assumed cache line size in bytes
+
+    alignas(cache_line) std::atomic<std::size_t> head;   ///< Next slot to read (written by the consumer)
+    alignas(cache_line) std::atomic<std::size_t> tail;   ///< Next slot to write (written by the producer)
+    alignas(cache_line) T slots[Capacity];               ///< Element storage
+
+public:
+    SpscQueue() :
+    head(0),
+    tail(0)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Adds an element (producer thread only)
+     * @param item Element to add
+     * @return False if the queue was full and the element was dropped
+     */
+    bool push(const T& item)
+    {
+        std::size_t write = tail.load(std::memory_order_relaxed);
+        if (write - head.load(std::memory_order_acquire) == Capacity)
+            return false;
+        slots[write & (Capacity - 1)] = item;
+        tail.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Looks at the oldest element without removing it (consumer thread only)
+     * @return Pointer to the element, or nullptr if the queue is empty
+     */
+    const T* front() const
+    {
+        std::size_t read = head.load(std::memory_order_relaxed);
+        if (read == tail.load(std::memory_order_acquire))
+            return nullptr;
+        return &slots[read & (Capacity - 1)];
+    }
+
+    /**
+     * @brief Removes the oldest element (consumer thread only, queue not empty)
+     */
+    void pop()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Removes and returns the oldest element (consumer thread only)
+     * @param item Receives the element
+     * @return False if the queue was empty
+     */
+    bool pop(T& item)
+    {
+        const T* oldest = front();
+        if (!oldest)
+            return false;
+        item = *oldest;
+        pop();
+        return true;
+    }
+};
@@ -0,0 +1,68 @@
+/**
+ * @file StateHash.cpp
+ * @brief Implementation of simulation state hashing for Flappy Bird 2-player game
+ */
+
+#include "StateHash.h"
+#include "SplitMix64.h"
+
+static const char* const field_names[StateHash::field_count] =
+{
+    "tick",
+    "bird 1 position", "bird 1 velocity", "bird 1 status",
+    "bird 2 position", "bird 2 velocity", "bird 2 status",
+    "pipes", "pipe timer", "scores", "run flags", "ground"
+};
+
+/**
+ * @brief Gets the hash of the whole state
+ * @return Hash of all fields together
+ */
+std::uint64_t StateHash::combined() const
+{
+    std::uint64_t hash = 0;
+    for (int i = 0; i < field_count; i++)
+        hash = mix(hash, fields[i]);
+    return splitMix64Finish(hash);
+}
+
+/**
+ * @brief Gets the compact form stored in replays
+ * @return Digest of this hash
+ */
+StateDigest StateHash::getDigest() const
+{
+    StateDigest digest;
+    digest.combined = static_cast<std::uint32_t>(combined());
+    for (int i = 0; i < field_count; i++)
+        digest.fields[i] = static_cast<std::uint8_t>(splitMix64Finish(fields[i]) >> 56);
+    return digest;
+}
+
+/**
+ * @brief Gets the display name of a field
+ * @param field Field
+ * @return Human-readable name
+ */
+const char* StateHash::getName(StateField field)
+{
+    return field_names[static_cast<int>(field)];
+}
+
+/**
+ * @brief Finds where two digests differ
+ * @param other Digest to compare with
+ * @return -1 if equal, the first differing field, or field_count if only the whole-state part differs
+ *
+ * A field byte can collide (1 in 256) while the whole-state part still
+ * catches the change; the caller then knows the tick but not the field.
+ */
+int StateDigest::findDifference(const StateDigest& other) const
+{
+    for (int i = 0; i < StateHash::field_count; i++)
+    {
+        if (fields[i] != other.fields[i])
+            return i;
+    }
+    return combined != other.combined ? StateHash::field_count : -1;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file StateHash.h
+ * @brief Header file for simulation state hashing in Flappy Bird 2-player game
+ *
+ * This file defines StateHash, a per-field hash of everything a
+ * Simulation carries from one tick to the next, and StateDigest, its
+ * compact form stored in replays. Replaying a log and comparing digests
+ * tick by tick proves two builds simulate a match bit for bit the same,
+ * and names the first field where they part ways.
+ */
+
+#pragma once
+#include <cstdint>
+#include <cstring>
+
+/**
+ * @enum StateField
+ * @brief Groups of simulation state hashed separately
+ */
+enum class StateField
+{
+    Tick,            ///< Ticks stepped since reset
+    Bird1Position,   ///< Player 1 position, previous and last checked heights
+    Bird1Velocity,   ///< Player 1 vertical velocity
+    Bird1Status,     ///< Player 1 animation, flying/active/collided flags and flap count
+    Bird2Position,   ///< Player 2 position, previous and last checked heights
+    Bird2Velocity,   ///< Player 2 vertical velocity
+    Bird2Status,     ///< Player 2 animation, flying/active/collided flags and flap count
+    Pipes,           ///< Position, height and gap of every active pipe
+    PipeTimer,       ///< pipe_counter, spawn interval, pipe course and next pipe index
+    Scores,          ///< Both scores
+    RunFlags,        ///< Running and score monitoring flags
+    Ground,          ///< Ground scroll
+    Count            ///< Number of fields
+};
+
+struct StateDigest;
+
+/**
+ * @struct StateHash
+ * @brief 64-bit hash of each StateField after one tick
+ *
+ * Floats are hashed by their bit patterns, so any change in rounding
+ * shows up. Filled in by Simulation::hashState().
+ */
+struct StateHash
+{
+    static const int field_count = static_cast<int>(StateField::Count);   ///< Number of fields
+
+    std::uint64_t fields[field_count];   ///< Hash of each field
+
+    /**
+     * @brief Folds a value into a running hash
+     * @param hash Hash so far
+     * @param value Value to add
+     * @return Updated hash
+     */
+    static std::uint64_t mix(std::uint64_t hash, std::uint64_t value)
+    {
+        hash = (hash ^ value) * 0x9e3779b97f4a7c15ULL;
+        return hash ^ (hash >> 29);
+    }
+
+    /**
+     * @brief Folds a float into a running hash, bit for bit
+     * @param hash Hash so far
+     * @param value Value to add
+     * @return Updated hash
+     */
+    static std::uint64_t mix(std::uint64_t hash, float value)
+    {
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return mix(hash, static_cast<std::uint64_t>(bits));
+    }
+
+    /**
+     * @brief Gets the hash of the whole state
+     * @return Hash of all fields together
+     */
+    std::uint64_t combined() const;
+
+    /**
+     * @brief Gets the compact form stored in replays
+     * @return Digest of this hash
+     */
+    StateDigest getDigest() const;
+
+    /**
+     * @brief Gets the display name of a field
+     * @param field Field
+     * @return Human-readable name
+     */
+    static const char* getName(StateField field);
+};
+
+/**
+ * @struct StateDigest
+ * @brief Replay form of a StateHash: 32 bits of the whole plus 8 bits per field
+ *
+ * The whole-state part makes a missed divergence practically impossible;
+ * the per-field bytes only have to say where it is.
+ */
+struct StateDigest
+{
+    static const int size = 4 + StateHash::field_count;   ///< Bytes taken in a replay
+
+    std::uint32_t combined;                          ///< Low bits of StateHash::combined()
+    std::uint8_t fields[StateHash::field_count];     ///< One byte per field
+
+    /**
+     * @brief Finds where two digests differ
+     * @param other Digest to compare with
+     * @return -1 if equal, the first differing field, or field_count if only the whole-state part differs
+     */
+    int findDifference(const StateDigest& other) const;
+};
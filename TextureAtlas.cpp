@@ -0,0 +1,148 @@
+/**
+ * @file TextureAtlas.cpp
+ * @brief Implementation of the TextureAtlas class for Flappy Bird 2-player game
+ *
+ * This file contains image registration, downscaling and shelf packing.
+ */
+
+#include "TextureAtlas.h"
+#include <algorithm>
+
+static const unsigned atlas_width = 1024;   ///< Width of the atlas texture
+static const unsigned atlas_padding = 1;    ///< Empty pixels around each region (avoids bleeding)
+
+/**
+ * @brief Registers an image file for packing
+ * @param path Image file path
+ * @param max_width Largest width to keep (0 = no limit)
+ * @param max_height Largest height to keep (0 = no limit)
+ * @return Region index to pass to getRect()
+ *
+ * Registering the same file twice returns the existing region.
+ */
+int TextureAtlas::add(const std::string& path, unsigned max_width, unsigned max_height)
+{
+    for (std::size_t i = 0; i < regions.size(); i++)
+    {
+        if (regions[i].path == path)
+            return static_cast<int>(i);
+    }
+
+    Region region;
+    region.path = path;
+    region.image.loadFromFile(path);  // SFML reports failures itself
+
+    // Shrink by the smallest integer factor that fits the requested size
+    Vector2u size = region.image.getSize();
+    unsigned factor = 1;
+    if (max_width && size.x > max_width)
+        factor = std::max(factor, (size.x + max_width - 1) / max_width);
+    if (max_height && size.y > max_height)
+        factor = std::max(factor, (size.y + max_height - 1) / max_height);
+    if (factor > 1)
+        region.image = shrink(region.image, factor);
+
+    regions.push_back(region);
+    return static_cast<int>(regions.size() - 1);
+}
+
+/**
+ * @brief Registers an image already in memory for packing
+ * @param image Pixels to pack (copied)
+ * @return Region index to pass to getRect()
+ */
+int TextureAtlas::add(const Image& image)
+{
+    Region region;
+    region.image = image;
+    regions.push_back(region);
+    return static_cast<int>(regions.size() - 1);
+}
+
+/**
+ * @brief Box-filters an image down by an integer factor
+ * @param source Image to shrink
+ * @param factor Shrink factor (each output pixel averages factor x factor pixels)
+ * @return Shrunk image
+ */
+Image TextureAtlas::shrink(const Image& source, unsigned factor)
+{
+    Vector2u size = source.getSize();
+    unsigned width = std::max(1u, size.x / factor);
+    unsigned height = std::max(1u, size.y / factor);
+    const Uint8* in = source.getPixelsPtr();
+    std::vector<Uint8> out(width * height * 4);
+
+    for (unsigned y = 0; y < height; y++)
+    {
+        for (unsigned x = 0; x < width; x++)
+        {
+            unsigned sum[4] = { 0, 0, 0, 0 };
+            unsigned count = 0;
+            for (unsigned sy = y * factor; sy < std::min(size.y, (y + 1) * factor); sy++)
+            {
+                for (unsigned sx = x * factor; sx < std::min(size.x, (x + 1) * factor); sx++)
+                {
+                    const Uint8* pixel = in + (sy * size.x + sx) * 4;
+                    for (int c = 0; c < 4; c++)
+                        sum[c] += pixel[c];
+                    count++;
+                }
+            }
+            for (int c = 0; c < 4; c++)
+                out[(y * width + x) * 4 + c] = static_cast<Uint8>(sum[c] / count);
+        }
+    }
+
+    Image result;
+    result.create(width, height, out.data());
+    return result;
+}
+
+/**
+ * @brief Packs every registered image into the atlas texture
+ * @return True if the texture could be created
+ *
+ * Regions are placed left to right on shelves, tallest first, and the
+ * atlas height is rounded up to a power of two. Source images are
+ * released once uploaded.
+ */
+bool TextureAtlas::build()
+{
+    std::vector<std::size_t> order(regions.size());
+    for (std::size_t i = 0; i < order.size(); i++)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b)
+    {
+        return regions[a].image.getSize().y > regions[b].image.getSize().y;
+    });
+
+    // Shelf packing
+    unsigned x = 0, y = 0, shelf_height = 0;
+    for (std::size_t i : order)
+    {
+        Vector2u size = regions[i].image.getSize();
+        if (x + size.x + atlas_padding > atlas_width)
+        {
+            x = 0;
+            y += shelf_height;
+            shelf_height = 0;
+        }
+        regions[i].rect = IntRect(x + atlas_padding, y + atlas_padding, size.x, size.y);
+        x += size.x + atlas_padding;
+        shelf_height = std::max(shelf_height, size.y + atlas_padding);
+    }
+
+    unsigned height = 1;
+    while (height < y + shelf_height + atlas_padding)
+        height *= 2;
+
+    Image atlas;
+    atlas.create(atlas_width, height, Color::Transparent);
+    for (Region& region : regions)
+    {
+        atlas.copy(region.image, region.rect.left, region.rect.top);
+        region.image = Image();
+    }
+    return texture.loadFromImage(atlas);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file TextureAtlas.h
+ * @brief Header file for the TextureAtlas class in Flappy Bird 2-player game
+ *
+ * This file defines the TextureAtlas class which packs several gameplay
+ * images into one texture, so everything drawn from it can share a single
+ * texture binding and be batched into one draw call.
+ */
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+using namespace sf;
+
+/**
+ * @class TextureAtlas
+ * @brief Packs images into one texture and maps each to its sub-rectangle
+ *
+ * Images are registered with add(), then packed with build() using simple
+ * shelf packing (tallest first). Oversized images are box-filtered down to
+ * a requested maximum size while registering, which keeps high-resolution
+ * source art from blowing past GPU texture size limits.
+ */
+class TextureAtlas
+{
+private:
+    /**
+     * @struct Region
+     * @brief One packed image
+     */
+    struct Region
+    {
+        std::string path;    ///< Source file (used to avoid packing a file twice, empty for in-memory images)
+        Image image;         ///< Source pixels, released after build()
+        IntRect rect;        ///< Location inside the atlas texture
+    };
+
+    std::vector<Region> regions;   ///< Registered images
+    Texture texture;               ///< Packed atlas texture
+
+    /**
+     * @brief Box-filters an image down by an integer factor
+     * @param source Image to shrink
+     * @param factor Shrink factor (each output pixel averages factor x factor pixels)
+     * @return Shrunk image
+     */
+    static Image shrink(const Image& source, unsigned factor);
+
+public:
+    /**
+     * @brief Registers an image file for packing
+     * @param path Image file path
+     * @param max_width Largest width to keep (0 = no limit)
+     * @param max_height Largest height to keep (0 = no limit)
+     * @return Region index to pass to getRect()
+     */
+    int add(const std::string& path, unsigned max_width = 0, unsigned max_height = 0);
+
+    /**
+     * @brief Registers an image already in memory for packing
+     * @param image Pixels to pack (copied)
+     * @return Region index to pass to getRect()
+     */
+    int add(const Image& image);
+
+    /**
+     * @brief Packs every registered image into the atlas texture
+     * @return True if the texture could be created
+     */
+    bool build();
+
+    /**
+     * @brief Gets where a region lives inside the atlas
+     * @param region Index returned by add()
+     * @return Texture rectangle of the region
+     */
+    const IntRect& getRect(int region) const { return regions[region].rect; }
+
+    /**
+     * @brief Gets the packed atlas texture
+     * @return Atlas texture (valid after build())
+     */
+    const Texture& getTexture() const { return texture; }
+};
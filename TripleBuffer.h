@@ -0,0 +1,77 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Header file for the TripleBuffer class template in Flappy Bird 2-player game
+ *
+ * This file defines a lock-free triple buffer, used to hand the newest
+ * simulation snapshot from the simulation thread to the render thread.
+ */
+
+#pragma once
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Latest-value channel from one writer thread to one reader thread
+ * @tparam T Value type (slots are reused, so assigning into one should not allocate)
+ *
+ * The writer fills back() and publishes it; the reader calls update() and
+ * reads front(). Three slots mean neither side ever waits: the writer
+ * always has a slot the reader is not using, and the reader always sees
+ * the most recently published value. Values published while the reader
+ * is busy are overwritten, not queued.
+ */
+template <typename T>
+class TripleBuffer
+{
+private:
+    static constexpr unsigned index_mask = 3;   ///< Bits holding a slot index
+    static constexpr unsigned fresh = 4;        ///< Set when the middle slot holds an unread value
+
+    T slots[3];                        ///< Front, middle and back values
+    std::atomic<unsigned> middle;      ///< Slot being handed over, plus the fresh bit
+    unsigned back_index;               ///< Slot owned by the writer
+    unsigned front_index;              ///< Slot owned by the reader
+
+public:
+    TripleBuffer() :
+    middle(1),
+    back_index(2),
+    front_index(0)
+    {
+    }
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Gets the slot to fill (writer thread only)
+     * @return Writer's slot; holds an older value until overwritten
+     */
+    T& back() { return slots[back_index]; }
+
+    /**
+     * @brief Publishes the back slot as the newest value (writer thread only)
+     */
+    void publish()
+    {
+        back_index = middle.exchange(back_index | fresh, std::memory_order_acq_rel) & index_mask;
+    }
+
+    /**
+     * @brief Takes the newest published value if there is one (reader thread only)
+     * @return True if front() changed
+     */
+    bool update()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & fresh))
+            return false;
+        front_index = middle.exchange(front_index, std::memory_order_acq_rel) & index_mask;
+        return true;
+    }
+
+    /**
+     * @brief Gets the value taken by the last update() (reader thread only)
+     * @return Reader's slot
+     */
+    const T& front() const { return slots[front_index]; }
+};
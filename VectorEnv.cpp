@@ -0,0 +1,175 @@
+/**
+ * @file VectorEnv.cpp
+ * @brief Implementation of the VectorEnv class for Flappy Bird 2-player game
+ *
+ * This file contains batched stepping, episode bookkeeping and the
+ * observation encoding of the reinforcement-learning environment.
+ */
+
+#include "VectorEnv.h"
+#include "Globals.h"
+
+/**
+ * @brief Constructor - creates the matches
+ * @param count Number of matches
+ * @param seed Pipe course of the first episode (later episodes count up from it)
+ * @param env_config Settings of every match
+ *
+ * Nothing is written until buffers are set and reset() is called.
+ */
+VectorEnv::VectorEnv(std::size_t count, std::uint64_t seed, const EnvConfig& env_config) :
+config(env_config),
+agents_per_env(env_config.self_play ? 2 : 1),
+scores(count * agents_per_env, 0),
+alive(count * agents_per_env, 1),
+next_seed(seed),
+observations(nullptr),
+rewards(nullptr),
+dones(nullptr)
+{
+    matches.reserve(count);
+    for (std::size_t env = 0; env < count; env++)
+        matches.emplace_back(0, config.sim);
+    if (!config.self_play)
+    {
+        opponents.reserve(count);
+        for (std::size_t env = 0; env < count; env++)
+            opponents.emplace_back(1, seed + env, 20.f);
+    }
+}
+
+/**
+ * @brief Sets the buffers results are written to
+ * @param obs getAgentCount() x obs_size floats
+ * @param reward getAgentCount() floats
+ * @param done getAgentCount() bytes
+ *
+ * The buffers stay the caller's; they must outlive every later call.
+ */
+void VectorEnv::setBuffers(float* obs, float* reward, std::uint8_t* done)
+{
+    observations = obs;
+    rewards = reward;
+    dones = done;
+}
+
+/**
+ * @brief Starts a new episode in every match and writes the first observations
+ *
+ * Rewards and done flags are cleared.
+ */
+void VectorEnv::reset()
+{
+    for (std::size_t env = 0; env < matches.size(); env++)
+    {
+        resetMatch(env);
+        for (int player = 0; player < agents_per_env; player++)
+        {
+            std::size_t agent = env * agents_per_env + player;
+            observe(matches[env], player, observations + agent * obs_size);
+            rewards[agent] = 0.f;
+            dones[agent] = 0;
+        }
+    }
+}
+
+/**
+ * @brief Starts a new episode in one match
+ * @param env Match index
+ */
+void VectorEnv::resetMatch(std::size_t env)
+{
+    matches[env].reset(next_seed++);
+    for (int player = 0; player < agents_per_env; player++)
+    {
+        scores[env * agents_per_env + player] = 0;
+        alive[env * agents_per_env + player] = 1;
+    }
+}
+
+/**
+ * @brief Advances every match by one tick
+ * @param actions One byte per agent, non-zero to flap
+ *
+ * An agent is rewarded for each pipe it passes and penalized once when
+ * its bird goes out. An episode ends when every agent's bird is out or
+ * max_ticks have passed; the match then resets in the same call.
+ */
+void VectorEnv::stepBatch(const std::uint8_t* actions)
+{
+    for (std::size_t env = 0; env < matches.size(); env++)
+    {
+        Simulation& sim = matches[env];
+        std::size_t first_agent = env * agents_per_env;
+
+        SimInput input;
+        input.start = true;
+        for (int player = 0; player < agents_per_env; player++)
+            input.flap[player] = actions[first_agent + player] != 0;
+        if (!config.self_play)
+            opponents[env].play(sim, input);
+        sim.step(input);
+
+        bool over = sim.getTick() >= config.max_ticks;
+        bool all_out = true;
+        for (int player = 0; player < agents_per_env; player++)
+        {
+            std::size_t agent = first_agent + player;
+            bool in = sim.getBird(player).active;
+            int score = sim.getScore(player);
+            rewards[agent] = (score - scores[agent]) * config.score_reward
+                           + (alive[agent] && !in ? config.death_reward : 0.f);
+            scores[agent] = score;
+            alive[agent] = in;
+            all_out = all_out && !in;
+        }
+        over = over || all_out;
+
+        if (over)
+            resetMatch(env);
+        for (int player = 0; player < agents_per_env; player++)
+        {
+            dones[first_agent + player] = over;
+            observe(sim, player, observations + (first_agent + player) * obs_size);
+        }
+    }
+}
+
+/**
+ * @brief Writes the observation of one agent
+ * @param sim Match the agent is in
+ * @param player Bird the agent flies
+ * @param out obs_size floats to fill
+ *
+ * Layout: height, velocity, then distance, gap top and gap bottom of
+ * the next pipe and of the one after it. Heights are divided by the
+ * window height, distances by the window width and velocities by
+ * 600 pixels per second.
+ */
+void VectorEnv::observe(const Simulation& sim, int player, float* out)
+{
+    BirdState bird = sim.getBird(player);
+    out[0] = bird.y / window_height;
+    out[1] = bird.velocity / 600.f;
+
+    int written = 0;
+    for (const PipeState& pipe : sim.getPipes())
+    {
+        if (written == 2)
+            break;
+        if (pipe.x + pipe_width <= bird.x)
+            continue;
+        float* slot = out + 2 + written * 3;
+        slot[0] = (pipe.x - bird.x) / window_width;
+        slot[1] = (pipe.y_pos - pipe.gap) / window_height;
+        slot[2] = pipe.y_pos / window_height;
+        written++;
+    }
+    for (; written < 2; written++)
+    {
+        float* slot = out + 2 + written * 3;
+        slot[0] = 1.f;
+        slot[1] = (window_height / 2 - sim.getConfig().pipe_distance / 2.f) / window_height;
+        slot[2] = (window_height / 2 + sim.getConfig().pipe_distance / 2.f) / window_height;
+    }
+}
@@ -0,0 +1,124 @@
+/**
+ * @file VectorEnv.h
+ * @brief Header file for the VectorEnv class in Flappy Bird 2-player game
+ *
+ * This file defines VectorEnv, a batch of independent headless matches
+ * stepped together for reinforcement-learning agents. Observations,
+ * rewards and done flags are written straight into buffers owned by the
+ * caller, so a training loop can hand in its own tensors.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Bot.h"
+#include "Simulation.h"
+
+/**
+ * @struct EnvConfig
+ * @brief Settings shared by every match of a VectorEnv
+ */
+struct EnvConfig
+{
+    SimConfig sim;                        ///< Gameplay parameters of every match
+    bool self_play = false;               ///< True: agents fly both birds; false: the rule bot flies Player 2
+    std::uint32_t max_ticks = 300 * Simulation::tick_rate;  ///< Ticks before an episode is cut off
+    float score_reward = 1.f;             ///< Reward for passing a pipe
+    float death_reward = -1.f;            ///< Reward on the tick an agent's bird goes out
+};
+
+/**
+ * @class VectorEnv
+ * @brief Steps many matches per call, writing results into caller-owned buffers
+ *
+ * Each match runs the game's own Simulation. An agent is one bird:
+ * Player 1 of every match, plus Player 2 in self-play. Agent a flies
+ * player a % agents_per_env of match a / agents_per_env.
+ *
+ * Each agent sees obs_size floats, all scaled to about [-1, 1]: its
+ * height and vertical velocity, then the horizontal distance and gap
+ * edges of the next two pipes it has not passed (a missing pipe reads
+ * as one screen away with the gap centred). Actions are one byte per
+ * agent, non-zero to flap.
+ *
+ * Matches reset themselves: on the step an episode ends, done is set
+ * and the observation written is already the first one of the next
+ * episode, on the next pipe course. Every match keeps pressing Enter,
+ * so a collision never leaves it paused.
+ */
+class VectorEnv
+{
+public:
+    static constexpr int obs_size = 8;    ///< Floats per agent observation
+
+private:
+    EnvConfig config;                     ///< Settings of every match
+    int agents_per_env;                   ///< 2 in self-play, otherwise 1
+    std::vector<Simulation> matches;      ///< One simulation per environment
+    std::vector<Bot> opponents;           ///< Player 2 of each match when not in self-play
+    std::vector<std::int32_t> scores;     ///< Score of each agent at the last step
+    std::vector<std::uint8_t> alive;      ///< 1 while each agent's bird is in
+    std::uint64_t next_seed;              ///< Pipe course of the next episode to start
+    float* observations;                  ///< Caller's buffer, agents x obs_size
+    float* rewards;                       ///< Caller's buffer, one per agent
+    std::uint8_t* dones;                  ///< Caller's buffer, one per agent
+
+    /**
+     * @brief Starts a new episode in one match
+     * @param env Match index
+     */
+    void resetMatch(std::size_t env);
+
+    /**
+     * @brief Writes the observation of one agent
+     * @param sim Match the agent is in
+     * @param player Bird the agent flies
+     * @param out obs_size floats to fill
+     */
+    static void observe(const Simulation& sim, int player, float* out);
+
+public:
+    /**
+     * @brief Constructor - creates the matches
+     * @param count Number of matches
+     * @param seed Pipe course of the first episode (later episodes count up from it)
+     * @param env_config Settings of every match
+     */
+    VectorEnv(std::size_t count, std::uint64_t seed = 1, const EnvConfig& env_config = EnvConfig());
+
+    /**
+     * @brief Gets the number of agents
+     * @return Matches times agents per match
+     */
+    std::size_t getAgentCount() const { return matches.size() * agents_per_env; }
+
+    /**
+     * @brief Gets the number of matches
+     * @return Matches stepped per call
+     */
+    std::size_t getEnvCount() const { return matches.size(); }
+
+    /**
+     * @brief Sets the buffers results are written to
+     * @param obs getAgentCount() x obs_size floats
+     * @param reward getAgentCount() floats
+     * @param done getAgentCount() bytes
+     *
+     * The buffers stay the caller's; they must outlive every later call.
+     */
+    void setBuffers(float* obs, float* reward, std::uint8_t* done);
+
+    /**
+     * @brief Starts a new episode in every match and writes the first observations
+     *
+     * Rewards and done flags are cleared.
+     */
+    void reset();
+
+    /**
+     * @brief Advances every match by one tick
+     * @param actions One byte per agent, non-zero to flap
+     */
+    void stepBatch(const std::uint8_t* actions);
+};
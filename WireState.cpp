@@ -0,0 +1,126 @@
+/**
+ * @file WireState.cpp
+ * @brief Implementation of the quantized network state for Flappy Bird 2-player game
+ */
+
+#include "WireState.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Rounds a value to a signed 16-bit word, saturating
+ * @param value Value in word units
+ * @return Word holding the two's complement value
+ */
+static std::uint16_t quantize(float value)
+{
+    float clamped = std::max(-32768.f, std::min(32767.f, std::round(value)));
+    return static_cast<std::uint16_t>(static_cast<std::int16_t>(clamped));
+}
+
+/**
+ * @brief Encodes a Simulation's current state
+ * @param sim Match to encode
+ */
+void WireState::capture(const Simulation& sim)
+{
+    std::uint32_t tick = static_cast<std::uint32_t>(sim.getTick());
+    words[TickLow] = static_cast<std::uint16_t>(tick);
+    words[TickHigh] = static_cast<std::uint16_t>(tick >> 16);
+
+    const BirdPool& birds = sim.getBirds();
+    for (int player = 0; player < 2; player++)
+    {
+        words[Bird1Y + 3 * player] = quantize(birds.y[player] * 4.f);
+        words[Bird1Velocity + 3 * player] = quantize(birds.velocity[player]);
+        words[Bird1Flags + 3 * player] = static_cast<std::uint16_t>(
+            (birds.flying[player] ? bird_flying : 0) |
+            (birds.active[player] ? bird_active : 0) |
+            (birds.collided[player] ? bird_collided : 0) |
+            (birds.frame[player] ? bird_wing_up : 0));
+        words[Score1 + player] = static_cast<std::uint16_t>(std::min(sim.getScore(player), 0xffff));
+    }
+
+    words[RunFlags] = static_cast<std::uint16_t>((sim.isRunning() ? run_running : 0) | (sim.isOver() ? run_over : 0));
+    words[Ground] = quantize(sim.getGroundOffset() * 4.f);
+
+    const PipePool& pipes = sim.getPipes();
+    int count = static_cast<int>(std::min<std::size_t>(pipes.size(), max_pipes));
+    words[PipeCount] = static_cast<std::uint16_t>(count);
+    for (int i = 0; i < max_pipes; i++)
+    {
+        // Unused slots are zeroed so they never show up as changes
+        words[FirstPipe + 2 * i] = i < count ? quantize(pipes[i].x * 4.f) : 0;
+        words[FirstPipe + 2 * i + 1] = i < count ? quantize(pipes[i].y_pos) : 0;
+    }
+}
+
+/**
+ * @brief Hashes every word, so a client can check its decoded state
+ * @return 32-bit FNV-1a hash
+ */
+std::uint32_t WireState::checksum() const
+{
+    std::uint32_t hash = 2166136261u;
+    for (std::uint16_t word : words)
+    {
+        hash = (hash ^ (word & 0xff)) * 16777619u;
+        hash = (hash ^ (word >> 8)) * 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Writes the words of state that differ from base
+ * @param base State the receiver already has
+ * @param state State to send
+ * @param out At least max_delta bytes
+ * @return Bytes written
+ *
+ * Layout: mask_bytes bytes of change mask (bit i of byte i / 8 set if
+ * word i changed), then each changed word, little-endian, in order.
+ */
+std::size_t WireState::encodeDelta(const WireState& base, const WireState& state, std::uint8_t* out)
+{
+    std::size_t size = mask_bytes;
+    for (std::size_t i = 0; i < mask_bytes; i++)
+        out[i] = 0;
+
+    for (int i = 0; i < WordCount; i++)
+    {
+        if (state.words[i] == base.words[i])
+            continue;
+        out[i / 8] |= static_cast<std::uint8_t>(1 << (i % 8));
+        out[size++] = static_cast<std::uint8_t>(state.words[i]);
+        out[size++] = static_cast<std::uint8_t>(state.words[i] >> 8);
+    }
+    return size;
+}
+
+/**
+ * @brief Rebuilds a state from a base and a delta
+ * @param base State the delta was made against
+ * @param in Delta bytes
+ * @param size Bytes available
+ * @param state Receives the new state (may be the same object as base)
+ * @return Bytes read, or 0 if the delta is truncated
+ */
+std::size_t WireState::decodeDelta(const WireState& base, const std::uint8_t* in, std::size_t size, WireState& state)
+{
+    if (size < mask_bytes)
+        return 0;
+
+    WireState result = base;
+    std::size_t used = mask_bytes;
+    for (int i = 0; i < WordCount; i++)
+    {
+        if (!(in[i / 8] & (1 << (i % 8))))
+            continue;
+        if (used + 2 > size)
+            return 0;
+        result.words[i] = static_cast<std::uint16_t>(in[used] | (in[used + 1] << 8));
+        used += 2;
+    }
+    state = result;
+    return used;
+}
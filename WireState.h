@@ -0,0 +1,150 @@
+/**
+ * @file WireState.h
+ * @brief Header file for the WireState struct in Flappy Bird 2-player game
+ *
+ * This file defines the match state a server sends its clients: the
+ * drawable part of a Simulation quantized to 16-bit words, and a delta
+ * encoding that only sends the words that changed since a state the
+ * client already has.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "Simulation.h"
+
+/**
+ * @struct WireState
+ * @brief Drawable match state as a fixed array of 16-bit words
+ *
+ * Positions are stored in quarter pixels and velocities in whole pixels
+ * per second, which is finer than anything a client draws. Only the
+ * max_pipes oldest pipes are sent; with the shipped settings no more are
+ * ever active.
+ *
+ * A delta is a bit mask of the words that differ from a base state,
+ * followed by the new value of each of those words. Between two sent
+ * ticks usually only the tick, the birds, the ground and the pipe
+ * positions change, so a delta is about half the size of the full state.
+ */
+struct WireState
+{
+    static constexpr int max_pipes = 4;                 ///< Pipes sent per state
+
+    /**
+     * @enum Word
+     * @brief Meaning of each word
+     */
+    enum Word
+    {
+        TickLow, TickHigh,                              ///< Tick, low and high 16 bits
+        Bird1Y, Bird1Velocity, Bird1Flags,              ///< Player 1 top edge, velocity, flags
+        Bird2Y, Bird2Velocity, Bird2Flags,              ///< Player 2 top edge, velocity, flags
+        Score1, Score2,                                 ///< Player scores
+        RunFlags,                                       ///< run_running and run_over
+        Ground,                                         ///< Ground scroll
+        PipeCount,                                      ///< Pipes sent
+        FirstPipe,                                      ///< Left edge, then gap bottom, of each pipe
+        WordCount = FirstPipe + 2 * max_pipes           ///< Number of words
+    };
+
+    static constexpr std::size_t mask_bytes = (WordCount + 7) / 8;                  ///< Bytes of a delta's change mask
+    static constexpr std::size_t max_delta = mask_bytes + 2 * WordCount;            ///< Largest delta
+
+    // Bits of the bird flag words
+    static constexpr std::uint16_t bird_flying = 1 << 0;      ///< Bird physics are active
+    static constexpr std::uint16_t bird_active = 1 << 1;      ///< Still in the match
+    static constexpr std::uint16_t bird_collided = 1 << 2;    ///< Hit a pipe or the ground
+    static constexpr std::uint16_t bird_wing_up = 1 << 3;     ///< Wing frame shown
+
+    // Bits of the RunFlags word
+    static constexpr std::uint16_t run_running = 1 << 0;      ///< Match is running
+    static constexpr std::uint16_t run_over = 1 << 1;         ///< Both birds have collided
+
+    std::uint16_t words[WordCount] = {};                      ///< Encoded state (all zero = empty base)
+
+    /**
+     * @brief Encodes a Simulation's current state
+     * @param sim Match to encode
+     */
+    void capture(const Simulation& sim);
+
+    /**
+     * @brief Gets the tick the state was captured after
+     * @return Tick (32 bits)
+     */
+    std::uint32_t getTick() const { return words[TickLow] | static_cast<std::uint32_t>(words[TickHigh]) << 16; }
+
+    /**
+     * @brief Gets a bird's top edge
+     * @param player Player index (0 or 1)
+     * @return Height in pixels
+     */
+    float getBirdY(int player) const { return static_cast<std::int16_t>(words[Bird1Y + 3 * player]) / 4.f; }
+
+    /**
+     * @brief Gets a bird's vertical velocity
+     * @param player Player index (0 or 1)
+     * @return Pixels per second (positive = falling)
+     */
+    float getBirdVelocity(int player) const { return static_cast<std::int16_t>(words[Bird1Velocity + 3 * player]); }
+
+    /**
+     * @brief Gets a bird's flag word
+     * @param player Player index (0 or 1)
+     * @return bird_flying, bird_active, bird_collided and bird_wing_up bits
+     */
+    std::uint16_t getBirdFlags(int player) const { return words[Bird1Flags + 3 * player]; }
+
+    /**
+     * @brief Gets a player's score
+     * @param player Player index (0 or 1)
+     * @return Pipes passed
+     */
+    int getScore(int player) const { return words[Score1 + player]; }
+
+    /**
+     * @brief Gets the number of pipes sent
+     * @return Pipe count, at most max_pipes
+     */
+    int getPipeCount() const { return words[PipeCount]; }
+
+    /**
+     * @brief Gets a pipe's left edge
+     * @param pipe Pipe index, oldest first
+     * @return Left edge in pixels
+     */
+    float getPipeX(int pipe) const { return static_cast<std::int16_t>(words[FirstPipe + 2 * pipe]) / 4.f; }
+
+    /**
+     * @brief Gets the bottom of a pipe's gap (top edge of its lower segment)
+     * @param pipe Pipe index, oldest first
+     * @return Height in pixels
+     */
+    float getPipeGapBottom(int pipe) const { return static_cast<std::int16_t>(words[FirstPipe + 2 * pipe + 1]); }
+
+    /**
+     * @brief Hashes every word, so a client can check its decoded state
+     * @return 32-bit FNV-1a hash
+     */
+    std::uint32_t checksum() const;
+
+    /**
+     * @brief Writes the words of state that differ from base
+     * @param base State the receiver already has
+     * @param state State to send
+     * @param out At least max_delta bytes
+     * @return Bytes written
+     */
+    static std::size_t encodeDelta(const WireState& base, const WireState& state, std::uint8_t* out);
+
+    /**
+     * @brief Rebuilds a state from a base and a delta
+     * @param base State the delta was made against
+     * @param in Delta bytes
+     * @param size Bytes available
+     * @param state Receives the new state (may be the same object as base)
+     * @return Bytes read, or 0 if the delta is truncated
+     */
+    static std::size_t decodeDelta(const WireState& base, const std::uint8_t* in, std::size_t size, WireState& state);
+};
@@ -0,0 +1,174 @@
+/**
+ * @file WorkStealingPool.cpp
+ * @brief Implementation of the WorkStealingPool class for Flappy Bird 2-player game
+ *
+ * This file contains chunk distribution, stealing and the worker loop.
+ */
+
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <thread>
+
+/**
+ * @brief Constructor - sizes the pool and starts its workers
+ * @param threads Number of workers (0 = one per hardware thread)
+ */
+WorkStealingPool::WorkStealingPool(unsigned threads) :
+thread_count(threads ? threads : std::max(1u, std::thread::hardware_concurrency())),
+loop_count(0),
+loop_grain(1),
+current(nullptr),
+generation(0),
+busy(0),
+stopping(false)
+{
+    for (unsigned i = 0; i < thread_count; i++)
+        queues.push_back(std::unique_ptr<Queue>(new Queue()));
+    for (unsigned i = 1; i < thread_count; i++)
+        workers.emplace_back(&WorkStealingPool::run, this, i);
+}
+
+/**
+ * @brief Destructor - stops the workers
+ */
+WorkStealingPool::~WorkStealingPool()
+{
+    {
+        std::lock_guard<std::mutex> guard(control);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : workers)
+        thread.join();
+}
+
+/**
+ * @brief Runs body over [0, count) in parallel and waits for completion
+ * @param count Number of indices
+ * @param grain Number of indices per chunk
+ * @param body Loop body, called once per chunk
+ *
+ * The calling thread acts as worker 0, so a single-worker pool
+ * runs everything inline with no thread hand-over.
+ */
+void WorkStealingPool::parallelFor(std::size_t count, std::size_t grain, const Body& body)
+{
+    loop_count = count;
+    loop_grain = std::max<std::size_t>(grain, 1);
+
+    // Deal chunks round-robin so every worker starts with a share
+    std::size_t chunks = (count + loop_grain - 1) / loop_grain;
+    for (unsigned worker = 0; worker < thread_count; worker++)
+    {
+        queues[worker]->front = 0;
+        queues[worker]->back = worker < chunks ? (chunks - worker + thread_count - 1) / thread_count : 0;
+    }
+
+    if (thread_count == 1)
+    {
+        work(0, body);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(control);
+        current = &body;
+        busy = thread_count - 1;
+        generation++;
+    }
+    wake.notify_all();
+    work(0, body);
+
+    std::unique_lock<std::mutex> lock(control);
+    done.wait(lock, [this] { return busy == 0; });
+    current = nullptr;
+}
+
+/**
+ * @brief Worker thread: sleeps until a loop starts, then takes part in it
+ * @param worker Worker index
+ *
+ * parallelFor() waits for every worker before returning, so no worker
+ * can miss a loop or see the next one's body early.
+ */
+void WorkStealingPool::run(unsigned worker)
+{
+    std::uint64_t seen = 0;
+    while (true)
+    {
+        const Body* body;
+        {
+            std::unique_lock<std::mutex> lock(control);
+            wake.wait(lock, [this, seen] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            body = current;
+        }
+
+        work(worker, *body);
+
+        std::lock_guard<std::mutex> guard(control);
+        if (--busy == 0)
+            done.notify_one();
+    }
+}
+
+/**
+ * @brief Worker thread main loop
+ * @param worker Worker index
+ * @param body Loop body
+ */
+void WorkStealingPool::work(unsigned worker, const Body& body)
+{
+    Chunk chunk;
+    while (takeChunk(worker, chunk))
+        body(chunk.begin, chunk.end, worker);
+}
+
+/**
+ * @brief Gets the slice of a chunk in a worker's deal order
+ * @param owner Worker the chunk was dealt to
+ * @param position Position of the chunk in that worker's share
+ * @return Slice of the index range
+ */
+WorkStealingPool::Chunk WorkStealingPool::getChunk(unsigned owner, std::size_t position) const
+{
+    std::size_t begin = (owner + position * thread_count) * loop_grain;
+    return Chunk{ begin, std::min(begin + loop_grain, loop_count) };
+}
+
+/**
+ * @brief Takes the next chunk for a worker, stealing if its own share is empty
+ * @param worker Worker index
+ * @param chunk Receives the chunk
+ * @return False once every share is empty
+ *
+ * No chunks are added while a loop runs, so a full pass over every
+ * share finding nothing means the loop is finished.
+ */
+bool WorkStealingPool::takeChunk(unsigned worker, Chunk& chunk)
+{
+    {
+        Queue& own = *queues[worker];
+        std::lock_guard<std::mutex> guard(own.lock);
+        if (own.front < own.back)
+        {
+            chunk = getChunk(worker, --own.back);
+            return true;
+        }
+    }
+
+    for (unsigned i = 1; i < thread_count; i++)
+    {
+        unsigned owner = (worker + i) % thread_count;
+        Queue& victim = *queues[owner];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if (victim.front < victim.back)
+        {
+            chunk = getChunk(owner, victim.front++);
+            return true;
+        }
+    }
+    return false;
+}
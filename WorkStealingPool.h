@@ -0,0 +1,134 @@
+/**
+ * @file WorkStealingPool.h
+ * @brief Header file for the WorkStealingPool class in Flappy Bird 2-player game
+ *
+ * This file defines a small work-stealing scheduler used to spread large
+ * batches of independent matches across all CPU cores, and the ticks of
+ * many live matches in the match server.
+ */
+
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs a parallel loop over an index range with per-worker task queues
+ *
+ * The range is cut into chunks that are dealt round-robin, so worker w
+ * starts with chunks w, w + n, w + 2n and so on for n workers. Each worker
+ * takes chunks from the back of its own share (cache-warm, uncontended) and,
+ * once empty, steals from the front of the others. Workers that draw slow
+ * chunks (long matches) are thereby relieved by idle ones. A share is just
+ * two counters, so a loop allocates nothing.
+ *
+ * Worker threads are started once and sleep between loops, so a pool can
+ * run a short loop many times a second without creating threads.
+ */
+class WorkStealingPool
+{
+public:
+    /// Loop body: processes indices [begin, end) on the given worker
+    typedef std::function<void(std::size_t begin, std::size_t end, unsigned worker)> Body;
+
+private:
+    /**
+     * @struct Chunk
+     * @brief A contiguous slice of the index range
+     */
+    struct Chunk
+    {
+        std::size_t begin;   ///< First index of the slice
+        std::size_t end;     ///< One past the last index of the slice
+    };
+
+    /**
+     * @struct Queue
+     * @brief One worker's share of the chunks, as positions in its deal order
+     */
+    struct Queue
+    {
+        std::mutex lock;             ///< Guards the share against thieves
+        std::size_t front = 0;       ///< First pending chunk, taken by thieves
+        std::size_t back = 0;        ///< One past the last pending chunk, taken by the owner
+    };
+
+    unsigned thread_count;                          ///< Number of workers
+    std::vector<std::unique_ptr<Queue>> queues;     ///< One share per worker
+    std::size_t loop_count;                         ///< Indices in the running loop
+    std::size_t loop_grain;                         ///< Indices per chunk of the running loop
+    std::vector<std::thread> workers;               ///< Workers 1 and up (the caller is worker 0)
+
+    // Loop hand-over between parallelFor() and the sleeping workers
+    std::mutex control;                             ///< Guards the fields below
+    std::condition_variable wake;                   ///< Signals a new loop or shutdown
+    std::condition_variable done;                   ///< Signals the last worker finishing a loop
+    const Body* current;                            ///< Body of the running loop
+    std::uint64_t generation;                       ///< Number of loops started
+    unsigned busy;                                  ///< Workers still running the current loop
+    bool stopping;                                  ///< Set to end the workers
+
+    /**
+     * @brief Gets the slice of a chunk in a worker's deal order
+     * @param owner Worker the chunk was dealt to
+     * @param position Position of the chunk in that worker's share
+     * @return Slice of the index range
+     */
+    Chunk getChunk(unsigned owner, std::size_t position) const;
+
+    /**
+     * @brief Takes the next chunk for a worker, stealing if its own share is empty
+     * @param worker Worker index
+     * @param chunk Receives the chunk
+     * @return False once every share is empty
+     */
+    bool takeChunk(unsigned worker, Chunk& chunk);
+
+    /**
+     * @brief Worker thread main loop
+     * @param worker Worker index
+     * @param body Loop body
+     */
+    void work(unsigned worker, const Body& body);
+
+    /**
+     * @brief Worker thread: sleeps until a loop starts, then takes part in it
+     * @param worker Worker index
+     */
+    void run(unsigned worker);
+
+public:
+    /**
+     * @brief Constructor - sizes the pool and starts its workers
+     * @param threads Number of workers (0 = one per hardware thread)
+     */
+    explicit WorkStealingPool(unsigned threads = 0);
+
+    /**
+     * @brief Destructor - stops the workers
+     */
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     * @brief Gets the number of workers
+     * @return Worker count
+     */
+    unsigned getThreadCount() const { return thread_count; }
+
+    /**
+     * @brief Runs body over [0, count) in parallel and waits for completion
+     * @param count Number of indices
+     * @param grain Number of indices per chunk
+     * @param body Loop body, called once per chunk
+     */
+    void parallelFor(std::size_t count, std::size_t grain, const Body& body);
+};